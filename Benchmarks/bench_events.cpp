@@ -0,0 +1,158 @@
+#if DEV_MODE
+#include <QElapsedTimer>
+#include <limits>
+#include "benchmain.h"
+#include "../weapon-system-support-software/events.cpp"
+
+/********************************************************************************
+** bench_events.cpp
+**
+** Benchmarks for the Events storage. Reports the fastest of BENCHMARK_REPEATS runs
+** adding and freeing nodes, and the memory the events store reserves per node, at
+** several list sizes. The reserved memory is counted by the store itself, so it does
+** not depend on what the process allocated and freed before.
+**
+** @author Team Controller
+********************************************************************************/
+
+// number of times each timed benchmark is run, the fastest run is reported
+static const int BENCHMARK_REPEATS = 5;
+
+class bench_events : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bench_addNodes_data();
+    void bench_addNodes();
+    void bench_freeNodes_data();
+    void bench_freeNodes();
+    void bench_reservedBytes_data();
+    void bench_reservedBytes();
+
+private:
+    static void addNodes(Events *events, int numNodes);
+    static void addRows();
+};
+
+/**
+ * Fills events with numNodes nodes, alternating between events and errors
+ */
+void bench_events::addNodes(Events *events, int numNodes)
+{
+    QByteArray timeStamp = "1:15:43:237";
+    QByteArray eventString = "Sample benchmark message";
+    EventFrame event;
+    ErrorFrame error;
+
+    //the milliseconds match the text, as they do for decoded messages
+    event.timeStamp = error.timeStamp = timeStamp;
+    event.timeMs = error.timeMs = 4543237;
+    event.eventString = error.eventString = eventString;
+    error.cleared = false;
+
+    for (int i = 0; i < numNodes; i++)
+    {
+        if (i % 2 == 0)
+        {
+            event.id = i;
+            events->loadEventData(event);
+        }
+        else
+        {
+            error.id = i;
+            events->loadErrorData(error);
+        }
+    }
+}
+
+/**
+ * Adds the node counts each benchmark is run at
+ */
+void bench_events::addRows()
+{
+    QTest::addColumn<int>("numNodes");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+    QTest::newRow("1M") << 1000000;
+}
+
+void bench_events::bench_addNodes_data()
+{
+    addRows();
+}
+
+/**
+ * Time taken to add a node, in nanoseconds per node
+ */
+void bench_events::bench_addNodes()
+{
+    QFETCH(int, numNodes);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+
+        timer.start();
+        addNodes(&events, numNodes);
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.totalNodes, numNodes);
+    }
+
+    QTest::setBenchmarkResult(static_cast<qreal>(fastest) / numNodes, QTest::WalltimeNanoseconds);
+}
+
+void bench_events::bench_freeNodes_data()
+{
+    addRows();
+}
+
+/**
+ * Time taken to free every node, in nanoseconds per node
+ */
+void bench_events::bench_freeNodes()
+{
+    QFETCH(int, numNodes);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+        addNodes(&events, numNodes);
+
+        timer.start();
+        events.freeNodes(true);
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.totalNodes, 0);
+    }
+
+    QTest::setBenchmarkResult(static_cast<qreal>(fastest) / numNodes, QTest::WalltimeNanoseconds);
+}
+
+void bench_events::bench_reservedBytes_data()
+{
+    addRows();
+}
+
+/**
+ * Memory reserved by the events store, in bytes per node
+ */
+void bench_events::bench_reservedBytes()
+{
+    QFETCH(int, numNodes);
+    Events events(false, 0);
+
+    addNodes(&events, numNodes);
+
+    QTest::setBenchmarkResult(static_cast<qreal>(events.reservedBytes()) / numNodes, QTest::BytesAllocated);
+}
+
+BENCHMARK_MAIN(bench_events)
+#include "bench_events.moc"
+#endif
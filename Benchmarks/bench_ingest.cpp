@@ -0,0 +1,276 @@
+#if DEV_MODE
+#include <QElapsedTimer>
+#include <limits>
+#include "benchmain.h"
+#include "../weapon-system-support-software/events.cpp"
+#include "../weapon-system-support-software/status.cpp"
+#include "../weapon-system-support-software/electrical.cpp"
+
+/********************************************************************************
+** bench_ingest.cpp
+**
+** Benchmarks for loading serial messages, from the message text to the data the
+** GUI displays. Each benchmark reports the fastest of BENCHMARK_REPEATS runs in
+** nanoseconds per message (or per dump entry) at several data sizes.
+**
+** @author Team Controller
+********************************************************************************/
+
+// number of times each benchmark is run, the fastest run is reported
+static const int BENCHMARK_REPEATS = 5;
+
+class bench_ingest : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void bench_statusLoadData_data();
+    void bench_statusLoadData();
+    void bench_loadEventData_data();
+    void bench_loadEventData();
+    void bench_loadErrorData_data();
+    void bench_loadErrorData();
+    void bench_loadEventDump_data();
+    void bench_loadEventDump();
+    void bench_loadElecDump_data();
+    void bench_loadElecDump();
+
+private:
+    static void addRows(const QList<int> &sizes);
+    static QString eventMessage(int id);
+    static void setResult(qint64 fastestNsecs, int numItems);
+};
+
+/**
+ * Adds the data sizes a benchmark is run at
+ */
+void bench_ingest::addRows(const QList<int> &sizes)
+{
+    QTest::addColumn<int>("numItems");
+
+    for (int size : sizes)
+    {
+        QTest::newRow(qPrintable(QString::number(size))) << size;
+    }
+}
+
+/**
+ * Returns the payload of an event message, an error message adds its cleared field
+ */
+QString bench_ingest::eventMessage(int id)
+{
+    return QString::number(id) + DELIMETER + "1:15:43:237" + DELIMETER + "Sample benchmark message";
+}
+
+/**
+ * Reports the fastest run in nanoseconds per item
+ */
+void bench_ingest::setResult(qint64 fastestNsecs, int numItems)
+{
+    QTest::setBenchmarkResult(static_cast<qreal>(fastestNsecs) / numItems, QTest::WalltimeNanoseconds);
+}
+
+void bench_ingest::bench_statusLoadData_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Status::loadData to decode and load a status message
+ */
+void bench_ingest::bench_statusLoadData()
+{
+    QFETCH(int, numItems);
+    QStringList messages;
+    Status status;
+
+    //vary the fields that change most between status messages
+    status.trigger1 = ENGAGED;
+    status.trigger2 = NA;
+    status.controllerState = RUNNING;
+    status.firingMode = BURST;
+    status.feedPosition = FIRING;
+    status.burstLength = 3;
+    status.firingRate = 600.5;
+
+    for (int i = 0; i < numItems; i++)
+    {
+        status.armed = (i % 2 == 0);
+        status.totalFiringEvents = i;
+        messages.append(status.generateMessage());
+    }
+
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        timer.start();
+        for (const QString &message : messages)
+        {
+            status.loadData(message);
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+    }
+
+    QCOMPARE(status.totalFiringEvents, numItems - 1);
+    setResult(fastest, numItems);
+}
+
+void bench_ingest::bench_loadEventData_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::loadEventData to decode and store an event message
+ */
+void bench_ingest::bench_loadEventData()
+{
+    QFETCH(int, numItems);
+    QStringList messages;
+
+    for (int i = 0; i < numItems; i++)
+    {
+        messages.append(eventMessage(i));
+    }
+
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+
+        timer.start();
+        for (const QString &message : messages)
+        {
+            events.loadEventData(message);
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.store.eventCount(), numItems);
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_ingest::bench_loadErrorData_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::loadErrorData to decode and store an error message
+ */
+void bench_ingest::bench_loadErrorData()
+{
+    QFETCH(int, numItems);
+    QStringList messages;
+
+    for (int i = 0; i < numItems; i++)
+    {
+        messages.append(eventMessage(i) + DELIMETER + QString::number(i % 2));
+    }
+
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+
+        timer.start();
+        for (const QString &message : messages)
+        {
+            events.loadErrorData(message);
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.store.errorCount(), numItems);
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_ingest::bench_loadEventDump_data()
+{
+    addRows({100, 1000, 10000});
+}
+
+
+/**
+ * Time taken by Events::loadEventDump to decode and store one entry of an event dump
+ */
+void bench_ingest::bench_loadEventDump()
+{
+    QFETCH(int, numItems);
+    QStringList entries;
+
+    for (int i = 0; i < numItems; i++)
+    {
+        entries.append(eventMessage(i));
+    }
+
+    //dump entries are separated by an empty field
+    QString dump = entries.join(DELIMETER + DELIMETER);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+
+        timer.start();
+        events.loadEventDump(dump);
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.store.eventCount(), numItems);
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_ingest::bench_loadElecDump_data()
+{
+    addRows({10, 100, 1000});
+}
+
+/**
+ * Time taken by electrical::loadElecDump to decode and store one component of an
+ * electrical dump
+ */
+void bench_ingest::bench_loadElecDump()
+{
+    QFETCH(int, numItems);
+    QStringList components;
+    electrical elec;
+
+    for (int i = 0; i < numItems; i++)
+    {
+        components.append(elec.names[i % elec.names.size()] + DELIMETER + QString::number(i % 30)
+                          + DELIMETER + QString::number(i % 100));
+    }
+
+    //dump components are separated by an empty field
+    QString dump = components.join(DELIMETER + DELIMETER);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        elec.freeLL();
+
+        timer.start();
+        elec.loadElecDump(dump);
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QVERIFY(elec.lastNode != nullptr);
+    }
+
+    setResult(fastest, numItems);
+}
+
+BENCHMARK_MAIN(bench_ingest)
+#include "bench_ingest.moc"
+#endif
@@ -0,0 +1,353 @@
+#if DEV_MODE
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+#include <limits>
+#include <numeric>
+#include "benchmain.h"
+#include "../weapon-system-support-software/events.cpp"
+
+/********************************************************************************
+** bench_logfile.cpp
+**
+** Benchmarks for writing, loading and clearing errors in log files. Each benchmark
+** reports the fastest of BENCHMARK_REPEATS runs in nanoseconds per log file line
+** at several data sizes. Log files are written to a temporary directory.
+**
+** @author Team Controller
+********************************************************************************/
+
+// number of times each benchmark is run, the fastest run is reported
+static const int BENCHMARK_REPEATS = 5;
+
+class bench_logfile : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void bench_nodeToString_data();
+    void bench_nodeToString();
+    void bench_appendToLogfile_data();
+    void bench_appendToLogfile();
+    void bench_appendToLogfilePath_data();
+    void bench_appendToLogfilePath();
+    void bench_outputToLogFile_data();
+    void bench_outputToLogFile();
+    void bench_loadDataFromLogFile_data();
+    void bench_loadDataFromLogFile();
+    void bench_clearError_data();
+    void bench_clearError();
+    void bench_clearErrors_data();
+    void bench_clearErrors();
+
+private:
+    static void addRows(const QList<int> &sizes);
+    static void addNodes(Events *events, int numNodes, bool errorsOnly);
+    static void setResult(qint64 fastestNsecs, int numItems);
+
+    QTemporaryDir logDir;
+};
+
+/**
+ * Fails the benchmarks if there is nowhere to write log files
+ */
+void bench_logfile::initTestCase()
+{
+    QVERIFY(logDir.isValid());
+}
+
+/**
+ * Adds the data sizes a benchmark is run at
+ */
+void bench_logfile::addRows(const QList<int> &sizes)
+{
+    QTest::addColumn<int>("numItems");
+
+    for (int size : sizes)
+    {
+        QTest::newRow(qPrintable(QString::number(size))) << size;
+    }
+}
+
+/**
+ * Fills events with numNodes nodes, alternating between events and active errors
+ */
+void bench_logfile::addNodes(Events *events, int numNodes, bool errorsOnly)
+{
+    EventFrame event;
+    ErrorFrame error;
+
+    //the milliseconds match the text, as they do for decoded messages
+    event.timeStamp = error.timeStamp = "1:15:43:237";
+    event.timeMs = error.timeMs = 4543237;
+    event.eventString = error.eventString = "Sample benchmark message";
+    error.cleared = false;
+
+    for (int i = 0; i < numNodes; i++)
+    {
+        if (errorsOnly || i % 2 == 1)
+        {
+            error.id = i;
+            events->loadErrorData(error);
+        }
+        else
+        {
+            event.id = i;
+            events->loadEventData(event);
+        }
+    }
+}
+
+/**
+ * Reports the fastest run in nanoseconds per item
+ */
+void bench_logfile::setResult(qint64 fastestNsecs, int numItems)
+{
+    QTest::setBenchmarkResult(static_cast<qreal>(fastestNsecs) / numItems, QTest::WalltimeNanoseconds);
+}
+
+void bench_logfile::bench_nodeToString_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::nodeToString to format a node for display
+ */
+void bench_logfile::bench_nodeToString()
+{
+    QFETCH(int, numItems);
+    Events events(false, 0);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+    qsizetype totalLength = 0;
+
+    addNodes(&events, numItems, false);
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        totalLength = 0;
+
+        timer.start();
+        for (EventRecord node : events.store.rows(ALL))
+        {
+            totalLength += events.nodeToString(node).length();
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+    }
+
+    QVERIFY(totalLength > 0);
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_appendToLogfile_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::appendToLogfile to write a node through the session's log
+ * writer, including the time to flush it to disk
+ */
+void bench_logfile::bench_appendToLogfile()
+{
+    QFETCH(int, numItems);
+    Events events(false, 0);
+    QString logFileName = logDir.filePath("appendToLogfile.txt");
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    addNodes(&events, numItems, false);
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        LogWriter logWriter;
+        logWriter.setFileName(logFileName);
+        QVERIFY(logWriter.open(true));
+
+        timer.start();
+        for (EventRecord node : events.store.rows(ALL))
+        {
+            events.appendToLogfile(logWriter, node);
+        }
+        QVERIFY(logWriter.flush());
+        fastest = qMin(fastest, timer.nsecsElapsed());
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_appendToLogfilePath_data()
+{
+    addRows({100, 1000});
+}
+
+/**
+ * Time taken by Events::appendToLogfile to write a node given only the log file's
+ * path, which opens and closes the log file for every node
+ */
+void bench_logfile::bench_appendToLogfilePath()
+{
+    QFETCH(int, numItems);
+    Events events(false, 0);
+    QString logFileName = logDir.filePath("appendToLogfilePath.txt");
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    addNodes(&events, numItems, false);
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        QFile::remove(logFileName);
+
+        timer.start();
+        for (EventRecord node : events.store.rows(ALL))
+        {
+            events.appendToLogfile(logFileName, node);
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_outputToLogFile_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::outputToLogFile to write a node when saving every node
+ */
+void bench_logfile::bench_outputToLogFile()
+{
+    QFETCH(int, numItems);
+    Events events(false, 0);
+    QString logFileName = logDir.filePath("outputToLogFile.txt");
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    addNodes(&events, numItems, false);
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        timer.start();
+        QVERIFY(events.outputToLogFile(logFileName, false));
+        fastest = qMin(fastest, timer.nsecsElapsed());
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_loadDataFromLogFile_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::loadDataFromLogFile to parse and store a log file line
+ */
+void bench_logfile::bench_loadDataFromLogFile()
+{
+    QFETCH(int, numItems);
+    Events events(false, 0);
+    Events *loaded = new Events(false, 0);
+    QString logFileName = logDir.filePath("loadDataFromLogFile.txt");
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    addNodes(&events, numItems, false);
+    QVERIFY(events.outputToLogFile(logFileName, false));
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        //the previously loaded events are freed with the load
+        timer.start();
+        QCOMPARE(events.loadDataFromLogFile(loaded, logFileName), SUCCESS);
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(loaded->totalNodes, numItems);
+    }
+
+    delete loaded;
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_clearError_data()
+{
+    addRows({100, 1000});
+}
+
+/**
+ * Time taken by Events::clearError to clear an error given only the log file's path,
+ * which searches the log file for the error
+ */
+void bench_logfile::bench_clearError()
+{
+    QFETCH(int, numItems);
+    QString logFileName = logDir.filePath("clearError.txt");
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+        addNodes(&events, numItems, true);
+        QVERIFY(events.outputToLogFile(logFileName, false));
+
+        timer.start();
+        for (int id = 0; id < numItems; id++)
+        {
+            events.clearError(id, logFileName);
+        }
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.totalClearedErrors, numItems);
+    }
+
+    setResult(fastest, numItems);
+}
+
+void bench_logfile::bench_clearErrors_data()
+{
+    addRows({1000, 10000, 100000});
+}
+
+/**
+ * Time taken by Events::clearErrors to clear an error through the log writer that
+ * wrote it, including the time to flush the cleared indicators to disk
+ */
+void bench_logfile::bench_clearErrors()
+{
+    QFETCH(int, numItems);
+    QString logFileName = logDir.filePath("clearErrors.txt");
+    QVector<int> ids(numItems);
+    qint64 fastest = std::numeric_limits<qint64>::max();
+    QElapsedTimer timer;
+
+    std::iota(ids.begin(), ids.end(), 0);
+
+    for (int repeat = 0; repeat < BENCHMARK_REPEATS; repeat++)
+    {
+        Events events(false, 0);
+        LogWriter logWriter;
+        logWriter.setFileName(logFileName);
+
+        addNodes(&events, numItems, true);
+        QVERIFY(events.outputToLogFile(logWriter, false));
+        QVERIFY(logWriter.flush());
+
+        timer.start();
+        events.clearErrors(ids, logWriter);
+        QVERIFY(logWriter.flush());
+        fastest = qMin(fastest, timer.nsecsElapsed());
+
+        QCOMPARE(events.totalClearedErrors, numItems);
+    }
+
+    setResult(fastest, numItems);
+}
+
+BENCHMARK_MAIN(bench_logfile)
+#include "bench_logfile.moc"
+#endif
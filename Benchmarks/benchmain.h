@@ -0,0 +1,279 @@
+#ifndef BENCHMAIN_H
+#define BENCHMAIN_H
+#include <QApplication>
+#include <QTest>
+#include <QFile>
+#include <QHash>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSysInfo>
+#include <QTemporaryDir>
+#include <QThread>
+#include <QXmlStreamReader>
+
+/********************************************************************************
+** benchmain.h
+**
+** BENCHMARK_MAIN is used in place of QTEST_MAIN by the benchmarks. Every QtTest
+** option still works (i.e. -iterations, a benchmark function name) and the
+** following are added:
+**
+**   -json <file>          writes every result to a JSON report
+**   -baseline <file>      compares every result to a stored report, the run fails
+**                         if a result is worse than its baseline by more than the
+**                         tolerance. A missing report is warned about, not failed
+**   -tolerance <percent>  allowed difference from the baseline (default
+**                         BENCHMARK_TOLERANCE)
+**
+** A report becomes the baseline of later runs by storing it in Benchmarks/baselines
+** (the benchmark_baselines target does this for every benchmark). Each report notes
+** the machine it was measured on, baselines only mean something on that machine.
+** Results are read back from QtTest's xml output, so benchmarks report through
+** QBENCHMARK or QTest::setBenchmarkResult as usual. Every metric reported is lower
+** is better.
+**
+** @author Team Controller
+********************************************************************************/
+
+// percent a result may be worse than its baseline before the run fails
+static const double BENCHMARK_TOLERANCE = 10.0;
+
+/**
+ * @brief Reads the benchmark results from a QtTest xml log
+ *
+ * @param xmlFile The xml log written by QTest
+ * @return One object per result: name, tag, metric, value (per iteration) and iterations
+ */
+inline QJsonArray readBenchmarkResults(const QString &xmlFile)
+{
+    QJsonArray results;
+    QFile file(xmlFile);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Error: readBenchmarkResults could not open " << xmlFile << Qt::endl;
+        return results;
+    }
+
+    QXmlStreamReader xml(&file);
+    QString function;
+
+    while (!xml.atEnd())
+    {
+        if (xml.readNext() != QXmlStreamReader::StartElement)
+        {
+            continue;
+        }
+
+        QXmlStreamAttributes attributes = xml.attributes();
+
+        if (xml.name() == QLatin1String("TestFunction"))
+        {
+            function = attributes.value("name").toString();
+        }
+        else if (xml.name() == QLatin1String("BenchmarkResult"))
+        {
+            QJsonObject result;
+            result["name"] = function;
+            result["tag"] = attributes.value("tag").toString();
+            result["metric"] = attributes.value("metric").toString();
+            result["value"] = attributes.value("value").toDouble();
+            result["iterations"] = attributes.value("iterations").toInt();
+            results.append(result);
+        }
+    }
+
+    if (xml.hasError())
+    {
+        qDebug() << "Error: readBenchmarkResults, " << xml.errorString() << Qt::endl;
+    }
+
+    return results;
+}
+
+/**
+ * @brief Describes the machine running the benchmarks
+ *
+ * @return Host name, operating system, cpu architecture and number of cores
+ */
+inline QJsonObject benchmarkMachine()
+{
+    QJsonObject machine;
+    machine["host"] = QSysInfo::machineHostName();
+    machine["os"] = QSysInfo::prettyProductName();
+    machine["cpu"] = QSysInfo::currentCpuArchitecture();
+    machine["cores"] = QThread::idealThreadCount();
+
+    return machine;
+}
+
+/**
+ * @brief Compares results to a stored report
+ *
+ * Results without a baseline (i.e. a new benchmark) are reported but never fail. A
+ * missing report is warned about loudly, with how to store one, but is not a
+ * regression (i.e. a fresh checkout). An unreadable report fails.
+ *
+ * @param results Results of this run
+ * @param baselineFile Report stored by an earlier run
+ * @param tolerance Percent a result may be worse than its baseline
+ * @return Number of results worse than their baseline by more than the tolerance, -1
+ *         if the baseline exists but is not a benchmark report
+ */
+inline int compareToBaseline(const QJsonArray &results, const QString &baselineFile, double tolerance)
+{
+    QFile file(baselineFile);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qWarning().noquote() << "WARNING: no baseline at" << baselineFile << ", results are not compared."
+                             << "Build the benchmark_baselines target on the reference machine to store one";
+        return 0;
+    }
+
+    QJsonObject report = QJsonDocument::fromJson(file.readAll()).object();
+
+    if (!report.contains("results"))
+    {
+        qCritical().noquote() << baselineFile << "is not a benchmark report";
+        return -1;
+    }
+
+    //baselines measured elsewhere are still compared, but say so
+    if (report.value("machine").toObject() != benchmarkMachine())
+    {
+        qWarning().noquote() << "Baseline was measured on"
+                             << QJsonDocument(report.value("machine").toObject()).toJson(QJsonDocument::Compact)
+                             << ", results may differ for reasons other than the code";
+    }
+
+    //index the baseline by benchmark, data row and metric
+    QHash<QString, double> baseline;
+    for (const QJsonValue &value : report.value("results").toArray())
+    {
+        QJsonObject result = value.toObject();
+        baseline.insert(result["name"].toString() + ":" + result["tag"].toString() + ":" + result["metric"].toString(),
+                        result["value"].toDouble());
+    }
+
+    int regressions = 0;
+
+    for (const QJsonValue &value : results)
+    {
+        QJsonObject result = value.toObject();
+        QString key = result["name"].toString() + ":" + result["tag"].toString() + ":" + result["metric"].toString();
+        double current = result["value"].toDouble();
+
+        if (!baseline.contains(key))
+        {
+            qInfo().noquote() << key << "has no baseline";
+            continue;
+        }
+
+        double expected = baseline.value(key);
+        double change = (expected > 0) ? (current - expected) / expected * 100.0 : 0;
+        bool regressed = change > tolerance;
+
+        qInfo().noquote() << (regressed ? "REGRESSION" : "ok        ") << key << "baseline" << expected
+                          << "now" << current << QString("(%1%2%)").arg(change >= 0 ? "+" : "").arg(change, 0, 'f', 1);
+
+        if (regressed)
+        {
+            regressions++;
+        }
+    }
+
+    return regressions;
+}
+
+/**
+ * @brief Runs the benchmarks of a QtTest class, see the file header for options
+ *
+ * @return QTest's result, or 1 if a result regressed against the baseline
+ */
+inline int runBenchmarks(QObject *benchmarks, int argc, char **argv)
+{
+    QStringList arguments;
+    QString jsonFile;
+    QString baselineFile;
+    double tolerance = BENCHMARK_TOLERANCE;
+    bool outputSet = false;
+
+    //take our options out, the rest are passed to QTest
+    for (int i = 0; i < argc; i++)
+    {
+        QString argument = QString::fromLocal8Bit(argv[i]);
+
+        if (argument == "-json" && i + 1 < argc)
+        {
+            jsonFile = QString::fromLocal8Bit(argv[++i]);
+        }
+        else if (argument == "-baseline" && i + 1 < argc)
+        {
+            baselineFile = QString::fromLocal8Bit(argv[++i]);
+        }
+        else if (argument == "-tolerance" && i + 1 < argc)
+        {
+            tolerance = QString::fromLocal8Bit(argv[++i]).toDouble();
+        }
+        else
+        {
+            outputSet = outputSet || argument == "-o";
+            arguments.append(argument);
+        }
+    }
+
+    if (jsonFile.isEmpty() && baselineFile.isEmpty())
+    {
+        return QTest::qExec(benchmarks, arguments);
+    }
+
+    //log to xml for the results, and to the console unless another output was given
+    QTemporaryDir logDir;
+    QString xmlFile = logDir.filePath("results.xml");
+
+    arguments << "-o" << xmlFile + ",xml";
+    if (!outputSet)
+    {
+        arguments << "-o" << "-,txt";
+    }
+
+    int result = QTest::qExec(benchmarks, arguments);
+    QJsonArray results = readBenchmarkResults(xmlFile);
+
+    if (!jsonFile.isEmpty())
+    {
+        QJsonObject report;
+        report["benchmark"] = QString::fromLatin1(benchmarks->metaObject()->className());
+        report["qtVersion"] = QString::fromLatin1(qVersion());
+        report["machine"] = benchmarkMachine();
+        report["results"] = results;
+
+        QFile file(jsonFile);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        {
+            qDebug() << "Error: runBenchmarks could not write " << jsonFile << Qt::endl;
+            return 1;
+        }
+        file.write(QJsonDocument(report).toJson());
+    }
+
+    if (!baselineFile.isEmpty() && compareToBaseline(results, baselineFile, tolerance) != 0)
+    {
+        return 1;
+    }
+
+    return result;
+}
+
+#define BENCHMARK_MAIN(BenchmarkObject) \
+int main(int argc, char *argv[]) \
+{ \
+    QApplication app(argc, argv); \
+    app.setAttribute(Qt::AA_Use96Dpi, true); \
+    BenchmarkObject benchmarks; \
+    return runBenchmarks(&benchmarks, argc, argv); \
+}
+
+#endif // BENCHMAIN_H
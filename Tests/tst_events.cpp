@@ -2,6 +2,8 @@
 #include <QCoreApplication>
 #include <QTest>
 #include "../weapon-system-support-software/events.cpp"
+#include "../weapon-system-support-software/eventsmodel.h"
+#include "../weapon-system-support-software/eventsearch.h"
 #include "../weapon-system-support-software/constants.h"
 
 class tst_events : public QObject
@@ -11,10 +13,14 @@ class tst_events : public QObject
 
 private slots:
     void events_constructor();
-    void test_freeLinkedLists();
+    void test_freeNodes();
     void test_clearError();
     void test_clearError_badInput();
-    void test_getNextNode();
+    void test_clearErrors();
+    void test_freeError();
+    void test_rows();
+    void test_eventsModel();
+    void test_eventSearch();
     void test_nodeToString();
     void test_stringToNode();
     void test_stringToNode_badInput();
@@ -42,13 +48,13 @@ void tst_events::events_constructor()
     QCOMPARE(eventObj->totalNodes, 0);
     QCOMPARE(eventObj->totalClearedErrors, 0);
 
-    // ensure event pointers are empty/null
-    QCOMPARE(eventObj->headEventNode, nullptr);
-    QCOMPARE(eventObj->lastEventNode, nullptr);
+    // ensure the events store is empty
+    QCOMPARE(eventObj->store.eventCount(), 0);
+    QVERIFY(eventObj->store.lastEvent().isNull());
 
-    // ensure error pointers are empty/null
-    QCOMPARE(eventObj->headErrorNode, nullptr);
-    QCOMPARE(eventObj->lastErrorNode, nullptr);
+    // ensure there are no stored errors
+    QCOMPARE(eventObj->store.errorCount(), 0);
+    QVERIFY(eventObj->store.lastError().isNull());
 
 
     // check default bool value
@@ -59,9 +65,9 @@ void tst_events::events_constructor()
 }
 
 /**
- * Test case for freeLinkedLists() in events.cpp
+ * Test case for freeNodes() in events.cpp
  */
-void tst_events::test_freeLinkedLists()
+void tst_events::test_freeNodes()
 {
     // create event object
     Events *eventObj = new Events(false, 0);
@@ -77,22 +83,23 @@ void tst_events::test_freeLinkedLists()
     QString eventMessage = QString::number(id) + "," + timeStamp + "," + eventString + ",\n";
     QString errorMessage = QString::number(id + 1) + "," + timeStamp + "," + eventString + "," + QString::number(cleared) + ",\n";
 
-    // create nodes to test freeing both linked lists
+    // create nodes to test freeing both events and errors
     eventObj->loadEventData(eventMessage);
     eventObj->loadErrorData(errorMessage);
 
-    // show that the head/last nodes are not null
-    QVERIFY(eventObj->headEventNode != nullptr);
-    QVERIFY(eventObj->lastEventNode != nullptr);
-    QVERIFY(eventObj->headErrorNode != nullptr);
-    QVERIFY(eventObj->lastErrorNode != nullptr);
+    // show that the nodes were stored
+    QCOMPARE(eventObj->store.eventCount(), 1);
+    QVERIFY(!eventObj->store.lastEvent().isNull());
+    QCOMPARE(eventObj->store.errorCount(), 1);
+    QVERIFY(!eventObj->store.lastError().isNull());
 
-    // free and test if head/last node is null
-    eventObj->freeLinkedLists(true);
-    QCOMPARE(eventObj->headEventNode, nullptr);
-    QCOMPARE(eventObj->lastEventNode, nullptr);
-    QCOMPARE(eventObj->headErrorNode, nullptr);
-    QCOMPARE(eventObj->lastErrorNode, nullptr);
+    // free and test if the store is empty
+    eventObj->freeNodes(true);
+    QCOMPARE(eventObj->store.eventCount(), 0);
+    QVERIFY(eventObj->store.lastEvent().isNull());
+    QCOMPARE(eventObj->store.errorCount(), 0);
+    QVERIFY(eventObj->store.lastError().isNull());
+    QVERIFY(eventObj->store.rows(ALL).begin() == eventObj->store.rows(ALL).end());
 
     // ensure that member variables are reset back to 0
     QCOMPARE(eventObj->totalEvents, 0);
@@ -121,19 +128,18 @@ void tst_events::test_clearError()
     QString eventString = "Sample test message 1";
     QString message = QString::number(id) + "," + timeStamp + "," + eventString + ",";
 
-    // create and add node to linked list
+    // create and add node to events store
     eventObj->loadErrorData(message);
     eventObj->outputToLogFile("../Tests" + TEST_LOG_FILE, false);
 
-    // test the head/last event node values
-    QVERIFY(eventObj->headErrorNode != nullptr);
-    QVERIFY(eventObj->lastErrorNode != nullptr);
+    // test the stored error
+    QCOMPARE(eventObj->store.errorCount(), 1);
 
-    // create a working node from the headErrorNode
-    ErrorNode *wkgErrorNode = eventObj->headErrorNode;
+    // create a working node from the first error
+    EventRecord wkgErrorNode = eventObj->store.error(0);
 
     // verify that this error is not cleared yet
-    QCOMPARE(wkgErrorNode->cleared, false);
+    QCOMPARE(wkgErrorNode.isCleared(), false);
     QCOMPARE(eventObj->totalClearedErrors, 0);
 
     // clear the error
@@ -141,7 +147,7 @@ void tst_events::test_clearError()
 
     // verify that this error is now cleared
     QCOMPARE(result, SUCCESS);
-    QCOMPARE(wkgErrorNode->cleared, true);
+    QCOMPARE(wkgErrorNode.isCleared(), true);
     QCOMPARE(eventObj->totalClearedErrors, 1);
 
     // free
@@ -166,22 +172,22 @@ void tst_events::test_clearError_badInput()
     QString eventString = "Sample test message 1";
     QString message = QString::number(id) + "," + timeStamp + "," + eventString + ",";
 
-    // create and add node to linked list
+    // create and add node to events store
     eventObj->loadErrorData(message);
 
-    // try to clear an error that exists in the LL but not the log file
+    // try to clear an error that exists in the store but not the log file
     result = eventObj->clearError(id, "../Tests" + TEST_LOG_FILE);
     QCOMPARE(result, FAILED_TO_CLEAR_FROM_LOGFILE);
 
-    // create and add node to linked list and log file
+    // create and add node to events store and log file
     message = QString::number(id + 1) + "," + timeStamp + "," + eventString + ",";
     eventObj->loadErrorData(message);
     eventObj->outputToLogFile("../Tests" + TEST_LOG_FILE, false);
 
-    // free the linked list...
-    eventObj->freeLinkedLists(true);
+    // free the events store...
+    eventObj->freeNodes(true);
 
-    // try to clear an error that exists in the log file but not in the LL
+    // try to clear an error that exists in the log file but not in the store
     result = eventObj->clearError(id, "../Tests" + TEST_LOG_FILE);
     QCOMPARE(result, FAILED_TO_CLEAR_FROM_LL);
 
@@ -190,48 +196,357 @@ void tst_events::test_clearError_badInput()
 }
 
 /**
- * Test case for getNextNode() in events.cpp
+ * Test case for clearErrors() in events.cpp
+ *
+ * Ensures a burst of clears is applied to the store and log file, and unknown ids fail
  */
-void tst_events::test_getNextNode()
+void tst_events::test_clearErrors()
 {
     // create event object
     Events *eventObj = new Events(false, 0);
 
-    // providing a seed value for random values
-    srand((unsigned) time(nullptr));
+    // create errors and add them to the log file
+    eventObj->loadErrorData("10,0:00:00:100,First error,0,");
+    eventObj->loadErrorData("11,0:00:00:200,Second error,0,");
+    eventObj->loadErrorData("12,0:00:00:300,Third error,0,");
+    eventObj->outputToLogFile("../Tests" + TEST_LOG_FILE, false);
 
-    // set up some variables
-    QString timeStamp = "01:15:43:237";
-    QString eventString = "Sample test message 1";
-    bool cleared = rand() % 1; // randomly determine if this is cleared or not
+    // errors are found by id
+    QCOMPARE(eventObj->store.findError(11).id(), 11);
+    QVERIFY(eventObj->store.findError(500).isNull());
+
+    // clear two errors and one that does not exist
+    QVector<int> results = eventObj->clearErrors({10, 12, 500}, "../Tests" + TEST_LOG_FILE);
+    QCOMPARE(results, QVector<int>({SUCCESS, SUCCESS, FAILED_TO_CLEAR}));
+
+    // verify the store was updated
+    QCOMPARE(eventObj->store.findError(10).isCleared(), true);
+    QCOMPARE(eventObj->store.findError(11).isCleared(), false);
+    QCOMPARE(eventObj->store.findError(12).isCleared(), true);
+    QCOMPARE(eventObj->totalClearedErrors, 2);
+
+    // verify the log file was updated in place
+    QFile logFile("../Tests" + TEST_LOG_FILE);
+    QVERIFY(logFile.open(QIODevice::ReadOnly | QIODevice::Text));
+    QString logContents = logFile.readAll();
+    logFile.close();
+    QCOMPARE(logContents.count(eventObj->clearedIndicator), 2);
+
+    // free
+    delete eventObj;
+}
 
-    // get random ID values, ensuring they are not ever equal
-    int eventId = 1 + (rand() % 100); // get a random ID value, 1-100
-    int errorId = eventId;
+/**
+ * Test case for freeError() in events.cpp
+ *
+ * Ensures removed errors are skipped until they are compacted and the error index
+ * moves on to the next error sharing an id
+ */
+void tst_events::test_freeError()
+{
+    // create event object
+    Events *eventObj = new Events(false, 0);
+
+    eventObj->loadErrorData("1,0:00:00:100,First error,0,");
+    eventObj->loadErrorData("2,0:00:00:200,Second error,0,");
+    eventObj->loadErrorData("2,0:00:00:300,Repeated error,0,");
+    eventObj->loadErrorData("3,0:00:00:400,Third error,0,");
+
+    // the first error with an id is removed, the index moves to the next one
+    eventObj->freeError(2);
+    QCOMPARE(eventObj->store.errorCount(), 3);
+    QCOMPARE(eventObj->store.findError(2).timeMs(), qint64(300));
+    QCOMPARE(eventObj->store.error(1).timeMs(), qint64(300));
 
-    // do this until we have two different random numbers
-    while (eventId == errorId)
+    QVector<int> ids;
+    for (EventRecord error : eventObj->store.rows(ERRORS))
     {
-        errorId = 1 + (rand() % 100);
+        ids.append(error.id());
     }
+    QCOMPARE(ids, QVector<int>({1, 2, 3}));
 
-    QString eventMessage = QString::number(eventId) + "," + timeStamp + "," + eventString + ",\n";
-    QString errorMessage = QString::number(errorId) + "," + timeStamp + "," + eventString + QString::number(cleared) + ",\n";
+    // removing half of the errors compacts them
+    eventObj->freeError(1);
+    QCOMPARE(eventObj->store.errorCount(), 2);
+    QCOMPARE(eventObj->store.error(0).timeMs(), qint64(300));
+    QVERIFY(eventObj->store.findError(1).isNull());
 
-    // create nodes
-    eventObj->loadEventData(eventMessage);
-    eventObj->loadErrorData(errorMessage);
+    // the last error skips removed errors
+    eventObj->freeError(3);
+    QCOMPARE(eventObj->store.lastError().timeMs(), qint64(300));
+    QCOMPARE(eventObj->totalErrors, 1);
+
+    // free
+    delete eventObj;
+}
+
+/**
+ * Test case for EventStore::rows() in eventstore.cpp
+ *
+ * Ensures events and errors are merged in time stamp order and filters are applied
+ */
+void tst_events::test_rows()
+{
+    // create event object
+    Events *eventObj = new Events(false, 0);
+
+    // errors and events arrive in separate dumps, out of time order
+    eventObj->loadEventDump("1,0:00:00:100,first event,,4,0:00:02:000,second event");
+    eventObj->loadErrorDump("2,0:00:00:500,first error,1,,3,0:00:01:000,second error,0");
+
+    // nodes with equal time stamps are ordered by id
+    eventObj->loadEventData("6,0:00:03:000,third event,");
+    eventObj->loadErrorData("5,0:00:03:000,third error,0,");
+
+    // check merged order
+    QList<int> ids;
+    for (EventRecord node : eventObj->store.rows(ALL))
+    {
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({1, 2, 3, 4, 5, 6}));
+
+    // check filters
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(EVENTS))
+    {
+        QVERIFY(!node.isError());
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({1, 4, 6}));
+
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(ERRORS))
+    {
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({2, 3, 5}));
+
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(NON_CLEARED_ERRORS))
+    {
+        QVERIFY(!node.isCleared());
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({3, 5}));
+
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(CLEARED_ERRORS))
+    {
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({2}));
+
+    // check time window, both ends are included
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(ALL, 500, 2000))
+    {
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({2, 3, 4}));
 
-    // create working nodes from the headErrorNode and headEventNode
-    ErrorNode *wkgErrorNode = eventObj->headErrorNode;
-    EventNode *wkgEventNode = eventObj->headEventNode;
+    ids.clear();
+    for (EventRecord node : eventObj->store.rows(NON_CLEARED_ERRORS, 0, 1500))
+    {
+        ids.append(node.id());
+    }
+    QCOMPARE(ids, QList<int>({3}));
+
+    // time stamps are given back as the controller sent them
+    QCOMPARE(eventObj->store.event(1).timeStamp(), "0:00:02:000");
+
+    eventObj->loadEventData("7,1:02:03:004,unpadded hours,");
+    QCOMPARE(eventObj->store.lastEvent().timeStamp(), "1:02:03:004");
+    QCOMPARE(eventObj->store.lastEvent().timeMs(), qint64(3723004));
+
+    // time stamps that the milliseconds can not rebuild are kept as text
+    eventObj->loadEventData("8,0:75:00:000,minutes past 59,");
+    QCOMPARE(eventObj->store.lastEvent().timeStamp(), "0:75:00:000");
+    QCOMPARE(eventObj->store.lastEvent().timeMs(), qint64(4500000));
+
+    // event strings are interned but read back unchanged
+    QCOMPARE(eventObj->store.event(2).eventString(), "third event");
+    QCOMPARE(eventObj->store.error(0).timeMs(), qint64(500));
+
+    // free
+    delete eventObj;
+}
+
+/**
+ * Test case for the events page list model in eventsmodel.cpp
+ *
+ * Ensures the rows of every filter follow nodes as they are added and errors are cleared
+ */
+void tst_events::test_eventsModel()
+{
+    // create event object
+    Events *eventObj = new Events(false, 0);
+    eventObj->loadEventData("1,0:00:00:100,first event,");
+    eventObj->loadErrorData("2,0:00:00:200,first error,0,");
+
+    // only active errors are shown
+    EventsModel model;
+    model.reset(eventObj, NON_CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.node(0).id(), 2);
+    QCOMPARE(model.data(model.index(0), EventsModel::KindRole).toInt(), int(EventsModel::ACTIVE_ERROR_ROW));
+
+    // appended nodes are only shown if the filter allows them
+    eventObj->loadEventData("3,0:00:00:300,second event,");
+    model.append(eventObj->store.lastEvent());
+    QCOMPARE(model.rowCount(), 1);
+
+    // appended rows are shown once they are published
+    eventObj->loadErrorData("4,0:00:00:400,second error,0,");
+    model.append(eventObj->store.lastError());
+    QCOMPARE(model.rowCount(), 1);
+    model.publishRows();
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.data(model.index(1)).toString(), eventObj->nodeToString(eventObj->store.lastError()));
+
+    // a cleared error leaves the active errors filter, clearing it twice changes nothing
+    EventRecord error = eventObj->store.findError(2);
+    eventObj->store.setCleared(error.row());
+    QVERIFY(model.errorCleared(error));
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.node(0).id(), 4);
+    QVERIFY(model.errorCleared(error));
+    QCOMPARE(model.rowCount(), 1);
+
+    // the cleared error joins the cleared errors filter in time stamp order
+    model.setFilter(CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), 1);
+    QCOMPARE(model.node(0).id(), 2);
+
+    // switching filters keeps the rows of every filter
+    model.setFilter(EVENTS);
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.node(1).id(), 3);
+
+    // every node is shown without a filter, cleared errors change kind
+    model.setFilter(ALL);
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.data(model.index(1), EventsModel::KindRole).toInt(), int(EventsModel::CLEARED_ERROR_ROW));
+    QCOMPARE(model.data(model.index(2), EventsModel::KindRole).toInt(), int(EventsModel::EVENT_ROW));
+
+    // store rows are found through their row handles
+    QCOMPARE(model.shownRow(eventObj->store.findError(4).row()), 3);
+
+    // errors cleared while another filter is shown are redrawn in place and moved
+    // once an error state filter is shown
+    error = eventObj->store.findError(4);
+    eventObj->store.setCleared(error.row());
+    QVERIFY(model.errorCleared(error));
+    QCOMPARE(model.rowCount(), 4);
+    QCOMPARE(model.data(model.index(3), EventsModel::KindRole).toInt(), int(EventsModel::CLEARED_ERROR_ROW));
+
+    model.setFilter(NON_CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), 0);
+    model.setFilter(CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(model.node(1).id(), 4);
 
-    // get next node to print by ID
-    EventNode *nextNode = eventObj->getNextNode(wkgEventNode, wkgErrorNode);
+    // free
+    delete eventObj;
+}
 
-    // verify that it captured the proper node
-    // we are checking that the next node ID is the smaller of the two IDs in both linked lists
-    QCOMPARE(nextNode->id, std::min(eventId, errorId));
+/**
+ * Test case for the search index in eventsearch.cpp
+ *
+ * Ensures hits are filtered and ranked, and the index is emptied with the store
+ */
+void tst_events::test_eventSearch()
+{
+    // create event object
+    Events *eventObj = new Events(false, 0);
+    EventSearch search;
+
+    eventObj->loadEventData("1,0:00:01:000,Feed motor started,");
+    search.add(eventObj->store.lastEvent());
+    eventObj->loadErrorData("2,0:00:02:000,feed motor stalled,0,");
+    search.add(eventObj->store.lastError());
+
+    eventObj->loadEventData("3,0:00:03:000,motor,");
+    search.add(eventObj->store.lastEvent());
+    eventObj->loadErrorData("4,0:00:04:000,overfeed,0,");
+    search.add(eventObj->store.lastError());
+    QCOMPARE(search.size(), 4);
+
+    // exact matches first, then word matches newest first, then substrings
+    SearchResults results = search.search(EventSearch::parseQuery("MOTOR"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(3));
+    QCOMPARE(results.hits[0].id, 3);
+    QCOMPARE(results.hits[1].id, 2);
+    QCOMPARE(results.hits[2].id, 1);
+
+    // hits know their row in the events store
+    QCOMPARE(results.hits[0].storeRow, 2);
+    QCOMPARE(results.hits[1].storeRow, 1);
+
+    results = search.search(EventSearch::parseQuery("feed"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(3));
+    QCOMPARE(results.hits.last().id, 4);
+
+    // the number of hits returned is limited but every hit is counted
+    results = search.search(EventSearch::parseQuery("feed"), 1);
+    QCOMPARE(results.hits.size(), 1);
+    QCOMPARE(results.totalHits, qsizetype(3));
+
+    // filters
+    results = search.search(EventSearch::parseQuery("feed kind:errors"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(2));
+
+    results = search.search(EventSearch::parseQuery("id:2"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(1));
+    QCOMPARE(results.hits[0].eventString, "feed motor stalled");
+
+    results = search.search(EventSearch::parseQuery("from:0:00:02:000 to:0:00:03:000"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(2));
+
+    // a time window over both kinds is merged newest first
+    results = search.search(EventSearch::parseQuery("from:0:00:02:000"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(3));
+    QCOMPARE(results.hits[0].id, 4);
+    QCOMPARE(results.hits[1].id, 3);
+    QCOMPARE(results.hits[2].id, 2);
+
+    results = search.search(EventSearch::parseQuery("to:0:00:02:999 kind:events"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(1));
+    QCOMPARE(results.hits[0].id, 1);
+
+    // the id filter still checks the other filters
+    results = search.search(EventSearch::parseQuery("id:2 from:0:00:03:000"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(0));
+    results = search.search(EventSearch::parseQuery("id:9"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(0));
+
+    // clears are tracked
+    search.errorCleared(2);
+    results = search.search(EventSearch::parseQuery("kind:active"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(1));
+    QCOMPARE(results.hits[0].id, 4);
+
+    // unknown filters are searched for as text
+    results = search.search(EventSearch::parseQuery("kind:none"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(0));
+
+    // an id that does not parse leaves the id filter alone
+    SearchQuery query = EventSearch::parseQuery("id:abc");
+    QCOMPARE(query.id, -1);
+    QCOMPARE(query.text, "id:abc");
+    query = EventSearch::parseQuery("id:2 id:abc");
+    QCOMPARE(query.id, 2);
+
+    // nodes cleared from RAM leave the index with the store
+    eventObj->freeNodes(false);
+    search.storeCleared();
+    QCOMPARE(search.size(), 0);
+
+    eventObj->loadEventData("5,0:00:05:000,motor,");
+    search.add(eventObj->store.lastEvent());
+    results = search.search(EventSearch::parseQuery("motor"), MAX_SEARCH_HITS);
+    QCOMPARE(results.totalHits, qsizetype(1));
+    QCOMPARE(results.hits[0].storeRow, 0);
 
     // free
     delete eventObj;
@@ -244,7 +559,6 @@ void tst_events::test_nodeToString()
 {
     // set up an example node
     Events *eventObj = new Events(false, 0);
-    EventNode *exampleNode = new EventNode();
 
     // provide a seed value for random values
     srand((unsigned) time(nullptr));
@@ -255,9 +569,8 @@ void tst_events::test_nodeToString()
     QString eventString = "Sample test message 1";
 
     // input values
-    exampleNode->id = id;
-    exampleNode->timeStamp = timeStamp;
-    exampleNode->eventString = eventString;
+    eventObj->loadEventData(QString::number(id) + "," + timeStamp + "," + eventString + ",");
+    EventRecord exampleNode = eventObj->store.lastEvent();
 
     // get string
     QString response = eventObj->nodeToString(exampleNode);
@@ -268,7 +581,6 @@ void tst_events::test_nodeToString()
     QCOMPARE(response, expectedResponse);
 
     // free
-    delete exampleNode;
     delete eventObj;
 }
 
@@ -286,31 +598,20 @@ void tst_events::test_stringToNode()
     // convert to node
     bool result = eventObj->stringToNode(exampleString);
 
-    // confirm the string was successfully added as a node to the linked list
+    // confirm the string was successfully added as a node to the events store
     QCOMPARE(result, true);
-    QVERIFY(eventObj->headEventNode != nullptr);
-    QVERIFY(eventObj->lastEventNode != nullptr);
+    QCOMPARE(eventObj->store.eventCount(), 1);
+    QVERIFY(!eventObj->store.lastEvent().isNull());
 
-    // get new node that has been created in linked list
-    EventNode *wkgEventNode = eventObj->headEventNode;
+    // get new node that has been created in the events store
+    EventRecord wkgEventNode = eventObj->store.event(0);
 
-    // test the values
-    if (wkgEventNode != nullptr)
-    {
-        // only access these values if stringToNode actually worked
-        // to avoid dereferencing a null pointer
-        QCOMPARE(wkgEventNode->id, 5);
-        QCOMPARE(wkgEventNode->timeStamp, "01:15:43:237");
-        QCOMPARE(wkgEventNode->eventString, "Sample test message 1");
-        QCOMPARE(wkgEventNode->isError(), false);
-        QCOMPARE(eventObj->totalEvents, 1);
-        QCOMPARE(eventObj->totalNodes, 1);
-    }
-    else
-    {
-        // force this test to fail, since we know it is null
-        QVERIFY(wkgEventNode != nullptr);
-    }
+    QCOMPARE(wkgEventNode.id(), 5);
+    QCOMPARE(wkgEventNode.timeStamp(), "01:15:43:237");
+    QCOMPARE(wkgEventNode.eventString(), "Sample test message 1");
+    QCOMPARE(wkgEventNode.isError(), false);
+    QCOMPARE(eventObj->totalEvents, 1);
+    QCOMPARE(eventObj->totalNodes, 1);
 
     // confirm the test fails with improper input
     result = eventObj->stringToNode("fail");
@@ -372,30 +673,19 @@ void tst_events::test_loadEventData()
     // attempt to add the node
     bool result = eventObj->loadEventData(exampleMsg);
 
-    // test the head/last event node values
+    // test the stored node values
     QCOMPARE(result, true);
-    QVERIFY(eventObj->headEventNode != nullptr);
-    QVERIFY(eventObj->lastEventNode != nullptr);
+    QCOMPARE(eventObj->store.eventCount(), 1);
+    QVERIFY(!eventObj->store.lastEvent().isNull());
 
-    // create a working node from the headEventNode
-    EventNode *wkgEventNode = eventObj->headEventNode;
+    // create a working node from the first event
+    EventRecord wkgEventNode = eventObj->store.event(0);
 
-    // test the values
-    if (wkgEventNode != nullptr)
-    {
-        // only access these values if loadEventData actually worked
-        // to avoid dereferencing a null pointer
-        QCOMPARE(wkgEventNode->id, 30);
-        QCOMPARE(wkgEventNode->timeStamp, "01:15:43:237");
-        QCOMPARE(wkgEventNode->eventString, "Sample Test message 1");
-        QCOMPARE(eventObj->totalEvents, 1);
-        QCOMPARE(eventObj->totalNodes, 1);
-    }
-    else
-    {
-        // force this test to fail, since we know it is null
-        QVERIFY(wkgEventNode != nullptr);
-    }
+    QCOMPARE(wkgEventNode.id(), 30);
+    QCOMPARE(wkgEventNode.timeStamp(), "01:15:43:237");
+    QCOMPARE(wkgEventNode.eventString(), "Sample Test message 1");
+    QCOMPARE(eventObj->totalEvents, 1);
+    QCOMPARE(eventObj->totalNodes, 1);
 
     // confirm the test fails with improper input
     result = eventObj->loadEventData("fail");
@@ -441,32 +731,21 @@ void tst_events::test_loadErrorData()
     // attempt to add the node
     bool result = eventObj->loadErrorData(exampleMsg);
 
-    // test the head/last event node values
+    // test the stored node values
     QCOMPARE(result, true);
-    QVERIFY(eventObj->headErrorNode != nullptr);
-    QVERIFY(eventObj->lastErrorNode != nullptr);
-
-    // create a working node from the headEventNode
-    ErrorNode *wkgErrorNode = eventObj->headErrorNode;
-
-    // test the values
-    if (wkgErrorNode != nullptr)
-    {
-        // only access these values if loadEventData actually worked
-        // to avoid dereferencing a null pointer
-        QCOMPARE(wkgErrorNode->id, 30);
-        QCOMPARE(wkgErrorNode->timeStamp, "01:15:43:237");
-        QCOMPARE(wkgErrorNode->eventString, "Sample Test message 1");
-        QCOMPARE(wkgErrorNode->cleared, 1);
-        QCOMPARE(eventObj->totalErrors, 1);
-        QCOMPARE(eventObj->totalNodes, 1);
-        QCOMPARE(eventObj->totalClearedErrors, 1);
-    }
-    else
-    {
-        // force this test to fail, since we know it is null
-        QVERIFY(wkgErrorNode != nullptr);
-    }
+    QCOMPARE(eventObj->store.errorCount(), 1);
+    QVERIFY(!eventObj->store.lastError().isNull());
+
+    // create a working node from the first error
+    EventRecord wkgErrorNode = eventObj->store.error(0);
+
+    QCOMPARE(wkgErrorNode.id(), 30);
+    QCOMPARE(wkgErrorNode.timeStamp(), "01:15:43:237");
+    QCOMPARE(wkgErrorNode.eventString(), "Sample Test message 1");
+    QCOMPARE(wkgErrorNode.isCleared(), true);
+    QCOMPARE(eventObj->totalErrors, 1);
+    QCOMPARE(eventObj->totalNodes, 1);
+    QCOMPARE(eventObj->totalClearedErrors, 1);
 
     // confirm the test fails with improper input
     result = eventObj->loadErrorData("fail");
@@ -513,36 +792,25 @@ void tst_events::test_loadEventDump()
     // attempt to add the two nodes
     bool result = eventObj->loadEventDump(exampleMsg);
 
-    // test the head/last event node values
+    // test the stored node values
     QCOMPARE(result, true);
-    QVERIFY(eventObj->headEventNode != nullptr);
-    QVERIFY(eventObj->lastEventNode != nullptr);
+    QCOMPARE(eventObj->store.eventCount(), 2);
+    QVERIFY(!eventObj->store.lastEvent().isNull());
 
-    // create a working node from the headEventNode
-    EventNode *wkgEventNode = eventObj->headEventNode;
+    // create a working node from the first event
+    EventRecord wkgEventNode = eventObj->store.event(0);
 
-    // test the values
-    if (wkgEventNode != nullptr && wkgEventNode->nextPtr != nullptr)
-    {
-        // only access these values if loadEventData actually worked
-        // to avoid dereferencing a null pointer
-        QCOMPARE(wkgEventNode->id, 30);
-        QCOMPARE(wkgEventNode->timeStamp, "01:15:43:237");
-        QCOMPARE(wkgEventNode->eventString, "Sample Test message 1");
-
-        wkgEventNode = wkgEventNode->nextPtr;
-        QCOMPARE(wkgEventNode->id, 31);
-        QCOMPARE(wkgEventNode->timeStamp, "01:15:43:437");
-        QCOMPARE(wkgEventNode->eventString, "Sample Test message 2");
-
-        QCOMPARE(eventObj->totalEvents, 2);
-        QCOMPARE(eventObj->totalNodes, 2);
-    }
-    else
-    {
-        // force this test to fail, since we know it is null
-        QVERIFY(wkgEventNode != nullptr);
-    }
+    QCOMPARE(wkgEventNode.id(), 30);
+    QCOMPARE(wkgEventNode.timeStamp(), "01:15:43:237");
+    QCOMPARE(wkgEventNode.eventString(), "Sample Test message 1");
+
+    wkgEventNode = eventObj->store.event(1);
+    QCOMPARE(wkgEventNode.id(), 31);
+    QCOMPARE(wkgEventNode.timeStamp(), "01:15:43:437");
+    QCOMPARE(wkgEventNode.eventString(), "Sample Test message 2");
+
+    QCOMPARE(eventObj->totalEvents, 2);
+    QCOMPARE(eventObj->totalNodes, 2);
 
     // confirm the test fails with improper input
     result = eventObj->loadEventDump("fail");
@@ -566,39 +834,28 @@ void tst_events::test_loadErrorDump()
     // attempt to add the two nodes
     bool result = eventObj->loadErrorDump(exampleMsg);
 
-    // test the head/last event node values
+    // test the stored node values
     QCOMPARE(result, true);
-    QVERIFY(eventObj->headErrorNode != nullptr);
-    QVERIFY(eventObj->lastErrorNode != nullptr);
+    QCOMPARE(eventObj->store.errorCount(), 2);
+    QVERIFY(!eventObj->store.lastError().isNull());
 
-    // create a working node from the headEventNode
-    ErrorNode *wkgErrorNode = eventObj->headErrorNode;
+    // create a working node from the first error
+    EventRecord wkgErrorNode = eventObj->store.error(0);
 
-    // test the values
-    if (wkgErrorNode != nullptr && wkgErrorNode->nextPtr != nullptr)
-    {
-        // only access these values if loadEventData actually worked
-        // to avoid dereferencing a null pointer
-        QCOMPARE(wkgErrorNode->id, 30);
-        QCOMPARE(wkgErrorNode->timeStamp, "01:15:43:237");
-        QCOMPARE(wkgErrorNode->eventString, "Sample Test message 1");
-        QCOMPARE(wkgErrorNode->cleared, 1);
-
-        wkgErrorNode = wkgErrorNode->nextPtr;
-        QCOMPARE(wkgErrorNode->id, 31);
-        QCOMPARE(wkgErrorNode->timeStamp, "01:15:43:632");
-        QCOMPARE(wkgErrorNode->eventString, "Sample Test message 2");
-        QCOMPARE(wkgErrorNode->cleared, 0);
-
-        QCOMPARE(eventObj->totalErrors, 2);
-        QCOMPARE(eventObj->totalNodes, 2);
-        QCOMPARE(eventObj->totalClearedErrors, 1);
-    }
-    else
-    {
-        // force this test to fail, since we know it is null
-        QVERIFY(wkgErrorNode != nullptr);
-    }
+    QCOMPARE(wkgErrorNode.id(), 30);
+    QCOMPARE(wkgErrorNode.timeStamp(), "01:15:43:237");
+    QCOMPARE(wkgErrorNode.eventString(), "Sample Test message 1");
+    QCOMPARE(wkgErrorNode.isCleared(), true);
+
+    wkgErrorNode = eventObj->store.error(1);
+    QCOMPARE(wkgErrorNode.id(), 31);
+    QCOMPARE(wkgErrorNode.timeStamp(), "01:15:43:632");
+    QCOMPARE(wkgErrorNode.eventString(), "Sample Test message 2");
+    QCOMPARE(wkgErrorNode.isCleared(), false);
+
+    QCOMPARE(eventObj->totalErrors, 2);
+    QCOMPARE(eventObj->totalNodes, 2);
+    QCOMPARE(eventObj->totalClearedErrors, 1);
 
     // confirm the test fails with improper input
     result = eventObj->loadErrorDump("fail");
@@ -2,8 +2,12 @@
 #include <QCoreApplication>
 #include <QTest>
 #include <QSettings>
+#include <QSignalSpy>
 #include "../weapon-system-support-software/events.cpp"
 #include "../weapon-system-support-software/constants.h"
+#include "../weapon-system-support-software/logfileloader.h"
+#include "../weapon-system-support-software/logviewmodel.h"
+#include "../weapon-system-support-software/eventsmodel.h"
 
 class tst_file_system : public QObject
 {
@@ -14,9 +18,15 @@ private slots:
     void test_outputToLogFile_badInput_logFileName();
 
     void test_appendToLogFile();
+    void test_logWriter();
 
     void test_loadDataFromLogFile();
     void test_loadDataFromLogFile_badInput_logFileName();
+
+    void test_logFileLoader();
+    void test_logFileLoader_corruptLine();
+
+    void test_logViewModel();
 };
 
 /**
@@ -112,7 +122,7 @@ void tst_file_system::test_appendToLogFile()
     // load second data msg
     eventObj->loadEventData(dataMsg2);
 
-    EventNode *wkgNode = eventObj->lastEventNode;
+    EventRecord wkgNode = eventObj->store.lastEvent();
 
     // call append
     eventObj->appendToLogfile(logfile + logfileName, wkgNode);
@@ -155,6 +165,72 @@ void tst_file_system::test_appendToLogFile()
     delete eventObj;
 }
 
+/**
+ * Test case for LogWriter in logwriter.cpp
+ *
+ * Ensures offsets tracked by the writer match the file and errors can be cleared
+ * whether or not the writer thread has written their line yet
+ */
+void tst_file_system::test_logWriter()
+{
+    QSettings userSettings("Team Controller", "WSSS");
+    Events *eventObj = new Events(false, 50);
+    QString logfile = userSettings.value("logfileLocation").toString();
+    QString logfileName = "/tst_logWriter.txt";
+    QFile file(logfile + logfileName);
+    LogWriter logWriter;
+    logWriter.setFileName(logfile + logfileName);
+
+    // write a dump, then append an error that is still queued by the writer
+    eventObj->loadErrorData("20,0:00:01:000,First error,0,");
+    QVERIFY(eventObj->outputToLogFile(logWriter, false));
+    QVERIFY(logWriter.flush());
+    QCOMPARE(QFileInfo(file).size(), logWriter.size());
+
+    eventObj->loadErrorData("21,0:00:02:000,Second error,0,");
+    eventObj->appendToLogfile(logWriter, eventObj->store.lastError());
+
+    // clear one error on disk and one that may not be written yet
+    QVector<int> results = eventObj->clearErrors({20, 21}, logWriter);
+    QCOMPARE(results, QVector<int>({SUCCESS, SUCCESS}));
+
+    // errors removed from RAM are still cleared in place through the writer's index
+    eventObj->loadErrorData("22,0:00:03:000,Third error,0,");
+    eventObj->appendToLogfile(logWriter, eventObj->store.lastError());
+    eventObj->freeNodes(false);
+
+    results = eventObj->clearErrors({22}, logWriter);
+    QCOMPARE(results, QVector<int>({FAILED_TO_CLEAR_FROM_LL}));
+    QCOMPARE(logWriter.indicatorOffset(22), qint64(-1));
+
+    // tracked size matches the file once it is written
+    QVERIFY(logWriter.flush());
+    QCOMPARE(QFileInfo(file).size(), logWriter.size());
+    logWriter.close();
+
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QString contents = QTextStream(&file).readAll();
+    file.close();
+
+    QCOMPARE(contents.count(CLEARED_INDICATOR), 3);
+    QCOMPARE(contents.count(ACTIVE_INDICATOR), 0);
+
+    // a synchronous writer never starts a thread, its records reach the file once flushed
+    LogWriter syncWriter(nullptr, LOG_WRITER_SYNCHRONOUS);
+    syncWriter.setFileName(logfile + logfileName);
+    QVERIFY(syncWriter.open(true));
+    QCOMPARE(syncWriter.writeLine("Synchronous line"), qint64(0));
+    QVERIFY(syncWriter.flush());
+    QVERIFY(!syncWriter.isRunning());
+    QCOMPARE(QFileInfo(file).size(), syncWriter.size());
+    syncWriter.close();
+
+    // remove file
+    QVERIFY(file.remove());
+
+    // delete event obj
+    delete eventObj;
+}
 
 /**
  * Test case for events function loadDataFromLogFile
@@ -181,12 +257,13 @@ void tst_file_system::test_loadDataFromLogFile()
     QCOMPARE(eventObj->loadDataFromLogFile(wkgNode, logfile + logfileName), SUCCESS);
 
     // create a secondary wkgnode for comparrison
-    EventNode *wkgEventNode = wkgNode->headEventNode;
+    QCOMPARE(wkgNode->store.eventCount(), 1);
+    EventRecord wkgEventNode = wkgNode->store.event(0);
 
     // check for valid values
-    QCOMPARE(wkgEventNode->id, 15);
-    QCOMPARE(wkgEventNode->timeStamp, "0:00:00:150");
-    QCOMPARE(wkgEventNode->eventString, "Test message on log file");
+    QCOMPARE(wkgEventNode.id(), 15);
+    QCOMPARE(wkgEventNode.timeStamp(), "0:00:00:150");
+    QCOMPARE(wkgEventNode.eventString(), "Test message on log file");
 
     // delete the file
     QVERIFY(file.remove());
@@ -218,6 +295,178 @@ void tst_file_system::test_loadDataFromLogFile_badInput_logFileName()
     delete wkgNode;
 }
 
+/**
+ * Test case for LogFileLoader, the log file is split into several chunks
+ */
+void tst_file_system::test_logFileLoader()
+{
+    QSettings userSettings("Team Controller", "WSSS");
+    Events *eventObj = new Events(false, 0);
+    QString logfile = userSettings.value("logfileLocation").toString() + "/tst_logFileLoader.txt";
+    QFile file(logfile);
+    int numNodes = 20000;
+
+    // create a log file larger than a chunk
+    for (int i = 0; i < numNodes; i++)
+    {
+        if (i % 10 == 0)
+        {
+            eventObj->loadErrorData(QString::number(i) + ",0:00:00:" + QString::number(i) + ",Error message " + QString::number(i));
+        }
+        else
+        {
+            eventObj->loadEventData(QString::number(i) + ",0:00:00:" + QString::number(i) + ",Event message " + QString::number(i));
+        }
+    }
+    QVERIFY(eventObj->outputToLogFile(logfile, true));
+    QVERIFY(QFileInfo(logfile).size() > LOG_LOADER_CHUNK_SIZE);
+
+    // chunks cover the whole file and end on a line end
+    QVERIFY(file.open(QIODevice::ReadOnly));
+    QByteArray contents = file.readAll();
+    file.close();
+    QVector<QByteArrayView> chunks = LogFileLoader::splitChunks(contents, LOG_LOADER_CHUNK_SIZE);
+    QVERIFY(chunks.size() > 1);
+    qsizetype chunkBytes = 0;
+    for (QByteArrayView chunk : chunks)
+    {
+        QVERIFY(chunk.endsWith('\n'));
+        chunkBytes += chunk.size();
+    }
+    QCOMPARE(chunkBytes, contents.size());
+
+    // load the log file
+    LogFileLoader loader;
+    QSignalSpy finishedSpy(&loader, &LogFileLoader::finished);
+    QCOMPARE(loader.start(logfile), SUCCESS);
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().first().toInt(), SUCCESS);
+
+    // loaded nodes match the saved nodes, in order
+    Events *loaded = loader.takeEvents();
+    QVERIFY(loaded != nullptr);
+    QCOMPARE(loaded->store.eventCount(), eventObj->store.eventCount());
+    QCOMPARE(loaded->store.errorCount(), eventObj->store.errorCount());
+    for (int i = 0; i < eventObj->store.eventCount(); i++)
+    {
+        QCOMPARE(loaded->store.event(i).id(), eventObj->store.event(i).id());
+        QCOMPARE(loaded->store.event(i).eventString(), eventObj->store.event(i).eventString());
+    }
+    QCOMPARE(loaded->store.error(0).timeStamp(), eventObj->store.error(0).timeStamp());
+    QVERIFY(!loaded->store.error(0).isCleared());
+
+    QVERIFY(QFile::remove(logfile));
+    delete loaded;
+    delete eventObj;
+}
+
+/**
+ * Bad input test case for LogFileLoader
+ */
+void tst_file_system::test_logFileLoader_corruptLine()
+{
+    QSettings userSettings("Team Controller", "WSSS");
+    QString logfile = userSettings.value("logfileLocation").toString() + "/tst_logFileLoader_corrupt.txt";
+    QFile file(logfile);
+
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("ID: 1, 00:00:00:100, Event message\n");
+    file.write("ID: 2, 00:00:00:200, Error message, UNKNOWN\n");
+    file.close();
+
+    LogFileLoader loader;
+    QSignalSpy finishedSpy(&loader, &LogFileLoader::finished);
+
+    // missing files are reported immediately
+    QCOMPARE(loader.start("/logfile.txt"), DATA_NOT_FOUND);
+
+    QCOMPARE(loader.start(logfile), SUCCESS);
+    QVERIFY(finishedSpy.wait(10000));
+    QCOMPARE(finishedSpy.first().first().toInt(), INCORRECT_FORMAT);
+    QCOMPARE(loader.corruptLine(), QByteArray("ID: 2, 00:00:00:200, Error message, UNKNOWN"));
+    QVERIFY(loader.takeEvents() == nullptr);
+
+    QVERIFY(file.remove());
+}
+
+/**
+ * Test case for LogViewModel, rows are read from the log file through its index
+ */
+void tst_file_system::test_logViewModel()
+{
+    QSettings userSettings("Team Controller", "WSSS");
+    Events *eventObj = new Events(false, 0);
+    QString logfile = userSettings.value("logfileLocation").toString() + "/tst_logViewModel.txt";
+    int numNodes = 1000;
+
+    // every 7th node is an error, every 14th error is cleared
+    for (int i = 0; i < numNodes; i++)
+    {
+        if (i % 7 == 0)
+        {
+            eventObj->loadErrorData(QString::number(i) + ",0:00:00:" + QString::number(i) + ",Error " + QString::number(i));
+        }
+        else
+        {
+            eventObj->loadEventData(QString::number(i) + ",0:00:00:" + QString::number(i) + ",Event " + QString::number(i));
+        }
+    }
+    QVector<int> clearIds;
+    for (int i = 0; i < numNodes; i += 14)
+    {
+        clearIds.append(i);
+        eventObj->store.setCleared(eventObj->store.findError(i).row());
+    }
+    QVERIFY(eventObj->outputToLogFile(logfile, true));
+    QFile::remove(logfile + LOG_VIEW_INDEX_SUFFIX);
+
+    LogViewModel model;
+    QSignalSpy indexedSpy(&model, &LogViewModel::indexed);
+    QCOMPARE(model.open(logfile), SUCCESS);
+    QVERIFY(indexedSpy.wait(10000));
+    QCOMPARE(indexedSpy.first().first().toInt(), SUCCESS);
+    QVERIFY(model.isOpen());
+
+    // advanced log file lines are not rows, rows match the saved nodes in time order
+    QCOMPARE(model.rowCount(), numNodes);
+    int row = 0;
+    for (EventRecord node : eventObj->store.rows(ALL))
+    {
+        QCOMPARE(model.data(model.index(row++)).toString(), eventObj->nodeToString(node));
+    }
+
+    // filters
+    model.setFilter(EVENTS);
+    QCOMPARE(model.rowCount(), eventObj->store.eventCount());
+    QCOMPARE(model.data(model.index(0)).toString(), eventObj->nodeToString(eventObj->store.event(0)));
+    QCOMPARE(model.data(model.index(model.rowCount() - 1)).toString(),
+             eventObj->nodeToString(eventObj->store.event(eventObj->store.eventCount() - 1)));
+
+    model.setFilter(ERRORS);
+    QCOMPARE(model.rowCount(), eventObj->store.errorCount());
+    QCOMPARE(model.data(model.index(1), EventsModel::KindRole).toInt(), int(EventsModel::ACTIVE_ERROR_ROW));
+
+    model.setFilter(CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), clearIds.size());
+    QCOMPARE(model.data(model.index(0), EventsModel::KindRole).toInt(), int(EventsModel::CLEARED_ERROR_ROW));
+
+    model.setFilter(NON_CLEARED_ERRORS);
+    QCOMPARE(model.rowCount(), eventObj->store.errorCount() - clearIds.size());
+
+    // the saved index is used the next time the file is viewed
+    model.close();
+    QVERIFY(QFile::exists(logfile + LOG_VIEW_INDEX_SUFFIX));
+    QFileInfo info(logfile);
+    LogFileIndex index;
+    QVERIFY(index.load(logfile + LOG_VIEW_INDEX_SUFFIX, info.size(), info.lastModified().toMSecsSinceEpoch()));
+    QCOMPARE(index.lineCount, numNodes);
+    QVERIFY(!index.load(logfile + LOG_VIEW_INDEX_SUFFIX, info.size() + 1, info.lastModified().toMSecsSinceEpoch()));
+
+    QVERIFY(QFile::remove(logfile + LOG_VIEW_INDEX_SUFFIX));
+    QVERIFY(QFile::remove(logfile));
+    delete eventObj;
+}
+
 QTEST_MAIN(tst_file_system)
 #include "tst_file_system.moc"
 #endif
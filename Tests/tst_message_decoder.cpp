@@ -0,0 +1,250 @@
+#if DEV_MODE
+#include <QCoreApplication>
+#include <QTest>
+#include "../weapon-system-support-software/messagedecoder.cpp"
+
+class tst_message_decoder : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_fieldTokenizer();
+    void test_splitMessageId();
+    void test_decodeStatus();
+    void test_decodeEvent();
+    void test_decodeError();
+    void test_decodeEventDump();
+    void test_decodeClear();
+    void test_decodeBegin();
+    void test_decodeElectricalDump();
+    void test_formatTimeStamp();
+};
+
+/**
+ * Test case for FieldTokenizer in messagedecoder.cpp
+ *
+ * Ensures fields match those produced by QString::split
+ */
+void tst_message_decoder::test_fieldTokenizer()
+{
+    QByteArray text = "30,,0:00:00:150,msg,\n";
+    QStringList expected = QString::fromUtf8(text).split(DELIMETER);
+    FieldTokenizer tokenizer(text, ",");
+    QByteArrayView field;
+    int numFields = 0;
+
+    while (tokenizer.next(field))
+    {
+        QVERIFY(numFields < expected.length());
+        QCOMPARE(QString::fromUtf8(field), expected[numFields]);
+        numFields++;
+    }
+    QCOMPARE(numFields, expected.length());
+
+    // empty text still has one (empty) field
+    FieldTokenizer emptyTokenizer(QByteArrayView(""), ",");
+    QVERIFY(emptyTokenizer.next(field));
+    QVERIFY(field.isEmpty());
+    QVERIFY(!emptyTokenizer.next(field));
+}
+
+/**
+ * Test case for splitMessageId() in messagedecoder.cpp
+ */
+void tst_message_decoder::test_splitMessageId()
+{
+    SerialMessageIdentifier messageId;
+    QByteArrayView payload;
+
+    QVERIFY(MessageDecoder::splitMessageId("3,30,0:00:00:150,msg,\n", messageId, payload));
+    QCOMPARE(messageId, EVENT);
+    QCOMPARE(payload.toByteArray(), QByteArray("30,0:00:00:150,msg,\n"));
+
+    QVERIFY(MessageDecoder::splitMessageId("9,", messageId, payload));
+    QCOMPARE(messageId, CLOSING_CONNECTION);
+    QVERIFY(payload.isEmpty());
+
+    // missing delimeter, non digit id and messages that are too short
+    QVERIFY(!MessageDecoder::splitMessageId("33,msg\n", messageId, payload));
+    QVERIFY(!MessageDecoder::splitMessageId("a,msg\n", messageId, payload));
+    QVERIFY(!MessageDecoder::splitMessageId("3", messageId, payload));
+    QVERIFY(!MessageDecoder::splitMessageId("", messageId, payload));
+}
+
+/**
+ * Test case for decodeStatus() in messagedecoder.cpp
+ */
+void tst_message_decoder::test_decodeStatus()
+{
+    StatusFrame frame;
+
+    QVERIFY(MessageDecoder::decodeStatus("1,1,0,1,330,90,6,23,1636.14,\n", frame));
+    QCOMPARE(frame.armed, true);
+    QCOMPARE(frame.trigger1, ENGAGED);
+    QCOMPARE(frame.trigger2, DISENGAGED);
+    QCOMPARE(frame.controllerState, BLOCKED);
+    QCOMPARE(frame.firingMode, SINGLE);
+    QCOMPARE(frame.feedPosition, FIRING);
+    QCOMPARE(frame.totalFiringEvents, 6);
+    QCOMPARE(frame.burstLength, 23);
+    QCOMPARE(frame.firingRate, 1636.14);
+
+    // a burst length of 0 is valid regardless of total firing events
+    QVERIFY(MessageDecoder::decodeStatus("0,1,0,1,330,90,6,0,1636.14,\n", frame));
+    QCOMPARE(frame.burstLength, 0);
+
+    // wrong number of values and invalid burst length
+    QVERIFY(!MessageDecoder::decodeStatus("0,1,0,1,330,90,6,23,\n", frame));
+    QVERIFY(!MessageDecoder::decodeStatus("0,1,0,1,330,90,6,23,1636.14,,\n", frame));
+    QVERIFY(!MessageDecoder::decodeStatus("0,1,0,1,330,90,6,b,1636.14,\n", frame));
+}
+
+/**
+ * Test case for decodeEvent() in messagedecoder.cpp
+ *
+ * Ensures text fields are views into the original message
+ */
+void tst_message_decoder::test_decodeEvent()
+{
+    QByteArray message = "30,0:00:00:150,Sample event message 1,\n";
+    EventFrame frame;
+
+    QVERIFY(MessageDecoder::decodeEvent(message, frame));
+    QCOMPARE(frame.id, 30);
+    QCOMPARE(frame.timeStamp.toByteArray(), QByteArray("0:00:00:150"));
+    QCOMPARE(frame.timeMs, qint64(150));
+    QCOMPARE(frame.eventString.toByteArray(), QByteArray("Sample event message 1"));
+    QVERIFY(frame.eventString.data() >= message.constData()
+            && frame.eventString.data() < message.constData() + message.size());
+
+    // no trailing delimeter is also allowed
+    QVERIFY(MessageDecoder::decodeEvent("30,0:00:00:150,msg", frame));
+
+    QVERIFY(!MessageDecoder::decodeEvent("-1,0:00:00:150,msg,\n", frame));
+    QVERIFY(!MessageDecoder::decodeEvent("30,0:00:150,msg,\n", frame));
+    QVERIFY(!MessageDecoder::decodeEvent("30,0:00:00:150,,\n", frame));
+    QVERIFY(!MessageDecoder::decodeEvent("30,0:00:00:150,msg,extra,\n", frame));
+}
+
+/**
+ * Test case for decodeError() in messagedecoder.cpp
+ */
+void tst_message_decoder::test_decodeError()
+{
+    ErrorFrame frame;
+
+    QVERIFY(MessageDecoder::decodeError("31,0:00:00:150,Sample error message 1,1,\n", frame));
+    QCOMPARE(frame.id, 31);
+    QCOMPARE(frame.eventString.toByteArray(), QByteArray("Sample error message 1"));
+    QVERIFY(frame.cleared);
+
+    QVERIFY(MessageDecoder::decodeError("31,0:00:00:150,msg,0,\n", frame));
+    QVERIFY(!frame.cleared);
+
+    QVERIFY(!MessageDecoder::decodeError("31,0:00:00:150,msg\n", frame));
+}
+
+/**
+ * Test case for decodeEventDump() in messagedecoder.cpp
+ *
+ * Ensures valid events are kept when part of the dump is invalid
+ */
+void tst_message_decoder::test_decodeEventDump()
+{
+    QVector<EventFrame> frames;
+
+    QVERIFY(MessageDecoder::decodeEventDump("1,0:00:00:100,first,,2,0:00:00:200,second,,\n", frames));
+    QCOMPARE(frames.length(), 2);
+    QCOMPARE(frames[1].id, 2);
+    QCOMPARE(frames[1].eventString.toByteArray(), QByteArray("second"));
+
+    frames.clear();
+    QVERIFY(!MessageDecoder::decodeEventDump("1,0:00:00:100,first,,bad,,\n", frames));
+    QCOMPARE(frames.length(), 1);
+
+    // empty dump
+    frames.clear();
+    QVERIFY(!MessageDecoder::decodeEventDump("\n", frames));
+    QVERIFY(!MessageDecoder::decodeEventDump("", frames));
+    QVERIFY(frames.isEmpty());
+}
+
+/**
+ * Test case for decodeClear() in messagedecoder.cpp
+ */
+void tst_message_decoder::test_decodeClear()
+{
+    ClearFrame frame;
+
+    QVERIFY(MessageDecoder::decodeClear("12,\n", frame));
+    QCOMPARE(frame.errorId, 12);
+
+    QVERIFY(MessageDecoder::decodeClear(" 7\n", frame));
+    QCOMPARE(frame.errorId, 7);
+
+    QVERIFY(!MessageDecoder::decodeClear("abc,\n", frame));
+}
+
+/**
+ * Test case for decodeBegin() in messagedecoder.cpp
+ */
+void tst_message_decoder::test_decodeBegin()
+{
+    BeginFrame frame;
+
+    QVERIFY(MessageDecoder::decodeBegin("1:02:03:004,1.0.2,ab12,\n", frame));
+    QCOMPARE(frame.elapsedMsecs, 3723004LL);
+    QCOMPARE(frame.version.toByteArray(), QByteArray("1.0.2"));
+    QCOMPARE(frame.crc.toByteArray(), QByteArray("ab12"));
+
+    QVERIFY(!MessageDecoder::decodeBegin("1:02:03,1.0.2,ab12,\n", frame));
+    QVERIFY(!MessageDecoder::decodeBegin("1.0.2,ab12,\n", frame));
+}
+
+/**
+ * Test case for decodeElectricalDump() in messagedecoder.cpp
+ *
+ * Ensures decoding stops at the first invalid component
+ */
+void tst_message_decoder::test_decodeElectricalDump()
+{
+    QVector<ElectricalFrame> frames;
+
+    QVERIFY(MessageDecoder::decodeElectricalDump("Servo Motor, 20.2, 4.9,,Piston, 12, 1.5\n", frames));
+    QCOMPARE(frames.length(), 2);
+    QCOMPARE(frames[0].name.toByteArray(), QByteArray("Servo Motor"));
+    QCOMPARE(frames[0].voltage, 20.2);
+    QCOMPARE(frames[1].amps, 1.5);
+
+    frames.clear();
+    QVERIFY(!MessageDecoder::decodeElectricalDump("Servo Motor, 20.2, 4.9,,Piston, x, 1.5,,Oil, 1, 1\n", frames));
+    QCOMPARE(frames.length(), 1);
+}
+
+/**
+ * Test case for formatTimeStamp() in messagedecoder.cpp
+ *
+ * Ensures formatted time stamps decode back to the same number of milliseconds
+ */
+void tst_message_decoder::test_formatTimeStamp()
+{
+    QCOMPARE(MessageDecoder::formatTimeStamp(150), QString("00:00:00:150"));
+    QCOMPARE(MessageDecoder::formatTimeStamp(4543237), QString("01:15:43:237"));
+
+    // hours are not limited to 2 digits
+    QCOMPARE(MessageDecoder::formatTimeStamp(360000000 + 61001), QString("100:01:01:001"));
+
+    qint64 msecs = 0;
+    QVERIFY(MessageDecoder::parseTimeStamp(MessageDecoder::formatTimeStamp(4543237).toUtf8(), msecs));
+    QCOMPARE(msecs, qint64(4543237));
+
+    // garbage and negative parts are rejected rather than read as 0
+    QVERIFY(!MessageDecoder::parseTimeStamp("01:xx:43:237", msecs));
+    QVERIFY(!MessageDecoder::parseTimeStamp("01:15:-43:237", msecs));
+    QVERIFY(!MessageDecoder::parseTimeStamp("01:15:43:", msecs));
+    QCOMPARE(msecs, qint64(4543237));
+}
+
+QTEST_MAIN(tst_message_decoder)
+#include "tst_message_decoder.moc"
+#endif
@@ -0,0 +1,149 @@
+#if DEV_MODE
+#include <QCoreApplication>
+#include <QTest>
+#include <QSignalSpy>
+#include "../weapon-system-support-software/notificationsmodel.h"
+#include "../weapon-system-support-software/constants.h"
+
+class tst_notifications : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void test_add();
+    void test_add_repeat();
+    void test_add_repeatOutsideWindow();
+    void test_add_wrap();
+};
+
+/**
+ * Test case for add() in notificationsmodel.cpp
+ */
+void tst_notifications::test_add()
+{
+    NotificationsModel model;
+    QSignalSpy inserted(&model, &NotificationsModel::rowsInserted);
+
+    // a new notification is a new row
+    QVERIFY(model.add("00:00:01", "Connected", "", false));
+    QVERIFY(model.add("00:00:02", "Lost connection", "COM3", true));
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(inserted.count(), 2);
+    QCOMPARE(inserted[1][1].toInt(), 1);
+    QCOMPARE(inserted[1][2].toInt(), 1);
+
+    // rows are formatted with their details
+    QCOMPARE(model.data(model.index(0)).toString(), "00:00:01 Connected");
+    QCOMPARE(model.data(model.index(1)).toString(), "00:00:02 Lost connection : COM3");
+    QCOMPARE(model.data(model.index(1), Qt::ForegroundRole).value<QColor>(), QColor(ERROR_COLOR));
+    QVERIFY(!model.data(model.index(2)).isValid());
+
+    QCOMPARE(model.latestText(), "Lost connection");
+    QCOMPARE(model.latestIsError(), true);
+    QCOMPARE(model.totalErrors(), 1);
+    QCOMPARE(model.totalInfo(), 1);
+}
+
+/**
+ * Test case for add() in notificationsmodel.cpp
+ *
+ * Ensures a repeated notification bumps its count without adding a row
+ */
+void tst_notifications::test_add_repeat()
+{
+    NotificationsModel model;
+    model.add("00:00:01", "Malformed message", "1,2", true);
+    model.add("00:00:02", "Connected", "", false);
+
+    QSignalSpy inserted(&model, &NotificationsModel::rowsInserted);
+    QSignalSpy changed(&model, &NotificationsModel::dataChanged);
+
+    // the repeat updates the existing row with its latest time and details
+    QVERIFY(!model.add("00:00:03", "Malformed message", "3,4", true));
+    QCOMPARE(model.rowCount(), 2);
+    QCOMPARE(inserted.count(), 0);
+    QCOMPARE(changed.count(), 1);
+    QCOMPARE(changed[0][0].value<QModelIndex>().row(), 0);
+    QCOMPARE(model.data(model.index(0)).toString(), "00:00:03 Malformed message : 3,4 (x2)");
+
+    // repeats are still counted and reported as the latest notification
+    QCOMPARE(model.totalErrors(), 2);
+    QCOMPARE(model.latestText(), "Malformed message");
+
+    // the same text with another severity is not a repeat
+    QVERIFY(model.add("00:00:04", "Malformed message", "", false));
+    QCOMPARE(model.rowCount(), 3);
+}
+
+/**
+ * Test case for add() in notificationsmodel.cpp
+ *
+ * Ensures only the last NOTIFICATION_DEDUPE_WINDOW notifications are checked for repeats
+ */
+void tst_notifications::test_add_repeatOutsideWindow()
+{
+    NotificationsModel model;
+    model.add("00:00:00", "Repeated", "", false);
+
+    for (int i = 0; i < NOTIFICATION_DEDUPE_WINDOW; i++)
+    {
+        model.add("00:00:01", "Notification " + QString::number(i), "", false);
+    }
+
+    QVERIFY(model.add("00:00:02", "Repeated", "", false));
+    QCOMPARE(model.rowCount(), NOTIFICATION_DEDUPE_WINDOW + 2);
+}
+
+/**
+ * Test case for add() in notificationsmodel.cpp
+ *
+ * Ensures the oldest row is removed before the newest is inserted once the ring buffer
+ * is full, and rows stay in order after the buffer wraps
+ */
+void tst_notifications::test_add_wrap()
+{
+    NotificationsModel model;
+
+    for (int i = 0; i < NOTIFICATION_CAPACITY; i++)
+    {
+        model.add("00:00:00", "Notification " + QString::number(i), "", false);
+    }
+    QCOMPARE(model.rowCount(), NOTIFICATION_CAPACITY);
+
+    QSignalSpy removed(&model, &NotificationsModel::rowsRemoved);
+    QSignalSpy inserted(&model, &NotificationsModel::rowsInserted);
+
+    // a full buffer drops the oldest row for the new one
+    QVERIFY(model.add("00:00:01", "Notification " + QString::number(NOTIFICATION_CAPACITY), "", false));
+    QCOMPARE(model.rowCount(), NOTIFICATION_CAPACITY);
+
+    QCOMPARE(removed.count(), 1);
+    QCOMPARE(removed[0][1].toInt(), 0);
+    QCOMPARE(removed[0][2].toInt(), 0);
+    QCOMPARE(inserted.count(), 1);
+    QCOMPARE(inserted[0][1].toInt(), NOTIFICATION_CAPACITY - 1);
+    QCOMPARE(inserted[0][2].toInt(), NOTIFICATION_CAPACITY - 1);
+
+    QCOMPARE(model.data(model.index(0)).toString(), "00:00:00 Notification 1");
+    QCOMPARE(model.data(model.index(NOTIFICATION_CAPACITY - 1)).toString(),
+             "00:00:01 Notification " + QString::number(NOTIFICATION_CAPACITY));
+
+    // wrap the buffer all the way around
+    for (int i = NOTIFICATION_CAPACITY + 1; i < 2 * NOTIFICATION_CAPACITY + 10; i++)
+    {
+        model.add("00:00:02", "Notification " + QString::number(i), "", false);
+    }
+
+    QCOMPARE(model.rowCount(), NOTIFICATION_CAPACITY);
+    QCOMPARE(removed.count(), NOTIFICATION_CAPACITY + 10);
+    QCOMPARE(model.data(model.index(0)).toString(), "00:00:02 Notification " + QString::number(NOTIFICATION_CAPACITY + 10));
+    QCOMPARE(model.data(model.index(NOTIFICATION_CAPACITY - 1)).toString(),
+             "00:00:02 Notification " + QString::number(2 * NOTIFICATION_CAPACITY + 9));
+
+    // dropped notifications are still counted
+    QCOMPARE(model.totalInfo(), 2 * NOTIFICATION_CAPACITY + 10);
+}
+
+QTEST_MAIN(tst_notifications)
+#include "tst_notifications.moc"
+#endif
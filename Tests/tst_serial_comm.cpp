@@ -1,6 +1,14 @@
 #if DEV_MODE
 #include <QTest>
 #include "../weapon-system-support-software/connection.cpp"
+#include "../weapon-system-support-software/spscqueue.h"
+#include "../weapon-system-support-software/sessioncapture.h"
+#include "../weapon-system-support-software/sessionreplayer.h"
+#include "../weapon-system-support-software/latencytracker.h"
+#include "../weapon-system-support-software/csimload.h"
+#include "../weapon-system-support-software/messagedecoder.h"
+#include <QSignalSpy>
+#include <QTemporaryDir>
 
 // add necessary includes here
 class tst_serial_comm : public QObject
@@ -18,6 +26,28 @@ private slots:
     void test_transmit();
 
     void test_checkForValidMessage();
+
+    void test_takeMessage();
+
+    void test_discardAvailable();
+
+    void test_spscQueue();
+
+    void test_pipeTransport();
+
+    void test_ptyTransport();
+
+    void test_sessionCapture();
+
+    void test_sessionReplay();
+
+    void test_latencyHistogram();
+
+    void test_latencyTracker();
+
+    void test_csimLoadProfile();
+
+    void test_csimLoadGenerator();
 };
 
 tst_serial_comm::tst_serial_comm()
@@ -84,7 +114,526 @@ void tst_serial_comm::test_checkForValidMessage()
     delete receiver;
 }
 
+void tst_serial_comm::test_takeMessage()
+{
+    //no port is needed, bytes are fed straight into the receive buffer
+    Connection *receiver = new Connection("", QSerialPort::Baud9600, QSerialPort::Data8,
+                                          QSerialPort::NoParity, QSerialPort::OneStop, QSerialPort::NoFlowControl);
+
+    receiver->appendReceivedData("5,first message\n3,second mes");
+
+    //first message is complete
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("5,first message\n"));
+
+    //second message has not been terminated yet
+    QCOMPARE(UNTERMINATED_MESSAGE, receiver->checkForValidMessage());
+    QVERIFY(receiver->takeMessage().isEmpty());
+
+    //remainder of the second message arrives along with a third message
+    receiver->appendReceivedData("sage\n7\n");
+
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("3,second message\n"));
+
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("7\n"));
+
+    delete receiver;
+}
+
+void tst_serial_comm::test_discardAvailable()
+{
+    Connection *sender = new Connection(TRANSPORT_PIPE_PREFIX + "discard");
+    Connection *receiver = new Connection(TRANSPORT_PIPE_PREFIX + "discard");
+
+    //a complete message and the start of another are buffered
+    sender->transmit("5,kept\n3,cut sh");
+    QVERIFY(receiver->device->waitForReadyRead(100));
+    receiver->readAvailable();
+    QCOMPARE(receiver->bufferedBytes(), qsizetype(15));
+
+    //the bytes waiting in the port are dropped, along with the message they cut short
+    sender->transmit("ort\n4,lo");
+    QVERIFY(receiver->device->waitForReadyRead(100));
+    receiver->discardAvailable();
+    QCOMPARE(receiver->bufferedBytes(), qsizetype(7));
+    QCOMPARE(receiver->takeDiscardedBytes(), qint64(16));
+
+    //the rest of the message cut short is skipped when reading resumes
+    sender->transmit("st\n7,next\n");
+    QVERIFY(receiver->device->waitForReadyRead(100));
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("5,kept\n"));
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("7,next\n"));
+    QCOMPARE(receiver->takeDiscardedBytes(), qint64(3));
+    QCOMPARE(receiver->takeDiscardedBytes(), qint64(0));
+
+    delete receiver;
+    delete sender;
+}
+
+void tst_serial_comm::test_spscQueue()
+{
+    //capacity is rounded up to a power of 2
+    SpscQueue<int> queue(3);
+    int item = 0;
+
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(item));
+
+    //fill the queue
+    for (int i = 0; i < 4; i++)
+    {
+        QVERIFY(queue.push(int(i)));
+    }
+    QVERIFY(queue.isFull());
+    QVERIFY(!queue.push(4));
+
+    //items come out in the order they went in
+    for (int i = 0; i < 4; i++)
+    {
+        QVERIFY(queue.pop(item));
+        QCOMPARE(item, i);
+    }
+    QVERIFY(queue.isEmpty());
+
+    //hand items from a producer thread to this thread, wrapping the queue many times
+    const int numItems = 100000;
+    QThread *producer = QThread::create([&queue]() {
+        for (int i = 0; i < numItems; i++)
+        {
+            while (!queue.push(int(i))) QThread::yieldCurrentThread();
+        }
+    });
+    producer->start();
+
+    int expected = 0;
+    while (expected < numItems)
+    {
+        if (queue.pop(item))
+        {
+            QCOMPARE(item, expected);
+            expected++;
+        }
+    }
+
+    producer->wait();
+    delete producer;
+}
+
+void tst_serial_comm::test_pipeTransport()
+{
+    //bytes written before the other end opens are kept for it
+    Connection *sender = new Connection(TRANSPORT_PIPE_PREFIX + "test");
+    sender->transmit("5,first message\n");
+
+    Connection *receiver = new Connection(TRANSPORT_PIPE_PREFIX + "test");
+    QVERIFY(sender->device->isOpen());
+    QVERIFY(receiver->device->isOpen());
+
+    QVERIFY(receiver->device->waitForReadyRead(100));
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("5,first message\n"));
+
+    //the pipe carries bytes both ways
+    receiver->transmit("3,reply\n");
+    QVERIFY(sender->device->waitForReadyRead(100));
+    QCOMPARE(VALID_MESSAGE, sender->checkForValidMessage());
+    QCOMPARE(sender->takeMessage().toByteArray(), QByteArray("3,reply\n"));
+
+    //a pipe of another name is not connected
+    Connection *other = new Connection(TRANSPORT_PIPE_PREFIX + "other");
+    other->transmit("4,lost\n");
+    QVERIFY(!receiver->device->waitForReadyRead(10));
+
+    //bytes written from another thread wake a waiting end
+    QThread *writer = QThread::create([sender]() { sender->device->write("7\n"); });
+    writer->start();
+    QVERIFY(receiver->device->waitForReadyRead(1000));
+    writer->wait();
+    delete writer;
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+
+    //a new end takes the place of a closed one
+    delete receiver;
+    receiver = new Connection(TRANSPORT_PIPE_PREFIX + "test");
+    sender->transmit("6,1,\n");
+    QVERIFY(receiver->device->waitForReadyRead(100));
+    QCOMPARE(VALID_MESSAGE, receiver->checkForValidMessage());
+    QCOMPARE(receiver->takeMessage().toByteArray(), QByteArray("6,1,\n"));
+
+    delete other;
+    delete receiver;
+    delete sender;
+}
 
+void tst_serial_comm::test_ptyTransport()
+{
+#ifdef Q_OS_UNIX
+    QString link = QDir::tempPath() + "/wsss-test-pty";
+
+    //the other side opens the pty link as a serial port
+    Connection *controller = new Connection(TRANSPORT_PTY_PREFIX + link);
+    if (!controller->device->isOpen())
+    {
+        delete controller;
+        QSKIP("ptys are not available");
+    }
+    QVERIFY(QFile::exists(link));
+
+    Connection *ddm = new Connection(link);
+    QVERIFY(ddm->device->isOpen());
+
+    controller->transmit("5,status\n");
+    QVERIFY(ddm->device->waitForReadyRead(1000));
+    QCOMPARE(VALID_MESSAGE, ddm->checkForValidMessage());
+    QCOMPARE(ddm->takeMessage().toByteArray(), QByteArray("5,status\n"));
+
+    ddm->transmit("8\n");
+    QVERIFY(controller->device->waitForReadyRead(1000));
+    QCOMPARE(VALID_MESSAGE, controller->checkForValidMessage());
+    QCOMPARE(controller->takeMessage().toByteArray(), QByteArray("8\n"));
+
+    delete ddm;
+    delete controller;
+
+    //the link is removed with the pty
+    QVERIFY(!QFile::exists(link));
+#else
+    QSKIP("ptys are only available on unix");
+#endif
+}
+
+void tst_serial_comm::test_sessionCapture()
+{
+    QString captureFile = QDir::tempPath() + "/tst_sessionCapture" + SESSION_CAPTURE_SUFFIX;
+    QByteArray frames[3] = {"8,00:00:01:000,6.7.2,2F5A1D3E7B9,\n", "3,0,00:00:01:005,Sample event message 1,\n", "6,0,\n"};
+
+    SessionCaptureWriter writer;
+    QVERIFY(writer.open(captureFile));
+    for (const QByteArray &frame : frames)
+    {
+        writer.record(frame);
+    }
+    QCOMPARE(writer.frameCount(), 3);
+    writer.close();
+
+    //frames come back in order with monotonic time stamps
+    SessionCaptureReader reader;
+    CapturedFrame frame;
+    qint64 lastTimeNs = -1;
+    QVERIFY(reader.open(captureFile));
+    for (const QByteArray &expected : frames)
+    {
+        QVERIFY(reader.next(frame));
+        QCOMPARE(frame.data, expected);
+        QVERIFY(frame.timeNs >= lastTimeNs);
+        lastTimeNs = frame.timeNs;
+    }
+    QVERIFY(!reader.next(frame));
+    reader.close();
+
+    //a record cut short ends the capture
+    QFile file(captureFile);
+    QVERIFY(file.resize(file.size() - 2));
+    QVERIFY(reader.open(captureFile));
+    QVERIFY(reader.next(frame));
+    QVERIFY(reader.next(frame));
+    QVERIFY(!reader.next(frame));
+    reader.close();
+
+    //other files are not captures
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    file.write("ID: 0, 00:00:01:005, Sample event message 1\n");
+    file.close();
+    QVERIFY(!reader.open(captureFile));
+
+    QVERIFY(QFile::remove(captureFile));
+}
+
+void tst_serial_comm::test_sessionReplay()
+{
+    QString captureFile = QDir::tempPath() + "/tst_sessionReplay" + SESSION_CAPTURE_SUFFIX;
+    int numFrames = 1000;
+
+    SessionCaptureWriter writer;
+    QVERIFY(writer.open(captureFile));
+    for (int i = 0; i < numFrames; i++)
+    {
+        writer.record("3," + QByteArray::number(i) + ",00:00:01:005,Sample event message 1,\n");
+    }
+    writer.close();
+
+    //the ddm end of a pipe, the replayer stands in for the controller
+    Connection *ddm = new Connection(TRANSPORT_PIPE_PREFIX + "replay");
+    SessionReplayer replayer;
+    QSignalSpy finishedSpy(&replayer, &SessionReplayer::replayFinished);
+    replayer.startReplay(TRANSPORT_PIPE_PREFIX + "replay", captureFile, true);
+
+    //nothing is replayed until the handshake
+    QVERIFY(!ddm->device->waitForReadyRead(100));
+    ddm->sendHandshakeMsg();
+
+    //every frame arrives in order
+    int received = 0;
+    while (received < numFrames && ddm->device->waitForReadyRead(1000))
+    {
+        while (received < numFrames && ddm->checkForValidMessage() == VALID_MESSAGE)
+        {
+            QCOMPARE(ddm->takeMessage().toByteArray(),
+                     "3," + QByteArray::number(received) + ",00:00:01:005,Sample event message 1,\n");
+            received++;
+        }
+    }
+    QCOMPARE(received, numFrames);
+
+    //the replay ended before the session, so the ddm is sent a closing message
+    QVERIFY(replayer.wait(5000));
+    QCOMPARE(finishedSpy.count(), 1);
+    QCOMPARE(finishedSpy.first().first().toLongLong(), qint64(numFrames));
+    QCOMPARE(VALID_MESSAGE, ddm->checkForValidMessage());
+    QCOMPARE(ddm->takeMessage().toByteArray(), QByteArray::number(CLOSING_CONNECTION) + ",\n");
+
+    delete ddm;
+    QVERIFY(QFile::remove(captureFile));
+}
+
+void tst_serial_comm::test_latencyHistogram()
+{
+    LatencyHistogram histogram;
+    QCOMPARE(histogram.count(), qint64(0));
+    QCOMPARE(histogram.percentile(50), qint64(0));
+
+    for (qint64 nsecs = 1; nsecs <= 1000; nsecs++)
+    {
+        histogram.record(nsecs);
+    }
+
+    QCOMPARE(histogram.count(), qint64(1000));
+    QCOMPARE(histogram.min(), qint64(1));
+    QCOMPARE(histogram.max(), qint64(1000));
+    QCOMPARE(histogram.mean(), 500.5);
+
+    //small latencies are exact, larger ones are within a bucket's width
+    QCOMPARE(histogram.percentile(10), qint64(100));
+    QVERIFY(histogram.percentile(50) >= 500 && histogram.percentile(50) <= 510);
+    QVERIFY(histogram.percentile(99) >= 990 && histogram.percentile(99) <= 1000);
+    QCOMPARE(histogram.percentile(100), qint64(1000));
+
+    //buckets are no wider than 1/64 of the latencies they count, and end at the limit
+    for (int i = 128; i < LatencyHistogram::bucketCount(); i++)
+    {
+        qint64 width = LatencyHistogram::bucketHighest(i) - LatencyHistogram::bucketLowest(i) + 1;
+        QVERIFY(width * 64 <= LatencyHistogram::bucketLowest(i));
+    }
+    QCOMPARE(LatencyHistogram::bucketHighest(LatencyHistogram::bucketCount() - 1), (Q_INT64_C(1) << 40) - 1);
+
+    //longer latencies are counted in the last bucket
+    histogram.reset();
+    histogram.record(Q_INT64_C(1) << 50);
+    QCOMPARE(histogram.bucket(LatencyHistogram::bucketCount() - 1), qint64(1));
+    QCOMPARE(histogram.count(), qint64(1));
+}
+
+void tst_serial_comm::test_latencyTracker()
+{
+    LatencyTracker tracker;
+    QTemporaryDir reportDir;
+    QVERIFY(reportDir.isValid());
+
+    //a frame that skipped the dequeued and log queued stages
+    FrameTimestamps timestamps;
+    timestamps.nsecs[STAGE_READ] = 1000;
+    timestamps.nsecs[STAGE_FRAMED] = 2000;
+    timestamps.nsecs[STAGE_DECODED] = 3000;
+    timestamps.nsecs[STAGE_STORED] = 10000;
+
+    tracker.frameHandled(STATUS, timestamps, false);
+    QCOMPARE(tracker.frameCount(), qint64(1));
+
+    //frames waiting for a render are recorded by the render
+    tracker.frameHandled(EVENT, timestamps, true);
+    QCOMPARE(tracker.frameCount(), qint64(1));
+    tracker.rendered();
+    QCOMPARE(tracker.frameCount(), qint64(2));
+
+    //frames the reader did not stamp are not recorded
+    tracker.frameHandled(ERROR, FrameTimestamps(), false);
+    QCOMPARE(tracker.frameCount(), qint64(2));
+
+    QVERIFY(tracker.report().contains("STATUS"));
+    QVERIFY(tracker.report().contains("EVENT"));
+    QVERIFY(!tracker.report().contains("ERROR"));
+
+    //skipped stages are counted in the next stage reached
+    QString reportFile = reportDir.filePath("latency.txt");
+    QVERIFY(tracker.dumpToFile(reportFile));
+
+    QFile file(reportFile);
+    QVERIFY(file.open(QIODevice::ReadOnly | QIODevice::Text));
+    QByteArray contents = file.readAll();
+    QVERIFY(contents.contains("STATUS,stored,6976,7039,1\n"));
+    QVERIFY(contents.contains("STATUS,total,8960,9087,1\n"));
+
+    tracker.reset();
+    QCOMPARE(tracker.frameCount(), qint64(0));
+    QVERIFY(!tracker.report().contains("STATUS"));
+}
+
+void tst_serial_comm::test_csimLoadProfile()
+{
+    CSimLoadProfile profile;
+
+    //the profile shown on the dev page is valid
+    QVERIFY(CSimLoadProfile::parse(CSIM_LOAD_PROFILE, profile));
+    QCOMPARE(profile.framesPerSecond, 2000);
+
+    //keys that are not given keep their value
+    QVERIFY(CSimLoadProfile::parse("fps=500 burstPeriod=1000 burstDuration=100 burstFactor=4", profile));
+    QCOMPARE(profile.framesPerSecond, 500);
+    QCOMPARE(profile.eventWeight, 6);
+    QCOMPARE(profile.rateAt(50), 2000);
+    QCOMPARE(profile.rateAt(1500), 500);
+
+    //invalid words and profiles fail and leave the profile unchanged
+    const char *invalid[] = {
+        "bogus=1",       //unknown key
+        "fps",           //no value
+        "fps=abc",       //not a number
+        "fps=0",         //nothing is sent
+        "fps=-5",
+        "event=-1",
+        "burstFactor=0",
+        "burstFactor=1000000", //more than CSIM_LOAD_MAX_FRAMES_PER_SECOND during bursts
+        "fps=2000000",
+        "event=1000000", //weight over CSIM_LOAD_MAX_WEIGHT
+        "status=0 event=0 error=0 clear=0 electrical=0 dump=0",
+        "burstPeriod=100 burstDuration=200",
+        "dump=1 dumpSize=0",
+    };
+
+    for (const char *text : invalid)
+    {
+        CSimLoadProfile unchanged = profile;
+        QVERIFY2(!CSimLoadProfile::parse(text, unchanged), text);
+        QCOMPARE(unchanged.framesPerSecond, profile.framesPerSecond);
+        QCOMPARE(unchanged.eventWeight, profile.eventWeight);
+        QCOMPARE(unchanged.burstFactor, profile.burstFactor);
+    }
+}
+
+void tst_serial_comm::test_csimLoadGenerator()
+{
+    //send every kind of frame
+    CSimLoadProfile profile;
+    QVERIFY(CSimLoadProfile::parse("status=1 event=1 error=1 clear=1 electrical=1 dump=1 dumpSize=3", profile));
+
+    CSimLoadGenerator generator(profile, true, 1);
+    QByteArray out;
+    generator.appendFrames(out, 500, 3723004);
+    QCOMPARE(generator.framesGenerated(), qint64(500));
+
+    QList<QByteArray> messages = out.split('\n');
+    QVERIFY(messages.last().isEmpty());
+    messages.removeLast();
+    QCOMPARE(messages.size(), 500);
+
+    //every frame decodes as the DDM would decode it
+    int nextId = 1;
+    QVector<int> activeErrors;
+    int kinds[CLEAR_ERROR + 1] = {};
+
+    for (const QByteArray &message : messages)
+    {
+        SerialMessageIdentifier messageId;
+        QByteArrayView payload;
+        QVERIFY2(MessageDecoder::splitMessageId(message, messageId, payload), message.constData());
+        QVERIFY(messageId <= CLEAR_ERROR);
+        kinds[messageId]++;
+
+        switch (messageId)
+        {
+        case STATUS:
+        {
+            StatusFrame frame;
+            QVERIFY2(MessageDecoder::decodeStatus(payload, frame), message.constData());
+            break;
+        }
+        case EVENT:
+        {
+            EventFrame frame;
+            QVERIFY2(MessageDecoder::decodeEvent(payload, frame), message.constData());
+            QCOMPARE(frame.id, nextId++);
+            QCOMPARE(frame.timeMs, qint64(3723004));
+            break;
+        }
+        case ERROR:
+        {
+            ErrorFrame frame;
+            QVERIFY2(MessageDecoder::decodeError(payload, frame), message.constData());
+            QCOMPARE(frame.id, nextId++);
+            QCOMPARE(frame.timeMs, qint64(3723004));
+            if (!frame.cleared)
+            {
+                activeErrors.append(frame.id);
+            }
+            break;
+        }
+        case CLEAR_ERROR:
+        {
+            //only errors sent active are cleared, and only once
+            ClearFrame frame;
+            QVERIFY2(MessageDecoder::decodeClear(payload, frame), message.constData());
+            QVERIFY(activeErrors.removeOne(frame.errorId));
+            break;
+        }
+        case ELECTRICAL:
+        {
+            QVector<ElectricalFrame> frames;
+            QVERIFY2(MessageDecoder::decodeElectricalDump(payload, frames), message.constData());
+            QVERIFY(!frames.isEmpty());
+            break;
+        }
+        case EVENT_DUMP:
+        {
+            QVector<EventFrame> frames;
+            QVERIFY2(MessageDecoder::decodeEventDump(payload, frames), message.constData());
+            QCOMPARE(frames.size(), 3);
+            for (const EventFrame &frame : frames)
+            {
+                QCOMPARE(frame.id, nextId++);
+            }
+            break;
+        }
+        case ERROR_DUMP:
+        {
+            QVector<ErrorFrame> frames;
+            QVERIFY2(MessageDecoder::decodeErrorDump(payload, frames), message.constData());
+            QCOMPARE(frames.size(), 3);
+            for (const ErrorFrame &frame : frames)
+            {
+                QCOMPARE(frame.id, nextId++);
+                if (!frame.cleared)
+                {
+                    activeErrors.append(frame.id);
+                }
+            }
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    //500 frames picked from 6 kinds send every kind
+    for (int kind = EVENT_DUMP; kind <= CLEAR_ERROR; kind++)
+    {
+        QVERIFY(kinds[kind] > 0);
+    }
+    QCOMPARE(generator.nextId(), nextId);
+}
 
 QTEST_MAIN(tst_serial_comm)
 #include "tst_serial_comm.moc"
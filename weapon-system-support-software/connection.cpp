@@ -26,7 +26,9 @@
 Connection::Connection(QString portName, QSerialPort::BaudRate baudRate,
                        QSerialPort::DataBits dataBits, QSerialPort::Parity parity,
                        QSerialPort::StopBits stopBits, QSerialPort::FlowControl flowControl)
-                       : portName(portName), connected(false)
+                       : portName(portName), connected(false),
+                       readPosition(0), scanPosition(0), messageEnd(-1),
+                       resyncing(false), discardedBytes(0)
 {
     // configure this connection to the given port name
     serialPort.setPortName(portName);
@@ -38,75 +40,226 @@ Connection::Connection(QString portName, QSerialPort::BaudRate baudRate,
     serialPort.setStopBits(stopBits);
     serialPort.setFlowControl(flowControl);
 
+    // loopback transports stand in for the serial port
+    if (portName.startsWith(TRANSPORT_PIPE_PREFIX))
+    {
+        device = new PipeTransport(portName.mid(TRANSPORT_PIPE_PREFIX.size()), this);
+    }
+    #ifdef Q_OS_UNIX
+    else if (portName.startsWith(TRANSPORT_PTY_PREFIX))
+    {
+        device = new PtyTransport(portName.mid(TRANSPORT_PTY_PREFIX.size()), this);
+    }
+    #endif
+    else
+    {
+        device = &serialPort;
+    }
+
     // open the port
-    serialPort.open(QIODevice::ReadWrite);
+    device->open(QIODevice::ReadWrite);
 
     // log result
-    if (!serialPort.isOpen())
+    if (!device->isOpen())
     {
         qDebug() << "Failed to open " << portName;
     }
     else
     {
         qDebug() << portName << " opened successfully";
-        serialPort.clear();
-        serialPort.readAll();
+        if (device == &serialPort)
+        {
+            serialPort.clear();
+        }
+        device->readAll();
     }
 }
 
 /**
  * @brief Verifies that the incomming serialized message is valid
  *
- * The function first checks the serial port is open, then captures the
- * the message to check for expected end of message character (\n).
+ * The function moves any bytes waiting in the serial port into the receive buffer, then
+ * scans the bytes that have not been scanned before for the expected end of message
+ * character (\n). Because the scan position is remembered between calls, draining N
+ * messages from a large dump only touches each byte once.
  *
- * Returns true if the message is valid, false otherwise
+ * Returns VALID_MESSAGE if a complete message is buffered, EMPTY_BUFFER or
+ * UNTERMINATED_MESSAGE otherwise
  */
 int Connection::checkForValidMessage()
 {
-    // returns true if a valid message is in the serial port, false otherwise
     // ensure port is open to prevent possible errors
-    if (serialPort.isOpen())
+    if (device->isOpen())
     {
-        //copy data from serial port buffer without altering buffer
-        QByteArray serializedMessage = serialPort.peek(serialPort.bytesAvailable());
+        //move data from the serial port buffer into our receive buffer
+        readAvailable();
+    }
+    //a closed port can still have buffered messages left to hand out
+    else if (readPosition == receiveBuffer.size())
+    {
+        qDebug() << "Error: serial port is closed, message cannot be read" << Qt::endl;
 
-        QString message = QString::fromUtf8(serializedMessage);
+        //invalid message
+        return false;
+    }
 
-        //check for complete message
-        if ( message.contains("\n") || message.contains('\n') )
-        {
-            return VALID_MESSAGE;
-        }
-        else if (message=="")
-        {
-            return EMPTY_BUFFER;
-        }
-        else
-        {
-            return UNTERMINATED_MESSAGE;
-        }
-        // uncomment to see bytes debug
-        /*#if DEV_MODE && SERIAL_COMM_DEBUG
-        else
+    //only scan bytes we have not looked at yet
+    if (messageEnd == -1)
+    {
+        messageEnd = receiveBuffer.indexOf('\n', scanPosition);
+
+        //remember where to resume scanning
+        scanPosition = (messageEnd == -1) ? receiveBuffer.size() : messageEnd + 1;
+    }
+
+    //check for complete message
+    if (messageEnd != -1)
+    {
+        return VALID_MESSAGE;
+    }
+    else if (readPosition == receiveBuffer.size())
+    {
+        return EMPTY_BUFFER;
+    }
+    else
+    {
+        return UNTERMINATED_MESSAGE;
+    }
+}
+
+/**
+ * @brief Moves any bytes waiting in the serial port into the receive buffer
+ *
+ * Emptying the port also acknowledges its read notification, so a reader that can
+ * not take messages yet is not woken again for the same bytes.
+ */
+void Connection::readAvailable()
+{
+    if (device->isOpen() && device->bytesAvailable() > 0)
+    {
+        appendReceivedData(device->readAll());
+    }
+}
+
+/**
+ * @brief Removes the next complete message from the receive buffer
+ *
+ * The returned view includes the terminating \n and points directly into the receive buffer,
+ * so no copy is made. It remains valid until the next call to checkForValidMessage.
+ *
+ * @return The next message, or an empty view if no complete message is buffered
+ */
+QByteArrayView Connection::takeMessage()
+{
+    //check for complete message
+    if (messageEnd == -1)
+    {
+        return QByteArrayView();
+    }
+
+    //hand out the bytes between the read position and the end of the message
+    QByteArrayView message(receiveBuffer.constData() + readPosition, messageEnd + 1 - readPosition);
+
+    //consume the message
+    readPosition = messageEnd + 1;
+    messageEnd = -1;
+
+    return message;
+}
+
+/**
+ * @brief Appends raw bytes to the receive buffer
+ *
+ * Consumed bytes are released from the front of the buffer once they make up at least half
+ * of it, which keeps the cost of compaction linear in the number of bytes received.
+ *
+ * @param data The bytes received
+ */
+void Connection::appendReceivedData(QByteArrayView data)
+{
+    //skip the rest of a message cut short by dropped bytes
+    if (resyncing)
+    {
+        qsizetype end = data.indexOf('\n');
+        if (end == -1)
         {
-            qDebug() << "checkForValidMessage returned false for: " + message;
-            // Display the contents of the QByteArray in hexadecimal format
-            qDebug() << "Data received (hex): ";
-            for (int i = 0; i < serializedMessage.size(); ++i)
-            {
-                qDebug().noquote() << QString("%1 ").arg((quint8)serializedMessage[i], 2, 16, QLatin1Char('0')).toUpper();
-            }
+            discardedBytes += data.size();
+            return;
         }
-        #endif*/
+
+        discardedBytes += end + 1;
+        data = data.sliced(end + 1);
+        resyncing = false;
     }
-    else
+
+    //check if every buffered byte has been consumed
+    if (readPosition == receiveBuffer.size())
     {
-        qDebug() << "Error: serial port is closed, message cannot be read" << Qt::endl;
+        //keep the allocation, drop the contents
+        receiveBuffer.resize(0);
+        readPosition = scanPosition = 0;
+        messageEnd = -1;
+    }
+    //otherwise compact once consumed bytes make up half of the buffer
+    else if (readPosition > 0 && readPosition >= receiveBuffer.size() / 2)
+    {
+        receiveBuffer.remove(0, readPosition);
+        scanPosition -= readPosition;
+        if (messageEnd != -1) messageEnd -= readPosition;
+        readPosition = 0;
     }
 
-    //invalid message
-    return false;
+    receiveBuffer.append(data);
+}
+
+/**
+ * @brief Drops the bytes waiting in the serial port instead of buffering them
+ *
+ * Used when the receive buffer is full. The port is still emptied, so its read
+ * notification is acknowledged. The partial message at the end of the buffer lost its
+ * end with the dropped bytes, so it is dropped too, and the bytes up to the next \n are
+ * skipped once reading resumes. Complete messages already buffered are kept.
+ */
+void Connection::discardAvailable()
+{
+    if (!device->isOpen() || device->bytesAvailable() <= 0)
+    {
+        return;
+    }
+
+    discardedBytes += device->readAll().size();
+
+    //keep the buffer up to its last complete message
+    qsizetype keep = qMax(readPosition, receiveBuffer.lastIndexOf('\n') + 1);
+    discardedBytes += receiveBuffer.size() - keep;
+    receiveBuffer.resize(keep);
+    scanPosition = qMin(scanPosition, keep);
+
+    resyncing = true;
+}
+
+/**
+ * @brief Returns the number of bytes dropped since the last call
+ *
+ * Counts the bytes dropped by discardAvailable and the bytes skipped afterwards.
+ */
+qint64 Connection::takeDiscardedBytes()
+{
+    qint64 bytes = discardedBytes;
+    discardedBytes = 0;
+
+    return bytes;
+}
+
+/**
+ * @brief Discards all buffered bytes, including any partial message
+ */
+void Connection::clearReceiveBuffer()
+{
+    receiveBuffer.resize(0);
+    readPosition = scanPosition = 0;
+    messageEnd = -1;
+    resyncing = false;
 }
 
 /**
@@ -120,7 +273,7 @@ int Connection::checkForValidMessage()
 void Connection::transmit(QString message)
 {
     // confirm that the port is open
-    if (!serialPort.isOpen())
+    if (!device->isOpen())
     {
         // notify and return
         qDebug() << "Port " << portName << " is not open, transmission failed";
@@ -131,16 +284,16 @@ void Connection::transmit(QString message)
     QByteArray data = message.toUtf8();
 
     // write to serial port
-    qint64 bytesWritten = serialPort.write(data);
+    qint64 bytesWritten = device->write(data);
 
     // wait for full message to be sent before continuing
-    serialPort.waitForBytesWritten(500);
+    device->waitForBytesWritten(500);
 
     // check for failure
     if (bytesWritten != data.size())
     {
         // notify
-        qWarning() << "Failed to write to " << portName << " : " << serialPort.errorString();
+        qWarning() << "Failed to write to " << portName << " : " << device->errorString();
     }
     else
     {
@@ -200,11 +353,11 @@ Connection::~Connection()
         sendDisconnectMsg();
 
         //avoid prematurely closing serial port before closing message is sent
-        serialPort.waitForReadyRead(1000);
+        device->waitForReadyRead(1000);
     }
 
     // close the port
-    serialPort.close();
+    device->close();
 }
 
 //======================================================================================
@@ -3,13 +3,17 @@
 
 #include <QDebug>
 #include <QtSerialPort/QtSerialPort>
+#include <atomic>
 #include "constants.h"
+#include "transport.h"
 
 /********************************************************************************
 ** connection.h
 **
 ** The Connection class provides functionality for establishing and
 ** managing a serial port connection, including transmitting a message.
+** A port name starting with TRANSPORT_PIPE_PREFIX or TRANSPORT_PTY_PREFIX opens
+** a loopback transport instead of a serial port.
 **
 ** @author Team Controller
 ********************************************************************************/
@@ -19,9 +23,13 @@ class Connection : public QObject
     Q_OBJECT
 
 public:
-    // qt serial port class object
+    // qt serial port class object, holds the serial settings even when a loopback
+    // transport is used
     QSerialPort serialPort;
 
+    // device messages are read from and written to, the serial port or a loopback transport
+    QIODevice *device;
+
     // constructor, opens the port with given port name and initial settings
     Connection(QString portName, QSerialPort::BaudRate baudRate,
                QSerialPort::DataBits dataBits, QSerialPort::Parity parity,
@@ -33,15 +41,40 @@ public:
     // destructor, sends closing message to port then closes port
     ~Connection();
 
-    //checks if messages in the serial port are complete by checking if they contain \n
-    // return codes are VALID_MESSAGE, EMPTY_BUFFER, or UNTERMINATED_MESSAGE
+    //moves pending bytes from the serial port into the receive buffer and checks if it holds a complete
+    //message (terminated by \n). return codes are VALID_MESSAGE, EMPTY_BUFFER, or UNTERMINATED_MESSAGE
     int  checkForValidMessage();
 
+    //moves pending bytes from the serial port into the receive buffer without checking for a message.
+    //like checkForValidMessage, this invalidates the view returned by takeMessage
+    void readAvailable();
+
+    //removes the next complete message (including its \n) from the receive buffer. the returned view points
+    //into the receive buffer and is only valid until the next call to checkForValidMessage
+    QByteArrayView takeMessage();
+
+    //appends raw bytes to the receive buffer as if they were read from the serial port
+    void appendReceivedData(QByteArrayView data);
+
+    //drops the bytes waiting in the serial port instead of buffering them, along with the partial message
+    //they cut short. the rest of that message is skipped when it arrives
+    void discardAvailable();
+
+    //returns the number of bytes dropped since the last call
+    qint64 takeDiscardedBytes();
+
+    //number of bytes in the receive buffer that have not been handed out as messages
+    qsizetype bufferedBytes() const { return receiveBuffer.size() - readPosition; }
+
+    //discards all buffered bytes, including any partial message
+    void clearReceiveBuffer();
+
     //stores name of port given upon initialization
     QString portName;
 
-    // true when proper handshake has occurred on connected port
-    bool connected;
+    // true when proper handshake has occurred on connected port (read by the thread that owns
+    // the port and written by the gui thread, so it is atomic)
+    std::atomic<bool> connected;
 
 public slots:
     // sends message through port
@@ -52,6 +85,25 @@ public slots:
 
     // sends disconnect message through port
     void sendHandshakeMsg();
+
+private:
+    // bytes read from the port that have not been handed out as messages yet
+    QByteArray receiveBuffer;
+
+    // index of the first byte in the receive buffer that has not been consumed
+    qsizetype readPosition;
+
+    // index up to which the receive buffer has already been scanned for \n
+    qsizetype scanPosition;
+
+    // index of the \n terminating the next complete message, -1 if none has been found
+    qsizetype messageEnd;
+
+    // true after bytes were dropped, until the \n ending the message they cut short is received
+    bool resyncing;
+
+    // bytes dropped since takeDiscardedBytes was last called
+    qint64 discardedBytes;
 };
 
 #endif // CONNECTION_H
@@ -2,6 +2,7 @@
 #define CONSTANTS_H
 
 #include <QString>
+#include <QColor>
 #include <QtSerialPort/QtSerialPort>
 
 /********************************************************************************
@@ -146,6 +147,7 @@ const bool INITIAL_ADVANCED_LOG_FILE = false;
 const bool INITIAL_NOTIFY_ON_ERROR_CLEARED = false;
 const bool INITIAL_RAM_CLEARING = true; // used for improving CPU performance with large amount of nodes
 const int INITIAL_MAX_DATA_NODES = 10000;
+const bool INITIAL_RECORD_SESSIONS = false; // captures the frames received each session for replay
 
 // logfile settings
 const QString INITIAL_LOGFILE_LOCATION = "WSSS_Logfiles/";
@@ -168,9 +170,27 @@ const int ONE_SECOND = 1000;
 // time before clearing notification pop ups
 const int NOTIFICATION_DURATION = 3000;
 
+// number of notifications kept on the notifications page, the oldest are dropped
+const int NOTIFICATION_CAPACITY = 1000;
+
+// number of recent notifications a new notification is merged with if it repeats one
+const int NOTIFICATION_DEDUPE_WINDOW = 8;
+
 // cooldown for preventing spamming of handshake button (spamming causes crash)
 const int HANDSHAKE_COOLDOWN_TIME = 200;
 
+// rate at which the gui consumes messages decoded by the serial reader thread (~60 per second)
+const int SERIAL_FRAME_INTERVAL = 16;
+
+// shortest time between redraws of gui parts changed by incoming messages (~60 per second)
+const int RENDER_INTERVAL = 16;
+
+// gui parts redrawn by the render scheduler, combined as flags
+enum RenderRegion {RENDER_STATUS=0x1, RENDER_COUNTERS=0x2, RENDER_EVENTS_TAIL=0x4, RENDER_ELECTRICAL=0x8, RENDER_ERROR_SELECTION=0x10, RENDER_NOTIFICATIONS=0x20, RENDER_LAST_MESSAGE=0x40};
+
+// delay before the serial reader thread retries after the gui has fallen behind
+const int SERIAL_QUEUE_RETRY_INTERVAL = 5;
+
 // default time format - some conversion methods rely on being in this format
 const QString TIME_FORMAT = "HH:mm:ss";
 
@@ -188,6 +208,102 @@ const int NUM_ELECTRIC_ELEMENTS = 2; // name, voltage
 const int NUM_BEGIN_ELEMENTS = 3;
 const int NUM_STATUS_ELEMENTS = 9;
 
+//======================================================================================
+// Serial reader thread
+//======================================================================================
+
+// number of decoded messages that can wait between the serial reader thread and the gui
+const int SERIAL_FRAME_QUEUE_SIZE = 4096;
+
+// bytes that can wait in the receive buffer while the frame queue is full, further bytes
+// are dropped until the gui catches up
+const int SERIAL_RECEIVE_BUFFER_LIMIT = 16 * 1024 * 1024;
+
+// max number of decoded messages the gui processes per update, remaining messages wait
+// for the next update so the gui stays responsive during large bursts
+const int MAX_FRAMES_PER_UPDATE = 512;
+
+//======================================================================================
+// Loopback transports
+//======================================================================================
+
+// port names starting with these prefixes open a loopback transport instead of a serial
+// port (see transport.h). pipe: is followed by a name both ends open, pty: by the path
+// the other end opens as a serial port
+const QString TRANSPORT_PIPE_PREFIX = "pipe:";
+const QString TRANSPORT_PTY_PREFIX = "pty:";
+
+// time a pty write waits for the other end to read when the pty buffer is full (in msec)
+const int TRANSPORT_WRITE_TIMEOUT = 500;
+
+//======================================================================================
+// Search
+//======================================================================================
+
+// label of the search dialog, lists the filters that can be typed with the text
+const QString SEARCH_LABEL = "Search for some text (filters: id:<n> kind:events|errors|cleared|active from:<time> to:<time>):";
+
+// max number of ranked hits kept per search, every hit is still counted
+const int MAX_SEARCH_HITS = 1000;
+
+//======================================================================================
+// Log file writer
+//======================================================================================
+
+// bytes of log file text queued before the log writer thread writes it without waiting
+const int LOG_WRITER_BUFFER_SIZE = 64 * 1024;
+
+// longest time queued log file text waits before it is written to the file (msec)
+const int LOG_WRITER_FLUSH_INTERVAL = 1000;
+
+// minimum time between asking the operating system to commit the log file to disk,
+// 0 leaves it to the operating system (msec)
+const int LOG_WRITER_SYNC_INTERVAL = 5000;
+
+//======================================================================================
+// Log file loader
+//======================================================================================
+
+// bytes of a log file parsed by each thread pool task, chunks are extended to a line end
+const int LOG_LOADER_CHUNK_SIZE = 256 * 1024;
+
+//======================================================================================
+// Log view
+//======================================================================================
+
+// the log view index stores the offset of every n-th line, a row is found by scanning
+// at most this many lines
+const int LOG_VIEW_INDEX_STRIDE = 64;
+
+// appended to a log file name to name its saved log view index
+const QString LOG_VIEW_INDEX_SUFFIX = ".idx";
+
+//======================================================================================
+// Session capture
+//======================================================================================
+
+// appended to the session time to name a session capture, captures are saved in the
+// log file folder
+const QString SESSION_CAPTURE_SUFFIX = "-capture.wssc";
+
+// bytes of captured frames written to the port at once by the replayer
+const int REPLAY_BATCH_SIZE = 64 * 1024;
+
+// time the replayer waits for messages from the ddm between checks for a stop (in msec)
+const int REPLAY_POLL_INTERVAL = 50;
+
+//======================================================================================
+// Latency diagnostics
+//======================================================================================
+#if DEV_MODE
+// appended to the current time to name a saved latency report, reports are saved in the
+// log file folder
+const QString LATENCY_REPORT_SUFFIX = "-latency.txt";
+
+// rate at which the diagnostics page shows new latencies while it is open (in msec)
+const int DIAGNOSTICS_REFRESH_INTERVAL = 1000;
+#endif
+
 //======================================================================================
 // Integer codes
 //======================================================================================
@@ -207,6 +323,9 @@ const int VALID_MESSAGE=100;
 const int EMPTY_BUFFER = -107;
 const int UNTERMINATED_MESSAGE = -108;
 
+// return code for a log file load cancelled by the user
+const int LOAD_CANCELLED = -109;
+
 // default success code
 const int SUCCESS = 1;
 
@@ -228,15 +347,14 @@ const QString SELECTED_NOTIFICATIONS_ICON = "border-image: url(://resources/Imag
 const QString URGENT_NOTIFICATION_ICON = "border-image: url(://resources/Images/newNotification.png);";
 
 // colored output will apply these styles (toggle off to apply event color to all nodes)
-const QString EVENT_OUTPUT_SIZE = "16"; //px
-const QString EVENT_COLOR = "rgb(255, 255, 255)";
-const QString CLEARED_ERROR_COLOR = "rgb(20, 174, 92)"; //changes here must also be made in clearErrorFromEventsOutput found in mainwindow.cpp
-const QString ACTIVE_ERROR_COLOR = "rgb(254, 28, 28)";
+const int EVENT_OUTPUT_SIZE = 16; //px
+const QColor EVENT_COLOR(255, 255, 255);
+const QColor CLEARED_ERROR_COLOR(20, 174, 92);
+const QColor ACTIVE_ERROR_COLOR(254, 28, 28);
 
 // properties applied to notifications
 const QString INVISIBLE = "background-color: transparent; border: none;";
-const QString NOTIFICATION_SIZE = "16"; //px
-const QString NOTIFICATION_TIMESTAMP_STYLE = "color: white; font-size: 16px";
+const int NOTIFICATION_SIZE = 16; //px
 const QString ERROR_COLOR = "red";
 const QString STANDARD_COLOR = "green";
 const QString POP_UP_STYLE = "color: white; text-align: center; font-size: 16px;";
@@ -278,6 +396,30 @@ const QString INITIAL_CSIM_PORT = "COM4";
 //initial rate at which the csim thread will update the status class and send data through serial port (in msec)
 const int CSIM_GENERATION_INTERVAL = 2000;
 
+//load mode, frames per second generated by the default profile
+const int CSIM_LOAD_FRAMES_PER_SECOND = 2000;
+
+//load profile shown on the dev page, see CSimLoadProfile::parse
+const QString CSIM_LOAD_PROFILE = "fps=2000 status=1 event=6 error=2 clear=1 electrical=0 dump=0";
+
+//load mode, highest rate a profile may ask for, bursts included
+const int CSIM_LOAD_MAX_FRAMES_PER_SECOND = 1000000;
+
+//load mode, highest weight of a kind of frame in a profile
+const int CSIM_LOAD_MAX_WEIGHT = 1000;
+
+//load mode sends the frames due every tick in one write (in msec)
+const int CSIM_LOAD_TICK_INTERVAL = 1;
+
+//most frames written in one tick, frames that fall further behind are dropped
+const int CSIM_LOAD_MAX_BATCH = 4096;
+
+//randomized status frames generated once and sent in turn
+const int CSIM_LOAD_STATUS_TEMPLATES = 32;
+
+//most active errors remembered for clear frames
+const int CSIM_LOAD_MAX_ACTIVE_ERRORS = 1000;
+
 const int NUM_EVENT_MESSAGES = 3;
 const QString EVENT_MESSAGES[NUM_EVENT_MESSAGES] = {"Sample event message 1", "Sample event message 2; 76; 55.4", "Sample event message 3; 2"};
 
@@ -293,6 +435,11 @@ const QString ELECTRICAL_MESSAGES[NUM_ELECTRICAL_MESSAGES] = {"Servo Motor, 20.2
                                                               "sample component, 19.11, 2.72,,sample component, 11, 2.72,,sample component, 20.2, 2.72,,"
                                                               "sample component, 19.11, 96.5,,sample component, 19.11, 3.33"};
 
+//loopback ports listed with the serial ports, so csim and the ddm can run without hardware.
+//the ddm opens the csim pty link as a serial port
+const QString LOOPBACK_PIPE_PORT = TRANSPORT_PIPE_PREFIX + "csim";
+const QString CSIM_PTY_LINK = "/tmp/wsss-csim";
+
 const QString TEST_LOG_FILE = "/testLogFile.txt";
 
 const QString CRC_VERSION = "2F5A1D3E7B9";
@@ -6,7 +6,7 @@
 CSim::CSim(QObject *parent, QString portName)
     : QThread(parent), stop(false), portName(portName),
     connPtr(nullptr), eventsPtr(nullptr), startupTime(QDateTime::currentMSecsSinceEpoch()),
-    secondTrigger(true), pause(false)
+    secondTrigger(true), pause(false), loadMode(false)
 {
     // Avoid class initialization until thread is running
 }
@@ -136,17 +136,17 @@ void CSim::checkConnection(Connection *conn)
             break;
         }
 
-        conn->serialPort.waitForReadyRead(100);
+        conn->device->waitForReadyRead(100);
     }
 
     // Check for message from ddm
     if ( conn->checkForValidMessage() == VALID_MESSAGE )
     {
-        // Get serialized string from port
-        QByteArray serializedMessage = conn->serialPort.readAll();
+        // Deserialize the first complete message
+        QString message = QString::fromUtf8(conn->takeMessage());
 
-        // Deserialize string
-        QString message = QString::fromUtf8(serializedMessage);
+        // Drop anything else that was buffered, only the first message is acted on
+        conn->clearReceiveBuffer();
 
         // Extract message id
         SerialMessageIdentifier messageId = static_cast<SerialMessageIdentifier>(QString(message[0]).toInt());
@@ -166,7 +166,7 @@ void CSim::checkConnection(Connection *conn)
             qDebug() << "got disconnect from ddm";
 
             //erase existing events to prevent unrecognized messages in next session
-            eventsPtr->freeLinkedLists(true);
+            eventsPtr->freeNodes(true);
 
             break;
 
@@ -267,7 +267,7 @@ void CSim::run()
         Connection *conn(new Connection(portName));
         connPtr = conn;
 
-        if (!connPtr->serialPort.isOpen())
+        if (!connPtr->device->isOpen())
         {
             delete connPtr;
             connPtr = nullptr;
@@ -312,6 +312,13 @@ void CSim::run()
         //loop until told to stop by owner of csim handle
         while (!stop)
         {
+            //load mode replaces the regular generation loop until it is turned off
+            if (loadMode.load(std::memory_order_acquire))
+            {
+                eventId = runLoadMode(conn, eventId);
+                continue;
+            }
+
             #if CSIM_DEBUG
             i++;
             logEmptyLine();
@@ -492,7 +499,7 @@ void CSim::run()
             QCoreApplication::processEvents();
 
             //wait for interval while monitoring serial port
-            conn->serialPort.waitForReadyRead(generationInterval);
+            conn->device->waitForReadyRead(generationInterval);
 
             while (pause){QCoreApplication::processEvents();}
 
@@ -519,6 +526,97 @@ void CSim::run()
     }
 }
 
+//stores the profile, then turns load mode on so csim never starts with an old profile
+void CSim::startLoadMode(const CSimLoadProfile &profile)
+{
+    {
+        QMutexLocker locker(&loadProfileMutex);
+        loadProfile = profile;
+    }
+
+    loadMode.store(true, std::memory_order_release);
+}
+
+//load mode, generates frames from the load profile and sends the frames due each
+//tick in a single write. frames are not stored in messagesSent, at these rates it
+//would grow without bound
+int CSim::runLoadMode(Connection *conn, int eventId)
+{
+    CSimLoadProfile profile;
+    {
+        QMutexLocker locker(&loadProfileMutex);
+        profile = loadProfile;
+    }
+    CSimLoadGenerator generator(profile, secondTrigger, eventId);
+
+    QElapsedTimer timer;
+    timer.start();
+    qint64 lastTick = 0;
+    qint64 dropped = 0;
+
+    //frames owed, accumulated at the profile rate and spent as frames are sent
+    double credit = 0;
+
+    QByteArray batch;
+
+    #if CSIM_DEBUG
+    qDebug() << "[CSIM] Load mode started at " << profile.framesPerSecond << " frames per second";
+    #endif
+
+    while (loadMode.load(std::memory_order_acquire) && !stop)
+    {
+        //reads connection changes from ddm, only once per tick
+        checkConnection(conn);
+
+        qint64 now = timer.elapsed();
+        credit += profile.rateAt(now) * (now - lastTick) / 1000.0;
+        lastTick = now;
+
+        //a stalled port must not turn into an unbounded burst once it recovers
+        if (credit > CSIM_LOAD_MAX_BATCH)
+        {
+            dropped += static_cast<qint64>(credit) - CSIM_LOAD_MAX_BATCH;
+            credit = CSIM_LOAD_MAX_BATCH;
+        }
+
+        int count = static_cast<int>(credit);
+
+        //frames are only generated while the ddm is listening
+        if (conn->connected && count > 0)
+        {
+            batch.clear();
+            generator.appendFrames(batch, count, QDateTime::currentMSecsSinceEpoch() - startupTime);
+            credit -= count;
+
+            if (conn->device->write(batch) != batch.size())
+            {
+                qDebug() << "Error: CSim::runLoadMode failed to write " << count << " frames" << Qt::endl;
+            }
+
+            conn->device->waitForBytesWritten(CSIM_LOAD_TICK_INTERVAL);
+        }
+        else if (!conn->connected)
+        {
+            credit = 0;
+        }
+
+        //check for signals from ddm
+        QCoreApplication::processEvents();
+
+        //wait for the next tick while monitoring serial port
+        conn->device->waitForReadyRead(CSIM_LOAD_TICK_INTERVAL);
+
+        while (pause){QCoreApplication::processEvents();}
+    }
+
+    #if CSIM_DEBUG
+    qDebug() << "[CSIM] Load mode sent " << generator.framesGenerated() << " frames in " << timer.elapsed()
+             << " msec, dropped " << dropped;
+    #endif
+
+    return generator.nextId();
+}
+
 //outputs messages sent this session, can be called via dev tools page
 void CSim::outputMessagesSent()
 {
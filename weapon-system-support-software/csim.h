@@ -2,10 +2,14 @@
 #define CSIM_H
 #if DEV_MODE
 #include <QThread>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <atomic>
 #include "connection.h"
 #include "events.h"
 #include "electrical.h"
 #include "status.h"
+#include "csimload.h"
 #include <QDebug>
 
 // This class simulates the weapon controller, must be called in seperate thread so it doesnt
@@ -43,6 +47,13 @@ public:
     //delay between iterations of csim (in msec)
     int generationInterval;
 
+    //true while csim sends frames as fast as the load profile asks instead of once
+    //per generation interval. turned on by startLoadMode, set false to turn it off
+    std::atomic<bool> loadMode;
+
+    //stores the profile and turns load mode on, safe to call from any thread
+    void startLoadMode(const CSimLoadProfile &profile);
+
     //used for the electrical data dump at beginning of run
     QString electricalDumpMessage;
 
@@ -82,8 +93,17 @@ public slots:
     void logEmptyLine();
 
 private:
+    //profile used by load mode, written by the gui thread and copied by the csim
+    //thread when load mode starts
+    QMutex loadProfileMutex;
+    CSimLoadProfile loadProfile;
+
     //overloaded threading function.
     void run() override;
+
+    //sends frames generated from loadProfile until load mode is turned off or
+    //the thread is stopped, returns the id of the next event
+    int runLoadMode(Connection *conn, int eventId);
 };
 #endif //DEV_MODE
 #endif // CSIM_H
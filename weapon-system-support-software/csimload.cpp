@@ -0,0 +1,292 @@
+#include "csimload.h"
+//this file wont compile if dev mode is inactive
+#if DEV_MODE
+#include "status.h"
+
+/********************************************************************************
+** csimload.cpp
+**
+** This file implements the frames generated by the controller simulator load mode.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Gives the rate of the profile, including bursts
+ *
+ * @param elapsedMs Time since load mode started
+ * @return Frames per second
+ */
+int CSimLoadProfile::rateAt(qint64 elapsedMs) const
+{
+    if (burstPeriodMs > 0 && elapsedMs % burstPeriodMs < burstDurationMs)
+    {
+        return framesPerSecond * burstFactor;
+    }
+
+    return framesPerSecond;
+}
+
+/**
+ * @brief Reads a load profile typed on the dev page
+ *
+ * @param text Words of the form key=value separated by spaces
+ * @param profile Receives the values given, other values are left unchanged
+ * @return False if a word is not a known key with a non negative integer value, or
+ * the profile would send nothing, more than CSIM_LOAD_MAX_FRAMES_PER_SECOND or has a
+ * weight over CSIM_LOAD_MAX_WEIGHT
+ */
+bool CSimLoadProfile::parse(const QString &text, CSimLoadProfile &profile)
+{
+    CSimLoadProfile parsed = profile;
+
+    for (const QString &word : text.split(' ', Qt::SkipEmptyParts))
+    {
+        QString key = word.section('=', 0, 0);
+        bool valid = false;
+        int value = word.section('=', 1).toInt(&valid);
+
+        if (!valid || value < 0)
+        {
+            return false;
+        }
+
+        if (key == "fps") parsed.framesPerSecond = value;
+        else if (key == "status") parsed.statusWeight = value;
+        else if (key == "event") parsed.eventWeight = value;
+        else if (key == "error") parsed.errorWeight = value;
+        else if (key == "clear") parsed.clearWeight = value;
+        else if (key == "electrical") parsed.electricalWeight = value;
+        else if (key == "dump") parsed.dumpWeight = value;
+        else if (key == "dumpSize") parsed.dumpSize = value;
+        else if (key == "burstPeriod") parsed.burstPeriodMs = value;
+        else if (key == "burstDuration") parsed.burstDurationMs = value;
+        else if (key == "burstFactor") parsed.burstFactor = value;
+        else return false;
+    }
+
+    //weights must be in range, and at least one kind of frame must be sent
+    int totalWeight = 0;
+    for (int weight : {parsed.statusWeight, parsed.eventWeight, parsed.errorWeight,
+                       parsed.clearWeight, parsed.electricalWeight, parsed.dumpWeight})
+    {
+        if (weight > CSIM_LOAD_MAX_WEIGHT)
+        {
+            return false;
+        }
+        totalWeight += weight;
+    }
+
+    if (totalWeight == 0)
+    {
+        return false;
+    }
+
+    //the rate must be positive, and stay in range during bursts
+    if (parsed.framesPerSecond < 1 || parsed.framesPerSecond > CSIM_LOAD_MAX_FRAMES_PER_SECOND
+        || parsed.burstFactor < 1 || parsed.burstFactor > CSIM_LOAD_MAX_FRAMES_PER_SECOND / parsed.framesPerSecond)
+    {
+        return false;
+    }
+
+    //a burst must fit in its period
+    if (parsed.burstPeriodMs > 0 && parsed.burstDurationMs > parsed.burstPeriodMs)
+    {
+        return false;
+    }
+
+    //dumps must hold at least one node
+    if (parsed.dumpWeight > 0 && parsed.dumpSize < 1)
+    {
+        return false;
+    }
+
+    profile = parsed;
+    return true;
+}
+
+/**
+ * @brief Constructor, builds the frame templates
+ *
+ * @param profile Traffic to generate
+ * @param secondTrigger True to generate status for 2 triggers
+ * @param firstId Id of the first event or error generated
+ */
+CSimLoadGenerator::CSimLoadGenerator(const CSimLoadProfile &profile, bool secondTrigger, int firstId)
+    : profile(profile), random(QRandomGenerator::global()->generate()), timeStampSize(0), id(firstId), frames(0)
+{
+    int kindWeights[NUM_FRAME_KINDS] = {profile.statusWeight, profile.eventWeight, profile.errorWeight,
+                                        profile.clearWeight, profile.electricalWeight, profile.dumpWeight};
+    int total = 0;
+    for (int kind = 0; kind < NUM_FRAME_KINDS; kind++)
+    {
+        total += kindWeights[kind];
+        weights[kind] = total;
+    }
+
+    //status frames vary, so a set of randomized frames is sent in turn
+    Status status;
+    status.feedPosition = FEEDING;
+    status.firingMode = SAFE;
+    for (int i = 0; i < CSIM_LOAD_STATUS_TEMPLATES; i++)
+    {
+        status.randomize(secondTrigger);
+        statusFrames.append((QString::number(STATUS) + DELIMETER + status.generateMessage()).toUtf8());
+    }
+
+    for (int i = 0; i < NUM_ELECTRICAL_MESSAGES; i++)
+    {
+        electricalFrames.append((QString::number(ELECTRICAL) + DELIMETER + ELECTRICAL_MESSAGES[i] + '\n').toUtf8());
+    }
+
+    for (int i = 0; i < NUM_EVENT_MESSAGES; i++)
+    {
+        eventTexts.append((DELIMETER + EVENT_MESSAGES[i] + DELIMETER).toUtf8());
+    }
+
+    for (int i = 0; i < NUM_ERROR_MESSAGES; i++)
+    {
+        errorTexts.append((DELIMETER + ERROR_MESSAGES[i] + DELIMETER).toUtf8());
+    }
+}
+
+/**
+ * @brief Appends frames to a transmit buffer
+ *
+ * @param out Buffer the frames are appended to
+ * @param count Number of frames to append
+ * @param elapsedMs Time since the controller started, every frame is stamped with it
+ */
+void CSimLoadGenerator::appendFrames(QByteArray &out, int count, qint64 elapsedMs)
+{
+    //frames appended together share a time stamp, so it is only formatted once
+    timeStampSize = qsnprintf(timeStamp, sizeof(timeStamp), "%02lld:%02lld:%02lld:%03lld",
+                              elapsedMs / 3600000, (elapsedMs / 60000) % 60, (elapsedMs / 1000) % 60, elapsedMs % 1000);
+
+    for (int i = 0; i < count; i++)
+    {
+        FrameKind kind = nextKind();
+
+        //there is nothing to clear until an active error is sent
+        if (kind == CLEAR_FRAME && activeErrors.isEmpty())
+        {
+            kind = (profile.errorWeight > 0) ? ERROR_FRAME : EVENT_FRAME;
+        }
+
+        switch (kind)
+        {
+        case STATUS_FRAME:
+            out += statusFrames[frames % statusFrames.size()];
+            break;
+
+        case EVENT_FRAME:
+            appendNumber(out, EVENT);
+            out += ',';
+            appendEventFields(out);
+            out += '\n';
+            break;
+
+        case ERROR_FRAME:
+            appendNumber(out, ERROR);
+            out += ',';
+            appendErrorFields(out);
+            out += '\n';
+            break;
+
+        case CLEAR_FRAME:
+        {
+            //clear a random active error
+            qsizetype pos = random.bounded(activeErrors.size());
+            appendNumber(out, CLEAR_ERROR);
+            out += ',';
+            appendNumber(out, activeErrors[pos]);
+            out += ",\n";
+
+            activeErrors[pos] = activeErrors.last();
+            activeErrors.removeLast();
+            break;
+        }
+
+        case ELECTRICAL_FRAME:
+            out += electricalFrames[random.bounded(electricalFrames.size())];
+            break;
+
+        //dumps alternate between events and errors
+        case DUMP_FRAME:
+        {
+            bool errorDump = frames % 2;
+            appendNumber(out, errorDump ? ERROR_DUMP : EVENT_DUMP);
+            out += ',';
+
+            for (int node = 0; node < profile.dumpSize; node++)
+            {
+                errorDump ? appendErrorFields(out) : appendEventFields(out);
+                out += ',';
+            }
+            out += '\n';
+            break;
+        }
+
+        default:
+            break;
+        }
+
+        frames++;
+    }
+}
+
+CSimLoadGenerator::FrameKind CSimLoadGenerator::nextKind()
+{
+    int pick = random.bounded(weights[NUM_FRAME_KINDS - 1]);
+
+    int kind = 0;
+    while (pick >= weights[kind])
+    {
+        kind++;
+    }
+
+    return static_cast<FrameKind>(kind);
+}
+
+void CSimLoadGenerator::appendEventFields(QByteArray &out)
+{
+    appendNumber(out, id++);
+    out += ',';
+    out.append(timeStamp, timeStampSize);
+    out += eventTexts[random.bounded(eventTexts.size())];
+}
+
+void CSimLoadGenerator::appendErrorFields(QByteArray &out)
+{
+    bool cleared = random.bounded(2);
+
+    //remember active errors so they can be cleared later
+    if (!cleared && activeErrors.size() < CSIM_LOAD_MAX_ACTIVE_ERRORS)
+    {
+        activeErrors.append(id);
+    }
+
+    appendNumber(out, id++);
+    out += ',';
+    out.append(timeStamp, timeStampSize);
+    out += errorTexts[random.bounded(errorTexts.size())];
+    out += cleared ? "1," : "0,";
+}
+
+void CSimLoadGenerator::appendNumber(QByteArray &out, int number)
+{
+    char digits[16];
+    int size = 0;
+
+    do
+    {
+        digits[size++] = static_cast<char>('0' + number % 10);
+        number /= 10;
+    } while (number > 0);
+
+    while (size > 0)
+    {
+        out += digits[--size];
+    }
+}
+#endif
@@ -0,0 +1,105 @@
+#ifndef CSIMLOAD_H
+#define CSIMLOAD_H
+#if DEV_MODE
+#include <QByteArray>
+#include <QRandomGenerator>
+#include <QString>
+#include <QVector>
+#include "constants.h"
+
+/********************************************************************************
+** csimload.h
+**
+** The CSimLoadGenerator class generates the frames sent by the controller simulator
+** in load mode. Frames are picked at random by the weights of a CSimLoadProfile and
+** written straight into a byte buffer from templates built once, so CSim can send
+** thousands of frames per second to stress the DDM ingest path.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Traffic generated in load mode
+ *
+ * Weights are relative, a kind with weight 0 is never sent.
+ */
+struct CSimLoadProfile
+{
+    int framesPerSecond = CSIM_LOAD_FRAMES_PER_SECOND;
+
+    int statusWeight = 1;
+    int eventWeight = 6;
+    int errorWeight = 2;
+    int clearWeight = 1;
+    int electricalWeight = 0;
+    int dumpWeight = 0;
+
+    // nodes in each event or error dump
+    int dumpSize = 100;
+
+    // every burstPeriodMs the rate is multiplied by burstFactor for burstDurationMs,
+    // a period of 0 sends at a steady rate
+    int burstPeriodMs = 0;
+    int burstDurationMs = 0;
+    int burstFactor = 1;
+
+    // frames per second at a time since load mode started
+    int rateAt(qint64 elapsedMs) const;
+
+    // reads a profile from words of the form key=value (fps, status, event, error,
+    // clear, electrical, dump, dumpSize, burstPeriod, burstDuration, burstFactor),
+    // keys that are not given keep their default. returns false on an invalid word
+    // or a profile that can not be sent (i.e. fps=0)
+    static bool parse(const QString &text, CSimLoadProfile &profile);
+};
+
+class CSimLoadGenerator
+{
+public:
+    CSimLoadGenerator(const CSimLoadProfile &profile, bool secondTrigger, int firstId);
+
+    // appends count frames to out, each time stamped elapsedMs since the controller started
+    void appendFrames(QByteArray &out, int count, qint64 elapsedMs);
+
+    // id the next event or error will use
+    int nextId() const { return id; }
+
+    qint64 framesGenerated() const { return frames; }
+
+private:
+    enum FrameKind { STATUS_FRAME, EVENT_FRAME, ERROR_FRAME, CLEAR_FRAME, ELECTRICAL_FRAME, DUMP_FRAME, NUM_FRAME_KINDS };
+
+    // picks the kind of the next frame by the profile weights
+    FrameKind nextKind();
+
+    // event or error fields (id, time stamp, text and cleared status) without the message id
+    void appendEventFields(QByteArray &out);
+    void appendErrorFields(QByteArray &out);
+
+    static void appendNumber(QByteArray &out, int number);
+
+    CSimLoadProfile profile;
+    QRandomGenerator random;
+
+    // cumulative weight of each frame kind
+    int weights[NUM_FRAME_KINDS];
+
+    // frame templates, built once
+    QVector<QByteArray> statusFrames; // whole status frames with randomized values
+    QVector<QByteArray> electricalFrames; // whole electrical frames
+    QVector<QByteArray> eventTexts; // ",<text>," following an event time stamp
+    QVector<QByteArray> errorTexts; // ",<text>," following an error time stamp
+
+    // time stamp of the frames being appended, HH:MM:SS:mmm
+    char timeStamp[32];
+    int timeStampSize;
+
+    // ids of errors sent active, cleared by clear frames
+    QVector<int> activeErrors;
+
+    int id;
+    qint64 frames;
+};
+
+#endif //DEV_MODE
+#endif // CSIMLOAD_H
@@ -107,46 +107,18 @@ void electrical::freeLL()
  */
 bool electrical::loadElecData(QString message)
 {
-    // parse message
-    QStringList values = message.split(DELIMETER);
+    QByteArray serializedMessage = message.toUtf8();
+    ElectricalFrame frame;
 
-    // check for real electrical dump
-    if(values.length()-1 == NUM_ELECTRIC_ELEMENTS)
+    // check for real electrical data
+    if (!MessageDecoder::decodeElectrical(serializedMessage, frame))
     {
-        // get name value from message
-        QString name = values[0];
-        if(name == "")
-        {
-            qDebug() << "Error: loadElecData empty electrical component name"<< Qt::endl;
-            return false;
-        }
-
-        // get voltage value from message
-        double voltage = values[1].toDouble();
-        if(voltage <= -1 || values[1] != "0" && voltage == 0.0)
-        {
-            qDebug() << "Error: loadElecData invalid voltage: " << values[1]<< Qt::endl;
-            return false;
-        }
-
-        // get amp value from message
-        double amps = values[2].toDouble();
-        if(amps <= -1 || values[2] != "0" && amps == 0.0)
-        {
-            qDebug() << "Error: loadElecData invalid amps: " << values[2]<< Qt::endl;
-            return false;
-        }
-
-        // using extracted data, add a node to the end of the electrical linked list
-        addNode(name, voltage, amps);
-        return true;
-    }
-    else
-    {
-        // failed to get real dump
-        qDebug() << "Invalid input to load electrical data: " << message << "\n"<< Qt::endl;
         return false;
     }
+
+    // using decoded data, add a node to the end of the electrical linked list
+    addNode(QString::fromUtf8(frame.name), frame.voltage, frame.amps);
+    return true;
 }
 
 /**
@@ -159,25 +131,27 @@ bool electrical::loadElecData(QString message)
  */
 bool electrical::loadElecDump(QString message)
 {
-    // Split the dump messages into individual error sets
-    QStringList electricalSet = message.split(",,", Qt::SkipEmptyParts);
+    QByteArray serializedMessage = message.toUtf8();
+    QVector<ElectricalFrame> frames;
+
+    // components before an invalid one are still loaded
+    bool successfulDecode = MessageDecoder::decodeElectricalDump(serializedMessage, frames);
+    loadElecDump(frames);
 
-    // Iterate through the electrical sets and call loadElecData for each
-    for (const QString &elec : electricalSet)
+    return successfulDecode;
+}
+
+/**
+ * @brief Adds decoded electrical components to the electrical linked list
+ *
+ * @param frames Components that have already been validated by the message decoder
+ */
+void electrical::loadElecDump(const QVector<ElectricalFrame> &frames)
+{
+    for (const ElectricalFrame &frame : frames)
     {
-        // check for empty
-        if(!electricalSet.isEmpty() && elec != "\n")
-        {
-            // Call loadErrorData for each individual error set, if any errors, return
-            if (!loadElecData(elec))
-            {
-                // return fail
-                return false;
-            }
-        }
+        addNode(QString::fromUtf8(frame.name), frame.voltage, frame.amps);
     }
-    // return success
-    return true;
 }
 
 /**
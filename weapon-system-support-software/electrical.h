@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QDateTime>
 #include "constants.h"
+#include "messagedecoder.h"
 
 /********************************************************************************
 ** electrical.h
@@ -46,6 +47,7 @@ public:
     // loads electrical message(s) into linked lists
     bool loadElecData(QString message);
     bool loadElecDump(QString message);
+    void loadElecDump(const QVector<ElectricalFrame> &frames);
 
     // convert to string
     QString toString();
@@ -4,7 +4,7 @@
 ** events.cpp
 **
 ** This file implements the logic of the events and error variables. This includes
-** creating, updating reading in event/error data into linked lists.
+** creating, updating reading in event/error data into the events store.
 **
 ** @author Team Controller
 ********************************************************************************/
@@ -12,7 +12,7 @@
 /**
  * Initialization constructor for an event/error object.
  *
- * This initializes the parameters into a linked list object
+ * This initializes the parameters into an empty events object
  */
 Events::Events(bool EventRAMClearing, int maxDataNodes)
 {
@@ -26,12 +26,6 @@ Events::Events(bool EventRAMClearing, int maxDataNodes)
     RAMClearing = EventRAMClearing;
     truncated = false;
 
-    headEventNode= nullptr;
-    lastEventNode= nullptr;
-
-    headErrorNode= nullptr;
-    lastErrorNode= nullptr;
-
     int clearedLength = CLEARED_INDICATOR.length();
     int activeLength = ACTIVE_INDICATOR.length();
 
@@ -55,71 +49,32 @@ Events::Events(bool EventRAMClearing, int maxDataNodes)
 /**
  * Deconstructor for the event/error objects
  *
- * This deconstructor calls freeLinkedList, which deletes the event/error nodes
+ * This deconstructor calls freeNodes, which deletes the event/error nodes
  */
 Events::~Events()
 {
     qDebug() << "Deleting event and error data";
-    freeLinkedLists(true);
+    freeNodes(true);
 }
 
 /**
- * Adds a node to the event linked list
- *
- * This takes in below parameters and adds a node with those values.
- * Either creates a single node, or adds to an existing linked list.
+ * Adds an event node to the events store
  *
  * @param id The identification number of an event node
- * @param timeStamp The time that the event node was created
+ * @param timeMs The time that the event node was created, in milliseconds
+ * @param timeStamp The time stamp text timeMs was parsed from, kept for log files
  * @param eventString Event data read into the addEvent function
  */
-void Events::addEvent(int id, QString timeStamp, QString eventString)
+void Events::addEvent(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString)
 {
-    //allocate memory for node
-    EventNode *newNode = new EventNode;
+    //clear RAM before adding, clearing removes every node from the store
+    enforceNodeLimit();
 
-    //assign node values
-    newNode->timeStamp = timeStamp;
-    newNode->eventString = eventString;
-    newNode->nextPtr = nullptr;
-    newNode->id = id;
+    store.append(id, timeMs, timeStamp, eventString, false, false);
 
     //increment counters
     totalNodes++;
     totalEvents++;
-
-    //check if we have exceeded max nodes and if ram clearing is enabled
-    if (RAMClearing && storedNodes > maxNodes)
-    {
-        //free the linked lists
-        freeLinkedLists(false);
-
-        qDebug() << "Events class cleared to reduce RAM usage";
-
-        //notify parent
-        emit RAMCleared();
-
-        //set flag indicating ram dump has occurred
-        truncated = true;
-    }
-
-    //check if linked list is currently empty
-    if (headEventNode == nullptr)
-    {
-        //assign new node as head of list
-        headEventNode = newNode;
-
-        //assign tail ptr
-        lastEventNode = newNode;
-    }
-    //otherwise, ll is not empty
-    else
-    {
-        //append node to list
-        lastEventNode->nextPtr = newNode;
-        lastEventNode = newNode;
-    }
-
     storedNodes++;
 
     #if DEV_MODE && EVENTS_DEBUG
@@ -129,39 +84,44 @@ void Events::addEvent(int id, QString timeStamp, QString eventString)
 }
 
 /**
- * Adds a node to the error linked list
- *
- * This takes in below parameters and adds a node with those values.
- * Either creates a single node, or adds to an existing linked list.
+ * Adds an error node to the events store
  *
  * @param id The identification number of an error node
- * @param timeStamp The time that the error node was created
+ * @param timeMs The time that the error node was created, in milliseconds
+ * @param timeStamp The time stamp text timeMs was parsed from, kept for log files
  * @param eventString Error data read into the addError function
  * @param cleared A boolean that indicates whether or not the error has been cleared
  */
-void Events::addError(int id, QString timeStamp, QString eventString, bool cleared)
+void Events::addError(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString, bool cleared)
 {
-    //allocate memory for node
-    ErrorNode *newNode = new ErrorNode;
+    //clear RAM before adding, clearing removes every node from the store
+    enforceNodeLimit();
 
-    //assign node values
-    newNode->id = id;
-    newNode->timeStamp = timeStamp;
-    newNode->eventString = eventString;
-    newNode->cleared = cleared;
-    newNode->nextPtr = nullptr;
-    newNode->logFileIndicator = UNINITIALIZED;
+    store.append(id, timeMs, timeStamp, eventString, true, cleared);
 
     //increment counters
     totalNodes++;
     totalErrors++;
     if(cleared) totalClearedErrors++;
+    storedNodes++;
+
+    #if DEV_MODE && EVENTS_DEBUG
+   qDebug() << "New error node created. Total nodes: " << totalNodes << " total errors: " <<
+        totalErrors<< " stored nodes: " << storedNodes;
+    #endif
+}
 
+/**
+ * Checks if the node limit has been exceeded, if RAM clearing is enabled the
+ * stored nodes are freed
+ */
+void Events::enforceNodeLimit()
+{
     //check if we have exceeded max nodes and if ram clearing is enabled
     if (RAMClearing && storedNodes > maxNodes)
     {
-        //free the linked lists
-        freeLinkedLists(false);
+        //free the stored nodes
+        freeNodes(false);
 
         qDebug() << "Events class cleared to reduce RAM usage";
 
@@ -171,80 +131,17 @@ void Events::addError(int id, QString timeStamp, QString eventString, bool clear
         //set flag indicating ram dump has occurred
         truncated = true;
     }
-
-    //check if linked list is currently empty
-    if (headErrorNode == nullptr)
-    {
-        //assign new node as head of list
-        headErrorNode = newNode;
-
-        //assign tail ptr
-        lastErrorNode = newNode;
-    }
-    //otherwise, ll is not empty
-    else
-    {
-        //append node to list
-        lastErrorNode->nextPtr = newNode;
-
-        lastErrorNode = newNode;
-    }
-
-    storedNodes++;
-
-    #if DEV_MODE && EVENTS_DEBUG
-   qDebug() << "New error node created. Total nodes: " << totalNodes << " total errors: " <<
-        totalErrors<< " stored nodes: " << storedNodes;
-    #endif
 }
 
 /**
- * Frees the memory allocated the linked lists object
+ * Frees the event and error nodes held in RAM
  *
- * Deletes all nodes associated with both linked lists
+ * The store keeps its buffers, so nodes added afterwards do not reallocate them.
  */
-void Events::freeLinkedLists(bool fullClear)
+void Events::freeNodes(bool fullClear)
 {
-    // Free memory for the event linked list
-    // get ptr to head node
-    EventNode *wkgPtr = headEventNode;
-    EventNode *wkgPtr2;
-
-    // loop through the list
-    while (wkgPtr != nullptr)
-    {
-        // save location of next node
-        wkgPtr2 = wkgPtr->nextPtr;
-
-        // delete current node
-        delete wkgPtr;
-
-        // iterate to next node
-        wkgPtr = wkgPtr2;
-    }
-    // ensure head and tail point to null symbolizing empty list
-    headEventNode = lastEventNode = nullptr;
-
-    // Free memory for the error linked list
-    ErrorNode *wkgErrPtr = headErrorNode;
-    ErrorNode *wkgErrPtr2;
+    store.clear();
 
-    //loop through list
-    while (wkgErrPtr != nullptr)
-    {
-        //save location of next node
-        wkgErrPtr2 = wkgErrPtr->nextPtr;
-
-        //delete current node
-        delete wkgErrPtr;
-
-        //iterate to next node
-        wkgErrPtr = wkgErrPtr2;
-    }
-
-    // ensure head and tail point to null symbolizing empty list
-    headErrorNode = lastErrorNode = nullptr;
-  
     //reset stored nodes
     storedNodes=0;
 
@@ -260,272 +157,431 @@ void Events::freeLinkedLists(bool fullClear)
     }
 
     #if DEV_MODE && EVENTS_DEBUG
-    qDebug() << "Event and error linked lists freed";
+    qDebug() << "Event and error nodes freed";
     #endif
 }
 
+/**
+ * Returns the memory reserved by the events store
+ *
+ * @return Bytes reserved for event and error nodes, including unused capacity
+ */
+qsizetype Events::reservedBytes() const
+{
+    return store.bytesReserved();
+}
+
 /**
  * Attempts to find the error using its id and switches the bool to cleared
- * Both the linked list and the logfile are searched.
- * If error node cannot be found in ll or logfile, the function will return false
+ * Both the events store and the logfile are searched.
+ * If error node cannot be found in the store or logfile, the function will return false
  *
  *@param id The identification number of the error node to be cleared
  *@param the logfile to modify
  */
 int Events::clearError(int id, QString logFileName)
 {
-    //check for invalid format
-    if (id < 0)
+    return clearErrors({id}, logFileName).first();
+}
+
+/**
+ * Clears a burst of errors, opening the log file once for all of them
+ *
+ * @param ids The identification numbers of the errors to be cleared
+ * @param logFileName The logfile to modify
+ * @return Result of each clear, in the same order as ids (same codes as clearError)
+ */
+QVector<int> Events::clearErrors(const QVector<int> &ids, QString logFileName)
+{
+    LogWriter logWriter(nullptr, LOG_WRITER_SYNCHRONOUS);
+    logWriter.setFileName(logFileName);
+
+    return clearErrors(ids, logWriter);
+}
+
+/**
+ * Clears a burst of errors through an open log writer
+ *
+ * Each error's indicator is found through the writer's indicator index and patched
+ * in place, whether or not the error is still in the store (the index survives RAM
+ * clears). Only errors the writer did not write, i.e. the log file came from another
+ * writer, fall back to searching the log file.
+ *
+ * @param ids The identification numbers of the errors to be cleared
+ * @param logWriter Writer of the logfile to modify
+ * @return Result of each clear, in the same order as ids (same codes as clearError)
+ */
+QVector<int> Events::clearErrors(const QVector<int> &ids, LogWriter &logWriter)
+{
+    QVector<int> results(ids.size(), SUCCESS);
+    QVector<qsizetype> manualClears; // positions in ids that require the log file to be searched
+
+    // Open the log file if the writer has not already, check for fail
+    bool logFileOpen = logWriter.isOpen() || logWriter.open(false);
+    if (!logFileOpen)
     {
-        return FAILED_TO_CLEAR;
+        qDebug() << "Error: clearErrors Failed to open log file:" << logWriter.fileName() << Qt::endl;
     }
 
-    //init vars
-    ErrorNode *wkgPtr = headErrorNode;
-    int result=SUCCESS;
-
-    //loop through error linked list
-    while (wkgPtr != nullptr)
+    for (qsizetype i = 0; i < ids.size(); i++)
     {
-        //if id is found update cleared status
-        if (wkgPtr->id == id)
+        int id = ids[i];
+
+        //check for invalid format
+        if (id < 0)
         {
-            // Open the log file, check for fail
-            QFile logFile(logFileName);
-            if (!logFile.open(QIODevice::ReadWrite | QIODevice::Text))
-            {
-                qDebug() << "Error: clearError Failed to open log file:" << logFileName << Qt::endl;
-            }
-            //logfile opened
-            else if (wkgPtr->logFileIndicator > 0)
-            {                
-                //seek to position of the active indicator
-                logFile.seek(wkgPtr->logFileIndicator);
+            results[i] = FAILED_TO_CLEAR;
+            continue;
+        }
 
-                //overwrite indicator with cleared indicator
-                logFile.write(clearedIndicatorBytes);
+        EventRecord error = store.findError(id);
+        qint64 indicatorOffset = logWriter.indicatorOffset(id);
 
-                //clear value of indicator since its already cleared
-                wkgPtr->logFileIndicator = UNINITIALIZED;
+        //logfile opened and indicator location is known, overwrite indicator with cleared indicator
+        if (logFileOpen && indicatorOffset >= 0 && logWriter.overwrite(indicatorOffset, clearedIndicatorBytes))
+        {
+            //remove indicator from the index since its already cleared
+            logWriter.removeIndicator(id);
 
-                #if DEV_MODE && EVENTS_DEBUG
-                qDebug() << "Error " << id << " cleared in log file using preferred method";
-                #endif
+            #if DEV_MODE && EVENTS_DEBUG
+            qDebug() << "Error " << id << " cleared in log file using preferred method";
+            #endif
 
-                logFile.close();
-            }
-            else
+            //error was not found in the events store, this indicates a RAM dump has been made
+            if (error.isNull())
             {
-                logFile.close();
-                qDebug() << "Error: clearError logFileIndicator is invalid, attempting manual clear for error " << id<< Qt::endl;
-
-                //attempt alternate clear method
-                result = clearErrorInLogFile(id, logFileName);
+                results[i] = FAILED_TO_CLEAR_FROM_LL;
+                continue;
             }
+        }
+        //error is not in the log file index or the events store, search the log file for it
+        else if (error.isNull())
+        {
+            manualClears.append(i);
+            continue;
+        }
+        else if (logFileOpen)
+        {
+            qDebug() << "Error: clearErrors indicator location is unknown, attempting manual clear for error " << id<< Qt::endl;
 
-            wkgPtr->cleared = true;
+            //attempt alternate clear method once queued lines are written
+            manualClears.append(i);
+        }
 
-            #if DEV_MODE && EVENTS_DEBUG
-            qDebug() << "Error " << id << " cleared in linked list";
-            #endif
+        qsizetype row = error.row();
 
+        //an error that is cleared twice is only counted once
+        if (!store.isCleared(row))
+        {
+            store.setCleared(row);
             totalClearedErrors++;
-
-            //returns success or failed to clear from logfile
-            return result;
         }
 
-        //iterate to next error node
-        wkgPtr = wkgPtr->nextPtr;
+        #if DEV_MODE && EVENTS_DEBUG
+        qDebug() << "Error " << id << " cleared in events store";
+        #endif
     }
-    //error was not found in linked list and could not be cleared
-    //this could indicate a RAM dump has been made
-    //attempt to find and clear from log file manually
-    if (clearErrorInLogFile(id, logFileName) != SUCCESS)
+
+    //the log file is searched on disk, so it must hold every buffered line
+    if (!manualClears.isEmpty())
     {
-        //we couldnt find the error
-        return FAILED_TO_CLEAR;
+        logWriter.flush();
     }
-    else
+
+    //search the log file for errors that could not be patched in place
+    for (qsizetype i : manualClears)
     {
-        #if DEV_MODE && EVENTS_DEBUG
-        qDebug() << "Error " << id << " cleared in log file using unpreferred method (likely due to RAM clear)";
-        #endif
-        return FAILED_TO_CLEAR_FROM_LL;
+        int result = clearErrorInLogFile(ids[i], logWriter.fileName());
+
+        //returns success or failed to clear from logfile for stored errors
+        if (!store.findError(ids[i]).isNull())
+        {
+            results[i] = result;
+        }
+        //error was not in the events store and we couldnt find it in the log file
+        else if (result != SUCCESS)
+        {
+            results[i] = FAILED_TO_CLEAR;
+        }
+        else
+        {
+            #if DEV_MODE && EVENTS_DEBUG
+            qDebug() << "Error " << ids[i] << " cleared in log file using unpreferred method (likely due to RAM clear)";
+            #endif
+            results[i] = FAILED_TO_CLEAR_FROM_LL;
+        }
     }
+
+    return results;
 }
 
 /**
  * Searches log file for error with given id, attempts to clear
- * and returns result. This method is inefficient and only used
- * when standard clearError fails
+ * and returns result. This method reads the log file up to the error
+ * and is only used for log files that were not written by the log
+ * writer that is clearing the error. Only the indicator is rewritten.
  *
  * @param id The identification number of the error node to be cleared
  * @param the logfile to modify
  */
 int Events::clearErrorInLogFile(int id, QString logFileName)
 {
-    // Open the log file
+    // Open the log file (binary, so positions are byte offsets)
     QFile logFile(logFileName);
-    if (!logFile.open(QIODevice::ReadWrite | QIODevice::Text))
+    if (!logFile.open(QIODevice::ReadWrite))
     {
         qDebug() << "Failed to open log file:" << logFile.errorString();
         return FAILED_TO_CLEAR_FROM_LOGFILE;
     }
 
-    // Read the entire log file into memory
-    QByteArray fileData = logFile.readAll();
-    QString fileContent(fileData);
+    // Find the line we are searching for (format from nodeToString)
+    QByteArray searchString = ("ID: " + QString::number(id) + DELIMETER).toUtf8();
 
-    // Find and replace the line we are searching for
-    QString searchString = "ID: " + QString::number(id) + DELIMETER;
-    int index = fileContent.indexOf(searchString);
-    if (index != -1)
+    while (!logFile.atEnd())
     {
-        // Find the end of the line
-        int endIndex = fileContent.indexOf("\n", index);
-        if (endIndex != -1)
-        {
-            // Extract the line
-            QString line = fileContent.mid(index, endIndex - index + 1);
+        qint64 lineStart = logFile.pos();
+        QByteArray line = logFile.readLine();
 
-            // Replace the substring if found
-            int indicatorIndex = line.indexOf(activeIndicator);
-            if (indicatorIndex != -1)
-            {
-                line.replace(indicatorIndex, activeIndicator.length(), clearedIndicator);
+        if (!line.startsWith(searchString))
+        {
+            continue;
+        }
 
-                // Replace the modified line in the file content
-                fileContent.replace(index, line.length(), line);
-            }
+        // the indicator is the last field of an error line, overwrite it if it is active
+        qsizetype indicatorIndex = line.lastIndexOf(activeIndicatorBytes);
+        if (indicatorIndex != -1)
+        {
+            logFile.seek(lineStart + indicatorIndex);
+            logFile.write(clearedIndicatorBytes);
         }
-    }
 
-    // Clear the file and write the modified content
-    logFile.resize(0);
-    QTextStream out(&logFile);
-    out << fileContent;
+        logFile.close();
+        return SUCCESS;
+    }
 
     // Close the file
     logFile.close();
 
-    return (index != -1) ? SUCCESS : FAILED_TO_CLEAR_FROM_LOGFILE;
+    return FAILED_TO_CLEAR_FROM_LOGFILE;
+}
+
+/**
+ * Creates an events store based on an imported logfile
+ *
+ * If the log file is valid, overwrites the contents of an already
+ * made events with the log file contents. If invalid, dont alter
+ * current events class. The file is parsed on the calling thread,
+ * LogFileLoader loads large files on the thread pool instead.
+ *
+ * @param events pointer to the events object to replace
+ * @param logFileName The name of the log file that will be read in
+ */
+int Events::loadDataFromLogFile(Events *&events, QString logFileName)
+{
+    //init file handle
+    QFile file(logFileName);
+
+    //check if we cant open logfile for reading
+    if ( !file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Error: loadDataFromLogFile could not open log file: " << logFileName<< Qt::endl;
+        return DATA_NOT_FOUND;
+    }
+
+    //map the log file rather than copying it, fall back to reading it if it can not be mapped
+    QByteArray contents;
+    QByteArrayView data;
+    uchar *mapped = (file.size() > 0) ? file.map(0, file.size()) : nullptr;
+
+    if (mapped != nullptr)
+    {
+        data = QByteArrayView(mapped, file.size());
+    }
+    else
+    {
+        contents = file.readAll();
+        data = contents;
+    }
+
+    //parse log file contents
+    QVector<LogFileNode> nodes;
+    QByteArrayView corruptLine;
+
+    if ( !parseLogFile(data, nodes, corruptLine) )
+    {
+        qDebug() << "Error: loadDataFromLogFile, corrupt line: " << corruptLine<< Qt::endl;
+        return INCORRECT_FORMAT;
+    }
+
+    Events *newEvents = new Events(false, 0);
+    newEvents->loadLogFileNodes(nodes);
+
+    //closing the file unmaps it
+    file.close();
+
+    replaceEvents(events, newEvents);
+
+    return SUCCESS;
 }
 
 /**
- * Goes through both linked lists and returns a pointer to the node which
- * has the earliest time stamp
+ * Parses the lines of a log file
+ *
+ * Several threads may parse different parts of a log file at once.
  *
- * @param eventPtr Pointer to the event linked lists
- * @param errorPtr Pointer to the error linked lists
- * @param printErr Boolean determining if an error occured
+ * @param data Log file text, whole lines
+ * @param nodes Receives the node of each line, advanced log file lines are skipped
+ * @param corruptLine Receives the first line that could not be parsed
+ * @return False if a line could not be parsed
  */
-EventNode* Events::getNextNode(EventNode*& eventPtr, ErrorNode*& errorPtr)
+bool Events::parseLogFile(QByteArrayView data, QVector<LogFileNode> &nodes, QByteArrayView &corruptLine)
 {
-    // initialize variables
-    EventNode* nextPtr = nullptr;
+    const QByteArray advancedIndicator = ADVANCED_LOG_FILE_INDICATOR.toUtf8();
+    qsizetype pos = 0;
 
-    // check if both lists have valid ptrs to nodes
-    if (eventPtr != nullptr && errorPtr != nullptr)
+    //loop through log file lines
+    while (pos < data.size())
     {
-        // check if event occurred before error
-        if (errorPtr->timeStamp > eventPtr->timeStamp)
+        qsizetype end = data.indexOf('\n', pos);
+        if (end == -1)
         {
-            // choose this event to print
-            nextPtr = eventPtr;
-            eventPtr = eventPtr->nextPtr;
+            end = data.size();
         }
-        //check if error occurred first
-        else if (errorPtr->timeStamp < eventPtr->timeStamp)
+
+        QByteArrayView line = data.sliced(pos, end - pos);
+        pos = end + 1;
+
+        //files written on windows end lines with \r\n
+        if (line.endsWith('\r'))
         {
-            // choose this error to print
-            nextPtr = errorPtr;
-            errorPtr = errorPtr->nextPtr;
+            line.chop(1);
         }
-        //otherwise they occurred at the same time
-        else
+
+        //check for advanced log file line
+        if (line.startsWith(advancedIndicator))
         {
-            //select node with lowest id
-            if (eventPtr->id < errorPtr->id)
-            {
-                nextPtr = eventPtr;
-                eventPtr = eventPtr->nextPtr;
-            }
-            else
-            {
-                nextPtr = errorPtr;
-                errorPtr= errorPtr->nextPtr;
-            }
+            continue;
         }
-    }
-    // check for only events
-    else if (eventPtr != nullptr)
-    {
-        // choose this event to print
-        nextPtr = eventPtr;
-        eventPtr = eventPtr->nextPtr;
-    }
-    // otherwise there are only errors
-    else
-    {
-        // choose this err to print
-        nextPtr = errorPtr;
-        errorPtr = errorPtr->nextPtr;
+
+        LogFileNode node;
+        if ( !parseLogFileLine(line, node) )
+        {
+            corruptLine = line;
+            return false;
+        }
+        nodes.append(std::move(node));
     }
 
-    // return next ptr
-    return nextPtr;
+    return true;
 }
 
 /**
- * Creates linked lists based on an imported logfile
+ * Parses a log file line of the format generated by nodeToString()
  *
- * If the log file is valid, overwrites the contents of an already
- * made events with the log file contents. If invalid, dont alter
- * current events class.
+ * Reads the line in place, only the event string is copied.
  *
- * @param events pointer to the event linked list
- * @param logFileName The name of the log file that will be read in
+ * @param line The log file line, without its line end
+ * @param node Receives the event or error of the line
+ * @return False if the line is invalid
  */
-int Events::loadDataFromLogFile(Events *&events, QString logFileName)
+bool Events::parseLogFileLine(QByteArrayView line, LogFileNode &node)
 {
-    //init file handle
-    QFile file(logFileName);
+    //cleared status as written by nodeToString, without padding
+    static const QByteArray clearedStatus = CLEARED_INDICATOR.trimmed().toUtf8();
+    static const QByteArray activeStatus = ACTIVE_INDICATOR.trimmed().toUtf8();
 
-    //check if we cant open logfile for reading
-    if ( !file.open(QIODevice::ReadOnly | QIODevice::Text ))
+    //split the line using delimeter, parts past the cleared status are ignored
+    QByteArrayView parts[4];
+    const char delimeter = DELIMETER.at(0).toLatin1();
+    qsizetype numParts = 0;
+    qsizetype start = 0;
+
+    while (numParts < 4)
     {
-        qDebug() << "Error: loadDataFromLogFile could not open log file: " << logFileName<< Qt::endl;
-        return DATA_NOT_FOUND;
+        qsizetype end = line.indexOf(delimeter, start);
+        if (end == -1)
+        {
+            parts[numParts++] = line.sliced(start);
+            break;
+        }
+
+        parts[numParts++] = line.sliced(start, end - start);
+        start = end + 1;
     }
 
-    //get log file contents
-    QTextStream in(&file);
-    Events *newEvents = new Events(false, 0);
-    QString currentLine;
+    //ensure the line has at least 3 parts
+    if (numParts < 3)
+    {
+        return false;
+    }
 
-    //loop through log file contents
-    while( !in.atEnd() )
+    //extract ID
+    bool conversionOk = false;
+    node.id = parts[0].sliced(parts[0].indexOf(' ') + 1).toInt(&conversionOk);
+    if (!conversionOk)
     {
-        currentLine = in.readLine();
+        return false;
+    }
 
-        //check for advanced log file line
-        if (currentLine.startsWith(ADVANCED_LOG_FILE_INDICATOR))
+    //extract time stamp
+    node.timeStamp = parts[1].trimmed();
+    if (!MessageDecoder::parseTimeStamp(node.timeStamp, node.timeMs))
+    {
+        return false;
+    }
+
+    //extract event string
+    node.eventString = QString::fromUtf8(parts[2].trimmed());
+    node.isError = numParts > 3;
+    node.cleared = false;
+
+    //check for error node
+    if (node.isError)
+    {
+        QByteArrayView status = parts[3].trimmed();
+
+        if (status == clearedStatus)
         {
-            //do nothing
+            node.cleared = true;
         }
-        //otherwise attempt to load current node, return if fail
-        else if ( !newEvents->stringToNode(currentLine) )
+        else if (status != activeStatus)
         {
-            delete newEvents;
-            file.close();
-            qDebug() << "Error: loadDataFromLogFile, corrupt line: " << currentLine<< Qt::endl;
-            return INCORRECT_FORMAT;
+            return false;
         }
     }
 
-    file.close();
+    return true;
+}
 
+/**
+ * Adds nodes read from a log file, in order
+ *
+ * @param nodes Nodes parsed by parseLogFile, the log file text they were parsed from
+ * must still be in memory
+ */
+void Events::loadLogFileNodes(const QVector<LogFileNode> &nodes)
+{
+    for (const LogFileNode &node : nodes)
+    {
+        if (node.isError)
+        {
+            addError(node.id, node.timeMs, node.timeStamp, node.eventString, node.cleared);
+        }
+        else
+        {
+            addEvent(node.id, node.timeMs, node.timeStamp, node.eventString);
+        }
+    }
+}
+
+/**
+ * Replaces an events object with one loaded from a log file
+ *
+ * @param events pointer to the events object to replace, it is deleted
+ * @param newEvents The loaded events
+ */
+void Events::replaceEvents(Events *&events, Events *newEvents)
+{
     //transfer ram clearing settings to new class in case user starts a new session
     newEvents->RAMClearing = events->RAMClearing;
     newEvents->maxNodes = events->maxNodes;
@@ -539,8 +595,6 @@ int Events::loadDataFromLogFile(Events *&events, QString logFileName)
     #if DEV_MODE && EVENTS_DEBUG
     qDebug() << "New events class allocated for loaded data";
     #endif
-
-    return SUCCESS;
 }
 
 /**
@@ -565,7 +619,8 @@ bool Events::stringToNode(QString nodeString)
 
     //declare vars
     int id;
-    QString timeStamp;
+    qint64 timeMs;
+    QByteArray timeStamp;
     QString eventStr;
     bool conversionError = false;
     bool cleared;
@@ -581,8 +636,13 @@ bool Events::stringToNode(QString nodeString)
         return false;
     }
 
-    //extract time stamp
-    timeStamp = parts[1].trimmed();
+    //extract time stamp, checking for an invalid time stamp
+    timeStamp = parts[1].trimmed().toUtf8();
+    if (!MessageDecoder::parseTimeStamp(timeStamp, timeMs))
+    {
+        qDebug() << "Error: stringToNode time stamp conversion error: " << nodeString<< Qt::endl;
+        return false;
+    }
 
     //extract event string
     eventStr = parts[2].trimmed();
@@ -607,12 +667,12 @@ bool Events::stringToNode(QString nodeString)
             return false;
         }
 
-        addError(id, timeStamp, eventStr, cleared);
+        addError(id, timeMs, timeStamp, eventStr, cleared);
     }
     //otherwise this is an event
     else
     {
-        addEvent(id, timeStamp, eventStr);
+        addEvent(id, timeMs, timeStamp, eventStr);
     }
 
     //return success
@@ -630,60 +690,53 @@ bool Events::stringToNode(QString nodeString)
  */
 bool Events::outputToLogFile(QString logFileName, bool advancedLogFile)
 {
-    // Retrieve given file
-    QFile file(logFileName);
-    if (!file.open(QIODevice::ReadWrite | QIODevice::Text))
+    LogWriter logWriter(nullptr, LOG_WRITER_SYNCHRONOUS);
+    logWriter.setFileName(logFileName);
+
+    return outputToLogFile(logWriter, advancedLogFile) && logWriter.flush();
+}
+
+/**
+ * Outputs event/error data to the log file of a log writer
+ *
+ * The writer's file is cleared of its existing contents and left open, so
+ * following lines can be appended through the same writer. Lines are written
+ * by the writer's thread, flush the writer to wait for them
+ *
+ * @param logWriter Writer of the logfile to write to
+ * @param advancedLogFile setting which toggles verbose log file outputs
+ */
+bool Events::outputToLogFile(LogWriter &logWriter, bool advancedLogFile)
+{
+    //clear file of existing contents
+    if (!logWriter.open(true))
     {
-        qDebug() << "Error: outputToLogFile could not open " << logFileName << " for writing: " << file.errorString()<< Qt::endl;
+        qDebug() << "Error: outputToLogFile could not open " << logWriter.fileName() << " for writing"<< Qt::endl;
         return false;
     }
 
-    //clear file of existing contents
-    file.resize(0);
-
-    // Create a QTextStream for writing to the file
-    QTextStream out(&file);
-
-    // Initialize vars for looping through events class
-    EventNode *nextPrintPtr;
-    ErrorNode *errPtr = headErrorNode;
-    EventNode *eventPtr = headEventNode;
-
     // Display advanced log file value
     if (advancedLogFile)
     {
-        out << ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE ENABLED" << Qt::endl;
+        logWriter.writeLine((ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE ENABLED").toUtf8());
     }
     else
     {
-        out << ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE DISABLED" << Qt::endl;
+        logWriter.writeLine((ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE DISABLED").toUtf8());
     }
 
     //display if the data is truncated
     if (truncated)
     {
-        out << ADVANCED_LOG_FILE_INDICATOR + "This log file is truncated, view the auto save log file for the complete data set." << Qt::endl;
+        logWriter.writeLine((ADVANCED_LOG_FILE_INDICATOR + "This log file is truncated, view the auto save log file for the complete data set.").toUtf8());
     }
 
-    // Loop through the events struct to print all nodes in order
-    while (errPtr != nullptr || eventPtr != nullptr)
+    // Loop through the events store to print all nodes in order
+    for (EventRecord node : store.rows(ALL))
     {
-        // Get next node to print
-        nextPrintPtr = getNextNode(eventPtr, errPtr);
-
-        // Print node to log file
-        out << nodeToString(nextPrintPtr) << Qt::endl;
-
-        if (nextPrintPtr->isError())
-        {
-            //update the file obj with changes made to this point
-            out.flush();
-
-            nextPrintPtr->storeIndicatorLoc(file.size() - (activeIndicatorBytes.size()+NEW_LINE_SIZE));
-        }
+        appendToLogfile(logWriter, node);
     }
 
-    file.close();
     #if DEV_MODE && EVENTS_DEBUG
     qDebug() << "Output to log file complete";
     #endif
@@ -699,53 +752,28 @@ bool Events::outputToLogFile(QString logFileName, bool advancedLogFile)
  */
 bool Events::loadErrorData(QString message)
 {
-    // parse message
-    QStringList values = message.split(DELIMETER);
+    QByteArray serializedMessage = message.toUtf8();
+    ErrorFrame frame;
 
     // check for real error (allows new line at the end or no new line at the end)
-    if(values.length()-1 == NUM_ERROR_ELEMENTS || values.length() == NUM_ERROR_ELEMENTS)
+    if (!MessageDecoder::decodeError(serializedMessage, frame))
     {
-        // get values and check for validity
-        int id = values[0].toInt();
-        if(id <= -1)
-        {
-            qDebug() << "Error: loadErrorData invalid id: " << values[0]<< Qt::endl;
-            return false;
-        }
-
-        QString timeStamp = values[1];
-        QStringList timeValues = timeStamp.split(':');
-
-        if (timeValues.length() != 4)
-        {
-            qDebug() << "Error: loadErrorData invalid time stamp: " << timeStamp<< Qt::endl;
-            return false;
-        }
-        if(timeValues[0].toInt() <= -1 || timeValues[1].toInt() <= -1
-            || timeValues[2].toInt() <= -1 || timeValues[3].toInt()<= -1)
-        {
-            qDebug()<< "Error: loadErrorData invalid time stamp: " << timeStamp<< Qt::endl;
-            return false;
-        }
-
-        QString eventString = values[2];
-        if(eventString == "")
-        {
-            qDebug()<< "Error: loadErrorData empty event string"<< Qt::endl;
-            return false;
-        }
-
-        bool cleared = (values[3] == "1");
-
-        //using extracted data, add an error to the end of the error linked list
-        addError(id, timeStamp, eventString, cleared);
-        return true;
-    }
-    else
-    {
-        qDebug()<< "Error: Invalid input to load error data: " << message << Qt::endl;
         return false;
     }
+
+    loadErrorData(frame);
+    return true;
+}
+
+/**
+ * Creates a new error node from a decoded error message
+ *
+ * @param frame Error data that has already been validated by the message decoder
+ */
+void Events::loadErrorData(const ErrorFrame &frame)
+{
+    //using decoded data, add an error to the events store
+    addError(frame.id, frame.timeMs, frame.timeStamp, QString::fromUtf8(frame.eventString), frame.cleared);
 }
 
 /**
@@ -758,54 +786,32 @@ bool Events::loadErrorData(QString message)
  */
 bool Events::loadEventData(QString message)
 {
-    // parse data
-    QStringList values = message.split(DELIMETER);
+    QByteArray serializedMessage = message.toUtf8();
+    EventFrame frame;
 
     // check for real event (allows new line at the end or no new line at the end)
-    if(values.length()-1 == NUM_EVENT_ELEMENTS || values.length() == NUM_EVENT_ELEMENTS)
-    {
-        // get values and check for validity
-        int id = values[0].toInt();
-        if(id <= -1)
-        {
-            qDebug()<< "Error: loadEventData invalid id: " << values[0]<< Qt::endl;
-            return false;
-        }
-
-        QString timeStamp = values[1];
-        QStringList timeValues = timeStamp.split(':');
-        if (timeValues.length() != 4)
-        {
-            qDebug()<< "Error: loadEventData invalid time stamp: " << timeStamp << Qt::endl;
-            return false;
-        }
-        else if (timeValues[0].toInt() <= -1 || timeValues[1].toInt() <= -1
-            || timeValues[2].toInt() <= -1 || timeValues[3].toInt()<= -1)
-        {
-            qDebug() << "Error: loadEventData invalid time stamp: " << timeStamp << Qt::endl;
-            return false;
-        }
-
-        QString eventString = values[2];
-        if(eventString == "")
-        {
-            qDebug()<< "Error: loadEventData empty event string"<< Qt::endl;
-            return false;
-        }
-
-        // using extracted data add a new event to the end of the events linked list
-        addEvent( id, timeStamp, eventString);
-        return true;
-    }
-    else
+    if (!MessageDecoder::decodeEvent(serializedMessage, frame))
     {
-        qDebug()<< "Error: Invalid input to load event data: " << message << Qt::endl;
         return false;
     }
+
+    loadEventData(frame);
+    return true;
+}
+
+/**
+ * Creates an event node from a decoded event message
+ *
+ * @param frame Event data that has already been validated by the message decoder
+ */
+void Events::loadEventData(const EventFrame &frame)
+{
+    // using decoded data add a new event to the events store
+    addEvent(frame.id, frame.timeMs, frame.timeStamp, QString::fromUtf8(frame.eventString));
 }
 
 /**
- * Creates linked lists based on a dump message (multiple errors)
+ * Creates nodes based on a dump message (multiple errors)
  *
  * If dump message is valid, it parses through and creates
  * error objects
@@ -814,46 +820,40 @@ bool Events::loadEventData(QString message)
  */
 bool Events::loadErrorDump(QString message)
 {
-    bool successfulLoad = true;
+    QByteArray serializedMessage = message.toUtf8();
+    QVector<ErrorFrame> frames;
+
+    // valid errors are loaded even if others in the dump fail
+    bool successfulLoad = MessageDecoder::decodeErrorDump(serializedMessage, frames);
+    loadErrorDump(frames);
 
+    return successfulLoad;
+}
+
+/**
+ * Creates nodes based on decoded error dump entries
+ *
+ * @param frames Errors that have already been validated by the message decoder
+ */
+void Events::loadErrorDump(const QVector<ErrorFrame> &frames)
+{
     //temporarily disable ram clearing
     bool prevRAMClearing = RAMClearing;
     RAMClearing = false;
 
-    // Split the dump messages into individual error sets
-    QStringList errorSet = message.split(",,", Qt::SkipEmptyParts);
-
     #if DEV_MODE && EVENTS_DEBUG
-    qDebug() << "num errors in error dump: " << errorSet.length();
-    qDebug() << "Error dump: " << errorSet;
+    qDebug() << "num errors in error dump: " << frames.length();
     #endif
 
-    //check for empty dump
-    if (errorSet[0] =="\n")
-    {
-        RAMClearing = prevRAMClearing;
-        return false;
-    }
-
-    // Iterate through the error sets and call loadErrorData for each
-    for (const QString &error : errorSet)
+    for (const ErrorFrame &frame : frames)
     {
-        // check for empty
-        if(!errorSet.isEmpty() && error != "\n")
-        {
-            // Call loadErrorData for each individual error set, check if fail
-            if ( !loadErrorData(error) )
-            {
-                successfulLoad = false;
-            }
-        }
+        loadErrorData(frame);
     }
     RAMClearing = prevRAMClearing;
-    return successfulLoad;
 }
 
 /**
- * Creates linked lists based on a dump message (multiple events)
+ * Creates nodes based on a dump message (multiple events)
  *
  * If dump message is valid, it parses through and creates
  * events objects
@@ -862,42 +862,36 @@ bool Events::loadErrorDump(QString message)
  */
 bool Events::loadEventDump(QString message)
 {
-    bool successfulLoad = true;
+    QByteArray serializedMessage = message.toUtf8();
+    QVector<EventFrame> frames;
+
+    // valid events are loaded even if others in the dump fail
+    bool successfulLoad = MessageDecoder::decodeEventDump(serializedMessage, frames);
+    loadEventDump(frames);
+
+    return successfulLoad;
+}
 
+/**
+ * Creates nodes based on decoded event dump entries
+ *
+ * @param frames Events that have already been validated by the message decoder
+ */
+void Events::loadEventDump(const QVector<EventFrame> &frames)
+{
     //temporarily disable ram clearing
     bool prevRAMClearing = RAMClearing;
     RAMClearing = false;
 
-    // Split the dump messages into individual event sets
-    QStringList eventSet = message.split(",,", Qt::SkipEmptyParts);
-
     #if DEV_MODE && EVENTS_DEBUG
-    qDebug() << "num events in event dump" << eventSet.length();
-    qDebug() << "Event dump: " << eventSet;
+    qDebug() << "num events in event dump" << frames.length();
     #endif
 
-    //check for empty dump
-    if (eventSet[0] =="\n")
+    for (const EventFrame &frame : frames)
     {
-        RAMClearing = prevRAMClearing;
-        return false;
-    }
-
-    // Iterate through the event sets and call loadEventData for each
-    for (const QString &event : eventSet)
-    {
-        // check for empty
-        if(!eventSet.isEmpty() && event != "\n")
-        {
-            // Call loadEventData for each individual event set, check if fail
-            if (!loadEventData(event))
-            {
-                successfulLoad = false;
-            }
-        }
+        loadEventData(frame);
     }
     RAMClearing = prevRAMClearing;
-    return successfulLoad;
 }
 
 /**
@@ -906,34 +900,42 @@ bool Events::loadEventDump(QString message)
  * Given a log file path, append event/error data to the end of a log file
  *
  * @param logfilePath Path of the log file to append to
- * @param *event The event/error node to be appended
+ * @param event The event/error node to be appended
  */
-void Events::appendToLogfile(QString logfilePath, EventNode *event)
+void Events::appendToLogfile(QString logfilePath, EventRecord event)
 {
-    //retreive the given file
-    QFile file(logfilePath);
+    LogWriter logWriter(nullptr, LOG_WRITER_SYNCHRONOUS);
+    logWriter.setFileName(logfilePath);
 
-    //attempt to open in append mode
-    if (!file.open(QIODevice::Append | QIODevice::Text))
+    appendToLogfile(logWriter, event);
+}
+
+/**
+ * Appends event/error data through a log writer
+ *
+ * The location of an active error's indicator is known from the writer's offset,
+ * so the line does not have to be written to the file before it is stored
+ *
+ * @param logWriter Writer of the log file to append to
+ * @param event The event/error node to be appended
+ */
+void Events::appendToLogfile(LogWriter &logWriter, EventRecord event)
+{
+    QByteArray line = nodeToString(event).toUtf8();
+
+    //append the node to the log file
+    qint64 offset = logWriter.writeLine(line);
+    if (offset < 0)
     {
-        qDebug()<<  "Error: appendToLogfile could not open log file for appending: " << logfilePath << Qt::endl;
+        qDebug()<<  "Error: appendToLogfile could not open log file for appending: " << logWriter.fileName() << Qt::endl;
         return;
     }
 
-    //append the node to the log file
-    QTextStream out(&file);
-    out << nodeToString(event) << Qt::endl;
-
-    if (event->isError())
+    //index the location of an active error's indicator so it can be cleared in place
+    if (event.isError() && !event.isCleared())
     {
-        //update the file obj with changes made to this point
-        out.flush();
-
-        event->storeIndicatorLoc(file.size() - (activeIndicatorBytes.size()+NEW_LINE_SIZE));
+        logWriter.indexIndicator(event.id(), offset + line.size() - activeIndicatorBytes.size());
     }
-
-    //close the file
-    file.close();
 }
 
 /**
@@ -942,23 +944,23 @@ void Events::appendToLogfile(QString logfilePath, EventNode *event)
  * Given a valid node, construct a string to be displayed on GUI
  *
  * Note: changes here will require equivalent changes to the Events::clearError
- * and void MainWindow::clearErrorFromEventsOutput functions
+ * function
  *
- * @param *event Event/error Node to be translated to a string
+ * @param event Event/error Node to be translated to a string
  */
-QString Events::nodeToString(EventNode *event)
+QString Events::nodeToString(EventRecord event)
 {
     QString nodeString;
 
     // construct string (changes here must be made to clearErrorInLogFile as well)
-    nodeString = "ID: " + QString::number(event->id) + DELIMETER + " " + event->timeStamp + DELIMETER
-                 + " " + event->eventString;
+    nodeString = "ID: " + QString::number(event.id()) + DELIMETER + " " + event.timeStamp() + DELIMETER
+                 + " " + event.eventString();
 
     // Check if chosen node is an error node
-    if (event->isError())
+    if (event.isError())
     {
         // Print cleared status
-        nodeString += (static_cast<ErrorNode*>(event)->cleared ? DELIMETER + " " + clearedIndicator : DELIMETER + " " + activeIndicator);
+        nodeString += (event.isCleared() ? DELIMETER + " " + clearedIndicator : DELIMETER + " " + activeIndicator);
     }
 
     return nodeString;
@@ -972,7 +974,7 @@ QString Events::nodeToString(EventNode *event)
 //begining of message to tell ddm if it is an error or event
 
 //not currently operational
-QString Events::generateNodeMessage(EventNode *event)
+QString Events::generateNodeMessage(EventRecord event)
 {
     /*the message will format data in this order
     int id;
@@ -983,71 +985,53 @@ QString Events::generateNodeMessage(EventNode *event)
     double param3;
     bool cleared;*/
 
-    QString message = QString::number(event->id) + DELIMETER;
+    QString message = QString::number(event.id()) + DELIMETER;
 
-    message += event->timeStamp + DELIMETER;
+    message += event.timeStamp() + DELIMETER;
 
-    message += event->eventString + DELIMETER;
+    message += event.eventString() + DELIMETER;
 
     //message += QString::number(event->cleared) + DELIMETER;
 
     return message + '\n';
 }
 
-//retrieves the error in position i in the linked list
+//retrieves the error in position i of the stored errors
 int Events::getErrorIdByPosition(int pos)
 {
-    ErrorNode *wkgPtr = headErrorNode;
-    int i = 0;
-
-    //loop until we reach the position, or ll ends
-    while(i != pos && wkgPtr != nullptr)
+    //check if position is within the stored errors
+    if (pos >= 0 && pos < store.errorCount())
     {
-        //get next error
-        wkgPtr = wkgPtr->nextPtr;
-        i++;
-    }
-
-    //check if we got to correct position
-    if (i == pos)
-    {
-        return wkgPtr->id;
+        return store.error(pos).id();
     }
 
     //otherwise data not found
     return DATA_NOT_FOUND;
 }
 
-void Events::displayErrorLL()
+void Events::displayErrors()
 {
-    ErrorNode *wkgPtr = headErrorNode;
-
-    qDebug() << "====Printing Error Linked List ====";
+    qDebug() << "====Printing Stored Errors ====";
     qDebug() << "Total Errors " << totalErrors;
 
-    while (wkgPtr != nullptr)
+    for (EventRecord error : store.rows(ERRORS))
     {
-        qDebug() << "Error " << wkgPtr->id << wkgPtr->eventString << wkgPtr->cleared;
-
-        wkgPtr = wkgPtr->nextPtr;
+        qDebug() << "Error " << error.id() << error.eventString() << error.isCleared();
     }
 
     qDebug() << "===================================";
 }
 
-//given the head to either the error linked list or the event linked list, a message will be created containing
-//data from all nodes in the list (data dump is used when the controller has been running prior to the ddm being connected
+//given either the errors or events kind, a message will be created containing data from all stored
+//nodes of that kind (data dump is used when the controller has been running prior to the ddm being connected
 //the data dump will catch the ddm up to any events and errors that have occured before connection)
-QString Events::generateDataDump(EventNode *headPtr)
+QString Events::generateDataDump(EventFilter kind)
 {
     QString message = "";
-    EventNode *wkgPtr = headPtr;
 
-    while (wkgPtr != nullptr)
+    for (EventRecord node : store.rows(kind))
     {
-        message += generateNodeMessage(wkgPtr);
-
-        wkgPtr = wkgPtr->nextPtr;
+        message += generateNodeMessage(node);
     }
 
     //add new line for data parsing and return
@@ -1055,74 +1039,28 @@ QString Events::generateDataDump(EventNode *headPtr)
 }
 
 /**
- * CSim function: searches for an error by id and removes it from the linked list
+ * CSim function: searches for an error by id and removes it from the events store
  *
  * @param id The identification number of the error to be removed
  */
 void Events::freeError(int id)
 {
-    ErrorNode *wkgPtr = headErrorNode;
+    EventRecord error = store.findError(id);
 
-    //check if this error is head node
-    if (headErrorNode->id == id)
+    //check if no node with given id was found
+    if (error.isNull())
     {
-        //assign new head
-        headErrorNode = headErrorNode->nextPtr;
-
-        //free old head
-        free(wkgPtr);
-
-        //decriment total errors
-        totalErrors--;
-
+        qDebug() << "[CSIM] No node with id " << id << " was found, no deletions made";
         return;
     }
 
-    //head node is not the error we need to delete, get next
-    wkgPtr = wkgPtr->nextPtr;
-
-    //assign wkgPtr2 to trail wkgPtr
-    ErrorNode *wkgPtr2 = headErrorNode;
-
-    //loop until list ends
-    while (wkgPtr != nullptr)
-    {
-        //check if current node is to be freed
-        if (wkgPtr->id == id)
-        {
-            //link list around deleted node
-            wkgPtr2->nextPtr = wkgPtr->nextPtr;
-
-            //check if the deleted node is the last node in list
-            if (wkgPtr->nextPtr == nullptr)
-            {
-                //update last node ptr
-                lastErrorNode = wkgPtr2;
-            }
-
-            // update total cleared (error does not exist, therefore it can not be cleared)
-            if(wkgPtr->cleared) totalClearedErrors--;
-
-            //delete the node
-            free(wkgPtr);
+    // update total cleared (error does not exist, therefore it can not be cleared)
+    if(error.isCleared()) totalClearedErrors--;
 
-            //update total errors
-            totalErrors--;
-
-            //return success
-            return;
-        }
-        //otherwise, get next node
-        else
-        {
-            //update trailing ptr
-            wkgPtr2 = wkgPtr;
-            //get next node
-            wkgPtr = wkgPtr->nextPtr;
-        }
-    }
+    //remove the error
+    store.removeError(error.row());
 
-    //no node with given id was found
-    qDebug() << "[CSIM] No node with id " << id << " was found, no deletions made";
+    //update total errors
+    totalErrors--;
 }
 #endif
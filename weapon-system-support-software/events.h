@@ -8,39 +8,21 @@
 #include <QFileInfo>
 #include <QSettings>
 #include "constants.h"
+#include "messagedecoder.h"
+#include "eventstore.h"
+#include "logwriter.h"
 
 /**
- * @brief The EventNode linked list
- * Stores significant information about an EVENT message that has been received from the
- * controller.
+ * @brief An event or error read from a log file line
  */
-struct EventNode
+struct LogFileNode
 {
-
-    int id; // id is a unique identifier for this specific node, it could be any number
-    QString timeStamp; // the timestamp from the controller of when this message was received
-    QString eventString; // the actual string message from the controller
-    struct EventNode *nextPtr; // pointer to next node in linked list
-
-    virtual bool isError() const { return false; }
-    virtual void storeIndicatorLoc(qint64 loc) {}
-};
-
-/**
- * @brief The ErrorNode linked list
- * Stores significant information about an ERROR message that has been received from the
- * controller.
- *
- * NOTE: This struct inherits all member variables from the EventNode defined above
- */
-struct ErrorNode : public EventNode
-{
-    bool cleared; // status of whether or not this error has been cleared yet
-    qint64 logFileIndicator; // location of where this error is stored in the logfile
-    struct ErrorNode *nextPtr; // pointer to next node in linked list
-
-    bool isError() const override { return true; }
-    void storeIndicatorLoc(qint64 loc) override {if(!cleared) logFileIndicator=loc;}
+    int id;
+    qint64 timeMs;
+    QByteArrayView timeStamp; // text timeMs was parsed from, a view into the log file text
+    QString eventString;
+    bool isError;
+    bool cleared;
 };
 
 class Events : public QObject
@@ -52,8 +34,11 @@ private:
      * Therefore, they should not be used outside of the Events data structure
      */
     // node creation helper methods
-    void addEvent(int id, QString timeStamp, QString eventString);
-    void addError(int id, QString timeStamp, QString eventString, bool cleared);
+    void addEvent(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString);
+    void addError(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString, bool cleared);
+
+    // checks if the node limit has been reached and clears RAM if enabled
+    void enforceNodeLimit();
 public:
     // initialization constructor
     Events(bool EventRAMClearing, int maxDataNodes);
@@ -72,30 +57,39 @@ public:
     QString activeIndicator; // the string indicator for active error messages (default ACTIVE in constants.h)
     QByteArray clearedIndicatorBytes; // the cleared indicator converted to bytes for logfile usage
     QByteArray activeIndicatorBytes; // the active indicator converted to bytes for logfile usage
-    EventNode *headEventNode; // stores the top node in the Events linked list
-    EventNode *lastEventNode; // stores the bottom node in the EVents linked list
-    ErrorNode *headErrorNode; // stores the top node in the Errors linked list
-    ErrorNode *lastErrorNode; // stores the bottom node in the Errors linked list
+    EventStore store; // stores every event and error node currently held in RAM
 
     // free memory utils
     void freeError(int id);
-    void freeLinkedLists(bool fullClear);
-
-    // navigation utils
-    EventNode* getNextNode(EventNode*& eventPtr, ErrorNode*& errorPtr);
+    void freeNodes(bool fullClear);
+    qsizetype reservedBytes() const;
 
     // load from serial message utils
     bool loadErrorData(QString message);
     bool loadEventData(QString message);
     bool loadEventDump(QString message);
     bool loadErrorDump(QString message);
+
+    // load from decoded serial message utils
+    void loadErrorData(const ErrorFrame &frame);
+    void loadEventData(const EventFrame &frame);
+    void loadEventDump(const QVector<EventFrame> &frames);
+    void loadErrorDump(const QVector<ErrorFrame> &frames);
     int clearError(int id, QString logFileName);
+    QVector<int> clearErrors(const QVector<int> &ids, QString logFileName);
+    QVector<int> clearErrors(const QVector<int> &ids, LogWriter &logWriter);
 
     // log file utils
     bool outputToLogFile(QString logFileName, bool advancedLogFile);
+    bool outputToLogFile(LogWriter &logWriter, bool advancedLogFile);
     int loadDataFromLogFile(Events *&events, QString logFileName);
-    void appendToLogfile(QString logfilePath, EventNode *event);
-    QString nodeToString(EventNode *event);
+    static bool parseLogFile(QByteArrayView data, QVector<LogFileNode> &nodes, QByteArrayView &corruptLine);
+    static bool parseLogFileLine(QByteArrayView line, LogFileNode &node);
+    void loadLogFileNodes(const QVector<LogFileNode> &nodes);
+    static void replaceEvents(Events *&events, Events *newEvents);
+    void appendToLogfile(QString logfilePath, EventRecord event);
+    void appendToLogfile(LogWriter &logWriter, EventRecord event);
+    QString nodeToString(EventRecord event);
     bool stringToNode(QString nodeString);
 
     //======================================================================================
@@ -103,19 +97,18 @@ public:
     //======================================================================================
     #if DEV_MODE
         //serial message generation utils
-        QString generateNodeMessage(EventNode *event);
-        QString generateDataDump(EventNode *headPtr);
-        QString generateClearedMessage(EventNode *error);
+        QString generateNodeMessage(EventRecord event);
+        QString generateDataDump(EventFilter kind);
 
         //debug utils
-        void displayErrorLL();
+        void displayErrors();
 
         int getErrorIdByPosition(int pos);
     #endif
 signals:
     void RAMCleared();
 private:
-    //called as last resort when clearError cant find error node, if this
+    //called as last resort when the log writer has not indexed the error, if this
     //returns fail, we dont recognize the node
     int clearErrorInLogFile(int id, QString logFileName);
 };
@@ -0,0 +1,453 @@
+#include "eventsearch.h"
+#include "messagedecoder.h"
+#include <algorithm>
+
+/********************************************************************************
+** eventsearch.cpp
+**
+** This file implements the events page search index.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Constructor, the index is empty
+ */
+EventSearch::EventSearch()
+    : stringCount(0)
+{
+}
+
+/**
+ * @brief Removes every node and string from the index
+ */
+void EventSearch::clear()
+{
+    ids.resize(0);
+    timesMs.resize(0);
+    flags.resize(0);
+    stringRefs.resize(0);
+    eventNodes.resize(0);
+    errorNodes.resize(0);
+    idNodes.clear();
+
+    strings.clear();
+    stringCount = 0;
+    trigramStrings.clear();
+
+    activeErrors.clear();
+}
+
+/**
+ * @brief Indexes a node
+ *
+ * Node i of the index is row i of the events store.
+ *
+ * @param node The node that was added to the events store
+ */
+void EventSearch::add(EventRecord node)
+{
+    qint32 index = static_cast<qint32>(ids.size());
+
+    quint8 nodeFlags = 0;
+    if (node.isError())
+    {
+        nodeFlags |= ERROR_NODE;
+
+        if (node.isCleared())
+        {
+            nodeFlags |= CLEARED_NODE;
+        }
+        else
+        {
+            activeErrors.insert(node.id(), index);
+        }
+    }
+
+    ids.append(node.id());
+    timesMs.append(node.timeMs());
+    flags.append(nodeFlags);
+    stringRefs.append(internString(node.eventString()));
+
+    (node.isError() ? errorNodes : eventNodes).append(index);
+    idNodes[node.id()].append(index);
+}
+
+/**
+ * @brief Replaces the index with the nodes of a store
+ *
+ * @param store Events store holding every node of the session
+ */
+void EventSearch::rebuild(const EventStore &store)
+{
+    clear();
+
+    //nodes are added in store row order, so node i is store row i
+    qsizetype rows = store.rowCount();
+    for (qsizetype row = 0; row < rows; row++)
+    {
+        add(EventRecord(&store, row));
+    }
+}
+
+/**
+ * @brief Empties the index along with the events store
+ *
+ * Keeping cleared nodes would let the index grow without the bound RAM clearing
+ * puts on the store.
+ */
+void EventSearch::storeCleared()
+{
+    clear();
+}
+
+/**
+ * @brief Marks an error as cleared
+ *
+ * The error added first is cleared when several active errors share an id, the same
+ * error the events class clears.
+ *
+ * @param errorId The id of the cleared error
+ */
+void EventSearch::errorCleared(int errorId)
+{
+    QList<qint32> errors = activeErrors.values(errorId);
+    if (errors.isEmpty())
+    {
+        return;
+    }
+
+    qint32 index = *std::min_element(errors.cbegin(), errors.cend());
+
+    flags[index] |= CLEARED_NODE;
+    activeErrors.remove(errorId, index);
+}
+
+/**
+ * @brief Finds the nodes matching a query
+ *
+ * Hits are ranked by how well their event string matches the text of the query (the
+ * whole string, the start of a word, then anywhere), then newest first. An id filter
+ * only visits the nodes with that id, otherwise only the nodes of the allowed kinds
+ * within the time window are visited.
+ *
+ * @param query Filters the hits must match
+ * @param maxHits Maximum number of hits to return
+ * @return The best hits and the number of nodes that matched
+ */
+SearchResults EventSearch::search(const SearchQuery &query, int maxHits) const
+{
+    SearchResults results;
+
+    //score the distinct strings once rather than every node
+    QVector<qint8> scores = scoreStrings(query.text);
+
+    //hits of each score, newest first
+    QVector<qint32> ranked[EXACT_MATCH + 1];
+
+    //nodes must be visited newest first
+    auto visit = [&](qint32 index)
+    {
+        qint8 score = scores[stringRefs[index]];
+        if (score == NO_MATCH || timesMs[index] < query.fromMs || timesMs[index] > query.toMs)
+        {
+            return;
+        }
+
+        bool isError = flags[index] & ERROR_NODE;
+        bool cleared = flags[index] & CLEARED_NODE;
+
+        bool kindMatches;
+        switch (query.filter)
+        {
+        case EVENTS:
+            kindMatches = !isError;
+            break;
+        case ERRORS:
+            kindMatches = isError;
+            break;
+        case CLEARED_ERRORS:
+            kindMatches = isError && cleared;
+            break;
+        case NON_CLEARED_ERRORS:
+            kindMatches = isError && !cleared;
+            break;
+        default:
+            kindMatches = true;
+        }
+
+        if (!kindMatches)
+        {
+            return;
+        }
+
+        results.totalHits++;
+
+        //lower scores can not make the results once enough better hits are found
+        if (ranked[score].size() < maxHits)
+        {
+            ranked[score].append(index);
+        }
+    };
+
+    if (query.id != -1)
+    {
+        auto it = idNodes.constFind(query.id);
+        if (it != idNodes.cend())
+        {
+            for (qsizetype pos = it->size() - 1; pos >= 0; pos--)
+            {
+                visit(it->at(pos));
+            }
+        }
+    }
+    else
+    {
+        //the time window of each kind, left empty for a kind the filter excludes
+        QPair<qsizetype, qsizetype> events(0, 0);
+        QPair<qsizetype, qsizetype> errors(0, 0);
+
+        if (query.filter == ALL || query.filter == EVENTS)
+        {
+            events = timeRange(eventNodes, query.fromMs, query.toMs);
+        }
+        if (query.filter != EVENTS)
+        {
+            errors = timeRange(errorNodes, query.fromMs, query.toMs);
+        }
+
+        //merge the windows newest first
+        qsizetype eventPos = events.second - 1;
+        qsizetype errorPos = errors.second - 1;
+
+        while (eventPos >= events.first || errorPos >= errors.first)
+        {
+            if (errorPos < errors.first
+                || (eventPos >= events.first && eventNodes[eventPos] > errorNodes[errorPos]))
+            {
+                visit(eventNodes[eventPos--]);
+            }
+            else
+            {
+                visit(errorNodes[errorPos--]);
+            }
+        }
+    }
+
+    for (int score = EXACT_MATCH; score >= SUBSTRING_MATCH; score--)
+    {
+        for (qint32 index : ranked[score])
+        {
+            if (results.hits.size() == maxHits)
+            {
+                return results;
+            }
+
+            results.hits.append(SearchHit{ids[index], timesMs[index], bool(flags[index] & ERROR_NODE),
+                                          bool(flags[index] & CLEARED_NODE),
+                                          strings.view(stringRefs[index]).toString(), index});
+        }
+    }
+
+    return results;
+}
+
+/**
+ * @brief Binary searches the nodes of a kind for a time window
+ *
+ * @param nodes Nodes of one kind, in time stamp order
+ * @param fromMs Earliest time stamp in the window, in milliseconds
+ * @param toMs Latest time stamp in the window, in milliseconds
+ * @return Position in nodes of the first node in the window and one past the last
+ */
+QPair<qsizetype, qsizetype> EventSearch::timeRange(const QVector<qint32> &nodes, qint64 fromMs, qint64 toMs) const
+{
+    auto before = [this](qint32 index, qint64 ms) { return timesMs[index] < ms; };
+    auto after = [this](qint64 ms, qint32 index) { return ms < timesMs[index]; };
+
+    qsizetype first = std::lower_bound(nodes.cbegin(), nodes.cend(), fromMs, before) - nodes.cbegin();
+    qsizetype last = std::upper_bound(nodes.cbegin() + first, nodes.cend(), toMs, after) - nodes.cbegin();
+
+    return qMakePair(first, last);
+}
+
+/**
+ * @brief Builds a query from the text typed into the search box
+ *
+ * @param text Words separated by spaces
+ * @return The query, filters that could not be parsed are searched for as text
+ */
+SearchQuery EventSearch::parseQuery(const QString &text)
+{
+    SearchQuery query;
+    QStringList words;
+
+    for (const QString &word : text.split(' ', Qt::SkipEmptyParts))
+    {
+        QString value = word.section(':', 1);
+        qint64 timeMs;
+        bool valid = false;
+
+        if (word.startsWith("id:", Qt::CaseInsensitive))
+        {
+            //an id that does not parse must not replace the id already set
+            int id = value.toInt(&valid);
+            if (valid)
+            {
+                query.id = id;
+            }
+        }
+        else if (word.startsWith("from:", Qt::CaseInsensitive) && MessageDecoder::parseTimeStamp(value.toUtf8(), timeMs))
+        {
+            query.fromMs = timeMs;
+            valid = true;
+        }
+        else if (word.startsWith("to:", Qt::CaseInsensitive) && MessageDecoder::parseTimeStamp(value.toUtf8(), timeMs))
+        {
+            query.toMs = timeMs;
+            valid = true;
+        }
+        else if (word.startsWith("kind:", Qt::CaseInsensitive))
+        {
+            valid = true;
+            value = value.toLower();
+
+            if (value == "events") query.filter = EVENTS;
+            else if (value == "errors") query.filter = ERRORS;
+            else if (value == "cleared") query.filter = CLEARED_ERRORS;
+            else if (value == "active") query.filter = NON_CLEARED_ERRORS;
+            else valid = false;
+        }
+
+        if (!valid)
+        {
+            words.append(word);
+        }
+    }
+
+    query.text = words.join(' ');
+
+    return query;
+}
+
+/**
+ * @brief Interns an event string, indexing the trigrams of strings seen for the first time
+ */
+qint32 EventSearch::internString(QStringView string)
+{
+    qint32 ref = strings.intern(string);
+
+    //refs are handed out in order, so an older string has a lower ref
+    if (ref < stringCount)
+    {
+        return ref;
+    }
+    stringCount++;
+
+    for (qsizetype pos = 0; pos + 3 <= string.size(); pos++)
+    {
+        QVector<qint32> &refs = trigramStrings[trigram(string, pos)];
+
+        //a trigram repeated within the string is only indexed once
+        if (refs.isEmpty() || refs.last() != ref)
+        {
+            refs.append(ref);
+        }
+    }
+
+    return ref;
+}
+
+/**
+ * @brief Scores every pooled string against the text of a query
+ *
+ * Only strings holding every trigram of the text can contain it, so only those are
+ * compared. Shorter text has no trigrams and is compared with every string.
+ *
+ * @param text Text to search for
+ * @return Score of each string by reference
+ */
+QVector<qint8> EventSearch::scoreStrings(const QString &text) const
+{
+    if (text.isEmpty())
+    {
+        return QVector<qint8>(stringCount, SUBSTRING_MATCH);
+    }
+
+    QVector<qint8> scores(stringCount, NO_MATCH);
+
+    if (text.size() < 3)
+    {
+        for (qint32 ref = 0; ref < stringCount; ref++)
+        {
+            scores[ref] = scoreString(strings.view(ref), text);
+        }
+        return scores;
+    }
+
+    //start from the trigram held by the fewest strings
+    QVector<const QVector<qint32> *> postings;
+    for (qsizetype pos = 0; pos + 3 <= text.size(); pos++)
+    {
+        auto it = trigramStrings.constFind(trigram(text, pos));
+        if (it == trigramStrings.cend())
+        {
+            return scores;
+        }
+        postings.append(&it.value());
+    }
+
+    std::sort(postings.begin(), postings.end(), [](const QVector<qint32> *a, const QVector<qint32> *b) {
+        return a->size() < b->size();
+    });
+
+    QVector<qint32> candidates = *postings.first();
+    for (qsizetype i = 1; i < postings.size() && !candidates.isEmpty(); i++)
+    {
+        QVector<qint32> common;
+        std::set_intersection(candidates.cbegin(), candidates.cend(), postings[i]->cbegin(), postings[i]->cend(),
+                              std::back_inserter(common));
+        candidates.swap(common);
+    }
+
+    //trigrams can match out of order, so candidates are checked
+    for (qint32 ref : candidates)
+    {
+        scores[ref] = scoreString(strings.view(ref), text);
+    }
+
+    return scores;
+}
+
+qint8 EventSearch::scoreString(QStringView string, const QString &text)
+{
+    qsizetype pos = string.indexOf(text, 0, Qt::CaseInsensitive);
+    if (pos == -1)
+    {
+        return NO_MATCH;
+    }
+
+    if (string.size() == text.size())
+    {
+        return EXACT_MATCH;
+    }
+
+    //look for an occurrence at the start of a word
+    while (pos != -1)
+    {
+        if (pos == 0 || !string[pos - 1].isLetterOrNumber())
+        {
+            return WORD_MATCH;
+        }
+        pos = string.indexOf(text, pos + 1, Qt::CaseInsensitive);
+    }
+
+    return SUBSTRING_MATCH;
+}
+
+quint64 EventSearch::trigram(QStringView string, qsizetype pos)
+{
+    return (quint64(string[pos].toCaseFolded().unicode()) << 32)
+           | (quint64(string[pos + 1].toCaseFolded().unicode()) << 16)
+           | quint64(string[pos + 2].toCaseFolded().unicode());
+}
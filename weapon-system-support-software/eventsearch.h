@@ -0,0 +1,138 @@
+#ifndef EVENTSEARCH_H
+#define EVENTSEARCH_H
+
+#include <QString>
+#include <QVector>
+#include <QHash>
+#include <QMultiHash>
+#include <QPair>
+#include <limits>
+#include "constants.h"
+#include "eventstore.h"
+
+/********************************************************************************
+** eventsearch.h
+**
+** The EventSearch class indexes the events and errors in the events store for the
+** events page search. It holds the same nodes as the store and is emptied when RAM
+** clearing empties the store, so it is bounded by the same node limit. Nodes cleared
+** from RAM are only in the auto save log file. Nodes are kept as compact columns with
+** their text interned, and the distinct event strings are indexed by trigram (every 3 character
+** substring, ignoring case). A query only checks the strings that contain all of its
+** trigrams. The nodes it visits are narrowed by a per id index, or else by binary
+** searching the time window in the nodes of each kind the query allows.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Filters of a search, every filter must match for a node to be a hit
+ */
+struct SearchQuery
+{
+    QString text; // case insensitive text within the event string, empty matches all
+    EventFilter filter = ALL;
+    int id = -1; // -1 matches every id
+    qint64 fromMs = 0;
+    qint64 toMs = std::numeric_limits<qint64>::max();
+};
+
+/**
+ * @brief A node found by a search
+ */
+struct SearchHit
+{
+    int id;
+    qint64 timeMs;
+    bool isError;
+    bool cleared;
+    QString eventString;
+
+    // row of the node in the events store
+    qint32 storeRow;
+};
+
+/**
+ * @brief Hits of a search, best first
+ */
+struct SearchResults
+{
+    QVector<SearchHit> hits; // at most the number of hits requested
+    qsizetype totalHits = 0; // every node that matched
+};
+
+class EventSearch
+{
+public:
+    EventSearch();
+
+    // removes every node, used when a new session begins
+    void clear();
+
+    // indexes a node, nodes must be added in the order they are added to the store.
+    // like the store, nodes of each kind must be added in time stamp order
+    void add(EventRecord node);
+
+    // replaces every node with the nodes of store (i.e. after a dump or log file load)
+    void rebuild(const EventStore &store);
+
+    // the store was cleared to free RAM, the index is emptied with it
+    void storeCleared();
+
+    // marks the first active error with an id as cleared
+    void errorCleared(int errorId);
+
+    // returns up to maxHits hits ranked by how well they match, then newest first
+    SearchResults search(const SearchQuery &query, int maxHits) const;
+
+    // number of nodes indexed
+    qsizetype size() const { return ids.size(); }
+
+    // builds a query from search box text. Words of the form id:<n>, kind:<events,
+    // errors, cleared or active>, from:<time stamp> and to:<time stamp> set filters,
+    // every other word is part of the text
+    static SearchQuery parseQuery(const QString &text);
+
+private:
+    // flags of a node
+    enum NodeFlag : quint8 { ERROR_NODE = 0x1, CLEARED_NODE = 0x2 };
+
+    // how well a string matches the text of a query, higher is better
+    enum MatchScore : qint8 { NO_MATCH = -1, SUBSTRING_MATCH = 0, WORD_MATCH = 1, EXACT_MATCH = 2 };
+
+    // adds a string to the pool, indexing its trigrams if it is new
+    qint32 internString(QStringView string);
+
+    // positions in nodes (one kind, sorted by time) of the window fromMs..toMs
+    QPair<qsizetype, qsizetype> timeRange(const QVector<qint32> &nodes, qint64 fromMs, qint64 toMs) const;
+
+    // scores every pooled string against text
+    QVector<qint8> scoreStrings(const QString &text) const;
+    static qint8 scoreString(QStringView string, const QString &text);
+
+    // packs 3 characters, ignoring case, into a trigram key
+    static quint64 trigram(QStringView string, qsizetype pos);
+
+    // node columns
+    QVector<qint32> ids;
+    QVector<qint64> timesMs;
+    QVector<quint8> flags;
+    QVector<qint32> stringRefs;
+
+    // distinct event strings and the strings containing each trigram, in ascending order
+    StringPool strings;
+    qint32 stringCount;
+    QHash<quint64, QVector<qint32>> trigramStrings;
+
+    // nodes of each kind in the order they were added, so in time stamp order
+    QVector<qint32> eventNodes;
+    QVector<qint32> errorNodes;
+
+    // id -> nodes with that id, in the order they were added
+    QHash<int, QVector<qint32>> idNodes;
+
+    // error id -> active errors with that id
+    QMultiHash<int, qint32> activeErrors;
+};
+
+#endif // EVENTSEARCH_H
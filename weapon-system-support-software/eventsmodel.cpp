@@ -0,0 +1,396 @@
+#include "eventsmodel.h"
+
+/********************************************************************************
+** eventsmodel.cpp
+**
+** This file implements the events page list model and the delegate which colors
+** its rows.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Constructor, the model is empty until it is reset with an events object
+ */
+EventsModel::EventsModel(QObject *parent)
+    : QAbstractListModel(parent), events(nullptr), filter(ALL), publishedRows(0)
+{
+}
+
+int EventsModel::rowCount(const QModelIndex &parent) const
+{
+    //list models only have top level rows
+    return parent.isValid() ? 0 : static_cast<int>(publishedRows);
+}
+
+/**
+ * @brief Provides the text and kind of a row
+ *
+ * The text is generated each time it is requested, the view only requests rows that
+ * are on screen.
+ */
+QVariant EventsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= publishedRows)
+    {
+        return QVariant();
+    }
+
+    EventRecord node = this->node(index.row());
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return events->nodeToString(node);
+
+    case KindRole:
+        if (!node.isError())
+        {
+            return EVENT_ROW;
+        }
+        return node.isCleared() ? CLEARED_ERROR_ROW : ACTIVE_ERROR_ROW;
+
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Rebuilds the rows of every filter from an events object
+ *
+ * @param events Events object to present
+ * @param filter Kinds of nodes to show
+ */
+void EventsModel::reset(Events *events, EventFilter filter)
+{
+    beginResetModel();
+
+    this->events = events;
+    this->filter = filter;
+
+    for (QVector<qint32> &rows : storeRows)
+    {
+        rows.resize(0);
+    }
+    allFilterRows.fill(-1, events->store.rowCount());
+    kindFilterRows.fill(-1, allFilterRows.size());
+    pendingClears.resize(0);
+
+    //every node is in the ALL rows and in the rows of its kind
+    for (EventRecord node : events->store.rows(ALL))
+    {
+        qint32 storeRow = static_cast<qint32>(node.row());
+
+        allFilterRows[storeRow] = static_cast<qint32>(storeRows[ALL].size());
+        kindFilterRows[storeRow] = static_cast<qint32>(storeRows[node.isError() ? ERRORS : EVENTS].size());
+
+        for (int i = 0; i < NUM_EVENT_FILTER; i++)
+        {
+            if (filterAllows(EventFilter(i), node))
+            {
+                storeRows[i].append(storeRow);
+            }
+        }
+    }
+
+    publishedRows = storeRows[filter].size();
+
+    endResetModel();
+}
+
+/**
+ * @brief Shows the rows of another filter
+ *
+ * The rows of every filter are already built, so this does not depend on the number
+ * of nodes.
+ *
+ * @param filter Kinds of nodes to show
+ */
+void EventsModel::setFilter(EventFilter filter)
+{
+    if (filter == this->filter)
+    {
+        return;
+    }
+
+    //the error state filters are only brought up to date when they are shown
+    if (filter == CLEARED_ERRORS || filter == NON_CLEARED_ERRORS)
+    {
+        applyPendingClears();
+    }
+
+    beginResetModel();
+    this->filter = filter;
+    publishedRows = storeRows[filter].size();
+    endResetModel();
+}
+
+/**
+ * @brief Adds a node to the end of the rows of each filter that allows it
+ *
+ * Rows already in the list are untouched. The view is told about the new row when it
+ * is published.
+ *
+ * @param node The node that was added to the events store
+ */
+void EventsModel::append(EventRecord node)
+{
+    if (events == nullptr)
+    {
+        return;
+    }
+
+    qint32 storeRow = static_cast<qint32>(node.row());
+
+    if (storeRow >= allFilterRows.size())
+    {
+        allFilterRows.resize(storeRow + 1, -1);
+        kindFilterRows.resize(storeRow + 1, -1);
+    }
+    allFilterRows[storeRow] = static_cast<qint32>(storeRows[ALL].size());
+    kindFilterRows[storeRow] = static_cast<qint32>(storeRows[node.isError() ? ERRORS : EVENTS].size());
+
+    for (int i = 0; i < NUM_EVENT_FILTER; i++)
+    {
+        if (filterAllows(EventFilter(i), node))
+        {
+            storeRows[i].append(storeRow);
+        }
+    }
+}
+
+/**
+ * @brief Inserts every unpublished row of the shown filter into the view at once
+ */
+void EventsModel::publishRows()
+{
+    qsizetype rows = storeRows[filter].size();
+
+    if (rows == publishedRows)
+    {
+        return;
+    }
+
+    beginInsertRows(QModelIndex(), static_cast<int>(publishedRows), static_cast<int>(rows - 1));
+    publishedRows = rows;
+    endInsertRows();
+}
+
+/**
+ * @brief Redraws the row of a cleared error
+ *
+ * The row is found through the error's row handle, so clearing an error does not
+ * depend on the number of rows. If an error state filter is shown the error is moved
+ * between them now, otherwise it is moved when one of them is next shown.
+ *
+ * @param error The error that was cleared in the events store
+ * @return False if the error is not in the model
+ */
+bool EventsModel::errorCleared(EventRecord error)
+{
+    qint32 storeRow = static_cast<qint32>(error.row());
+
+    if (events == nullptr || storeRow >= allFilterRows.size() || allFilterRows[storeRow] == -1)
+    {
+        return false;
+    }
+
+    pendingClears.append(storeRow);
+
+    if (filter == CLEARED_ERRORS || filter == NON_CLEARED_ERRORS)
+    {
+        applyPendingClears();
+    }
+    //redraw the error if it is shown, unpublished rows are drawn with the new indicator
+    //once they are published
+    else if (filter == ALL || filter == ERRORS)
+    {
+        int row = (filter == ALL) ? allFilterRows[storeRow] : kindFilterRows[storeRow];
+        if (row < publishedRows)
+        {
+            emit dataChanged(index(row), index(row));
+        }
+    }
+
+    return true;
+}
+
+EventRecord EventsModel::node(int row) const
+{
+    return EventRecord(&events->store, storeRows[filter][row]);
+}
+
+/**
+ * @brief Finds the row showing a node of the events store
+ *
+ * @param storeRow Row of the node in the events store
+ * @return Row of the node, -1 if it is not shown or not yet published
+ */
+int EventsModel::shownRow(qint32 storeRow) const
+{
+    if (events == nullptr || storeRow < 0 || storeRow >= allFilterRows.size() || allFilterRows[storeRow] == -1)
+    {
+        return -1;
+    }
+
+    qsizetype row;
+
+    switch (filter)
+    {
+    case ALL:
+        row = allFilterRows[storeRow];
+        break;
+
+    case EVENTS:
+    case ERRORS:
+        if (!filterAllows(filter, EventRecord(&events->store, storeRow)))
+        {
+            return -1;
+        }
+        row = kindFilterRows[storeRow];
+        break;
+
+    //error state rows are up to date while they are shown
+    default:
+        row = lowerBound(filter, storeRow);
+        if (row >= storeRows[filter].size() || storeRows[filter][row] != storeRow)
+        {
+            return -1;
+        }
+    }
+
+    return row < publishedRows ? static_cast<int>(row) : -1;
+}
+
+bool EventsModel::filterAllows(EventFilter filter, EventRecord node)
+{
+    switch (filter)
+    {
+    case ALL:
+        return true;
+    case EVENTS:
+        return !node.isError();
+    case ERRORS:
+        return node.isError();
+    case CLEARED_ERRORS:
+        return node.isError() && node.isCleared();
+    case NON_CLEARED_ERRORS:
+        return node.isError() && !node.isCleared();
+    default:
+        return false;
+    }
+}
+
+qsizetype EventsModel::lowerBound(EventFilter filter, qint32 storeRow) const
+{
+    const QVector<qint32> &rows = storeRows[filter];
+    qint32 allRow = allFilterRows[storeRow];
+
+    auto it = std::lower_bound(rows.cbegin(), rows.cend(), allRow, [this](qint32 row, qint32 allRow) {
+        return allFilterRows[row] < allRow;
+    });
+
+    return it - rows.cbegin();
+}
+
+/**
+ * @brief Moves queued cleared errors from the active errors rows to the cleared errors rows
+ *
+ * Rows of each filter are in the order of the ALL filter rows, so each error is found
+ * and placed with a binary search.
+ */
+void EventsModel::applyPendingClears()
+{
+    for (qint32 storeRow : pendingClears)
+    {
+        //move the error if it was not already moved
+        qsizetype activeRow = lowerBound(NON_CLEARED_ERRORS, storeRow);
+        if (activeRow < storeRows[NON_CLEARED_ERRORS].size() && storeRows[NON_CLEARED_ERRORS][activeRow] == storeRow)
+        {
+            removeFilterRow(NON_CLEARED_ERRORS, activeRow);
+            insertFilterRow(CLEARED_ERRORS, lowerBound(CLEARED_ERRORS, storeRow), storeRow);
+        }
+    }
+
+    pendingClears.resize(0);
+}
+
+void EventsModel::insertFilterRow(EventFilter filter, qsizetype row, qint32 storeRow)
+{
+    bool shown = filter == this->filter;
+
+    //rows before an unpublished row must be published first
+    if (shown)
+    {
+        publishRows();
+        beginInsertRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+    }
+
+    storeRows[filter].insert(row, storeRow);
+
+    if (shown)
+    {
+        publishedRows++;
+        endInsertRows();
+    }
+}
+
+void EventsModel::removeFilterRow(EventFilter filter, qsizetype row)
+{
+    bool shown = filter == this->filter;
+
+    if (shown)
+    {
+        publishRows();
+        beginRemoveRows(QModelIndex(), static_cast<int>(row), static_cast<int>(row));
+    }
+
+    storeRows[filter].remove(row);
+
+    if (shown)
+    {
+        publishedRows--;
+        endRemoveRows();
+    }
+}
+
+//======================================================================================
+// EventsDelegate
+//======================================================================================
+
+/**
+ * @brief Constructor, colored output is enabled by default
+ */
+EventsDelegate::EventsDelegate(QObject *parent)
+    : QStyledItemDelegate(parent), colored(INITIAL_COLORED_EVENTS_OUTPUT)
+{
+}
+
+/**
+ * @brief Paints a row in the color of its kind
+ */
+void EventsDelegate::paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const
+{
+    QStyleOptionViewItem rowOption(option);
+    QColor color = EVENT_COLOR;
+
+    if (colored)
+    {
+        switch (index.data(EventsModel::KindRole).toInt())
+        {
+        case EventsModel::ACTIVE_ERROR_ROW:
+            color = ACTIVE_ERROR_COLOR;
+            break;
+        case EventsModel::CLEARED_ERROR_ROW:
+            color = CLEARED_ERROR_COLOR;
+            break;
+        default:
+            break;
+        }
+    }
+
+    rowOption.palette.setColor(QPalette::Text, color);
+    rowOption.palette.setColor(QPalette::HighlightedText, color);
+
+    QStyledItemDelegate::paint(painter, rowOption, index);
+}
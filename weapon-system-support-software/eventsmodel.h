@@ -0,0 +1,121 @@
+#ifndef EVENTSMODEL_H
+#define EVENTSMODEL_H
+
+#include <QAbstractListModel>
+#include <QStyledItemDelegate>
+#include <algorithm>
+#include "events.h"
+
+/********************************************************************************
+** eventsmodel.h
+**
+** The EventsModel class presents the events and errors held by an Events object to
+** the events page list view, one row per node allowed by the selected filter. Rows
+** only refer to nodes in the events store, the text of a row is generated when the
+** view asks for it, so only rows that are on screen are ever formatted or laid out.
+**
+** The rows of every filter are kept up to date as nodes are added and errors are
+** cleared, so switching filters only changes which list is shown. Added rows are
+** published to the view in bursts, once per gui render.
+**
+** The EventsDelegate class colors each row by its kind (event, active error or
+** cleared error).
+**
+** @author Team Controller
+********************************************************************************/
+
+class EventsModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // data roles provided in addition to Qt::DisplayRole
+    enum EventsRole { KindRole = Qt::UserRole + 1 };
+
+    // values of KindRole
+    enum RowKind { EVENT_ROW = 0, ACTIVE_ERROR_ROW = 1, CLEARED_ERROR_ROW = 2 };
+
+    // constructors
+    EventsModel(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // rebuilds the rows of every filter from the nodes of events, in time stamp order.
+    // must be called whenever events is replaced or its store is cleared
+    void reset(Events *events, EventFilter filter);
+
+    // shows the rows of another filter
+    void setFilter(EventFilter filter);
+
+    // adds a node to the end of the rows of each filter that allows it. The view is not
+    // told about new rows until they are published
+    void append(EventRecord node);
+
+    // tells the view about every row appended since the last publish, so a burst of
+    // nodes is inserted into the view at once
+    void publishRows();
+
+    // redraws the row of an error that was cleared and moves it to the cleared errors
+    // rows, returns false if the error is not in the model
+    bool errorCleared(EventRecord error);
+
+    // node shown in a row
+    EventRecord node(int row) const;
+
+    // row showing a store row, -1 if the shown filter does not show it
+    int shownRow(qint32 storeRow) const;
+
+private:
+    // true if filter shows node
+    static bool filterAllows(EventFilter filter, EventRecord node);
+
+    // index of a store row in the rows of a filter, or where it belongs if it is not there
+    qsizetype lowerBound(EventFilter filter, qint32 storeRow) const;
+
+    // change the rows of a filter, the view is notified if the filter is shown
+    void insertFilterRow(EventFilter filter, qsizetype row, qint32 storeRow);
+    void removeFilterRow(EventFilter filter, qsizetype row);
+
+    // moves queued cleared errors from the active errors rows to the cleared errors rows
+    void applyPendingClears();
+
+    Events *events;
+    EventFilter filter;
+
+    // number of rows of the shown filter the view knows about
+    qsizetype publishedRows;
+
+    // store row of each list row, for every filter. Rows are in the order of the ALL
+    // filter, the order nodes were added to the model
+    QVector<qint32> storeRows[NUM_EVENT_FILTER];
+
+    // row handles, the ALL, EVENTS and ERRORS rows are only appended to so a node
+    // keeps its index in them. Index of each store row in the ALL filter rows, and in
+    // the EVENTS or ERRORS rows depending on its kind
+    QVector<qint32> allFilterRows;
+    QVector<qint32> kindFilterRows;
+
+    // store rows of errors cleared while neither error state filter was shown, they are
+    // moved when one is shown
+    QVector<qint32> pendingClears;
+};
+
+class EventsDelegate : public QStyledItemDelegate
+{
+    Q_OBJECT
+public:
+    // constructors
+    EventsDelegate(QObject *parent = nullptr);
+
+    // colored output uses a different color for each kind of row, otherwise every row
+    // uses the event color
+    void setColored(bool colored) { this->colored = colored; }
+
+    void paint(QPainter *painter, const QStyleOptionViewItem &option, const QModelIndex &index) const override;
+
+private:
+    bool colored;
+};
+
+#endif // EVENTSMODEL_H
@@ -0,0 +1,550 @@
+#include "eventstore.h"
+#include <algorithm>
+
+/********************************************************************************
+** eventstore.cpp
+**
+** This file implements the columnar events/errors store, its string pool and the
+** iterators used to walk the store in time stamp order.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Default constructor, the pool starts empty
+ */
+StringPool::StringPool()
+    : offsets{0}
+{
+}
+
+/**
+ * @brief Adds a string to the pool unless an identical string was already interned
+ *
+ * @param string The string to add
+ * @return Reference to the pooled string
+ */
+qint32 StringPool::intern(QStringView string)
+{
+    size_t hash = qHash(string);
+
+    //check for a previous copy of this string
+    for (auto it = internedRefs.constFind(hash); it != internedRefs.cend() && it.key() == hash; ++it)
+    {
+        if (view(it.value()) == string)
+        {
+            return it.value();
+        }
+    }
+
+    qint32 ref = append(string);
+    internedRefs.insert(hash, ref);
+
+    return ref;
+}
+
+/**
+ * @brief Adds a string to the end of the pool
+ *
+ * @param string The string to add
+ * @return Reference to the pooled string
+ */
+qint32 StringPool::append(QStringView string)
+{
+    chars.append(string);
+    offsets.append(chars.size());
+
+    return static_cast<qint32>(offsets.size() - 2);
+}
+
+QStringView StringPool::view(qint32 ref) const
+{
+    return QStringView(chars).sliced(offsets[ref], offsets[ref + 1] - offsets[ref]);
+}
+
+/**
+ * @brief Removes every string from the pool
+ *
+ * The buffers keep their capacity, a RAM clear is followed by the pool filling back up.
+ */
+void StringPool::clear()
+{
+    chars.resize(0);
+    offsets.resize(1);
+    internedRefs.clear();
+}
+
+qsizetype StringPool::bytesReserved() const
+{
+    return chars.capacity() * static_cast<qsizetype>(sizeof(QChar))
+           + offsets.capacity() * static_cast<qsizetype>(sizeof(qsizetype));
+}
+
+//======================================================================================
+// EventRecord
+//======================================================================================
+
+EventRecord::EventRecord()
+    : store(nullptr), rowIndex(-1)
+{
+}
+
+EventRecord::EventRecord(const EventStore *store, qsizetype row)
+    : store(store), rowIndex(row)
+{
+}
+
+int EventRecord::id() const
+{
+    return store->id(rowIndex);
+}
+
+qint64 EventRecord::timeMs() const
+{
+    return store->timeMs(rowIndex);
+}
+
+QString EventRecord::timeStamp() const
+{
+    return store->timeStamp(rowIndex);
+}
+
+QString EventRecord::eventString() const
+{
+    return store->eventString(rowIndex);
+}
+
+bool EventRecord::isError() const
+{
+    return store->isError(rowIndex);
+}
+
+bool EventRecord::isCleared() const
+{
+    return store->isCleared(rowIndex);
+}
+
+//======================================================================================
+// EventStore::const_iterator
+//======================================================================================
+
+/**
+ * @brief Creates an iterator at the given positions of the event and error rows
+ */
+EventStore::const_iterator::const_iterator(const EventStore *store, EventFilter filter,
+                                           qsizetype eventPos, qsizetype errorPos,
+                                           qsizetype eventEnd, qsizetype errorEnd)
+    : store(store), filter(filter), eventPos(eventPos), errorPos(errorPos),
+      eventEnd(eventEnd), errorEnd(errorEnd)
+{
+    skipFilteredErrors();
+}
+
+EventRecord EventStore::const_iterator::operator*() const
+{
+    return EventRecord(store, eventIsNext() ? store->eventRows[eventPos] : store->errorRows[errorPos]);
+}
+
+EventStore::const_iterator &EventStore::const_iterator::operator++()
+{
+    if (eventIsNext())
+    {
+        eventPos++;
+    }
+    else
+    {
+        errorPos++;
+        skipFilteredErrors();
+    }
+
+    return *this;
+}
+
+bool EventStore::const_iterator::operator==(const const_iterator &other) const
+{
+    return eventPos == other.eventPos && errorPos == other.errorPos;
+}
+
+/**
+ * @brief Chooses between the current event and the current error
+ *
+ * The row with the earliest time stamp comes first, if the time stamps are equal
+ * the row with the lowest id comes first.
+ */
+bool EventStore::const_iterator::eventIsNext() const
+{
+    // check for only events or only errors remaining
+    if (errorPos == errorEnd)
+    {
+        return true;
+    }
+    if (eventPos == eventEnd)
+    {
+        return false;
+    }
+
+    qint32 eventRow = store->eventRows[eventPos];
+    qint32 errorRow = store->errorRows[errorPos];
+
+    if (store->timesMs[eventRow] != store->timesMs[errorRow])
+    {
+        return store->timesMs[eventRow] < store->timesMs[errorRow];
+    }
+
+    //otherwise they occurred at the same time, select row with lowest id
+    return store->ids[eventRow] < store->ids[errorRow];
+}
+
+/**
+ * @brief Skips removed errors and errors that are excluded by the cleared/active filters
+ */
+void EventStore::const_iterator::skipFilteredErrors()
+{
+    bool stateFilter = (filter == CLEARED_ERRORS || filter == NON_CLEARED_ERRORS);
+
+    if (!stateFilter && store->removedErrors == 0)
+    {
+        return;
+    }
+
+    bool wantCleared = (filter == CLEARED_ERRORS);
+
+    while (errorPos < errorEnd
+           && (store->isRemoved(store->errorRows[errorPos])
+               || (stateFilter && store->isCleared(store->errorRows[errorPos]) != wantCleared)))
+    {
+        errorPos++;
+    }
+}
+
+//======================================================================================
+// EventStore
+//======================================================================================
+
+EventStore::EventStore()
+    : removedErrors(0)
+{
+}
+
+/**
+ * @brief Adds an event or error to the store
+ *
+ * Event strings are interned. Time stamps are stored as milliseconds, which rows are
+ * sorted and filtered by, along with the digit count of each field of their text so
+ * timeStamp() gives back the text the controller sent.
+ *
+ * @param id Id of the event or error
+ * @param timeMs Time stamp in milliseconds
+ * @param timeStamp Text the time stamp was parsed from (HH:MM:SS:mmm)
+ * @param eventString Message from the controller
+ * @param isError True for an error, false for an event
+ * @param cleared True if the error has been cleared
+ * @return Record referring to the new row
+ */
+EventRecord EventStore::append(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString,
+                               bool isError, bool cleared)
+{
+    qint32 row = static_cast<qint32>(ids.size());
+
+    ids.append(id);
+    timesMs.append(timeMs);
+    flags.append(static_cast<quint8>((isError ? ERROR_ROW : 0) | (cleared ? CLEARED_ROW : 0)));
+    eventStringRefs.append(strings.intern(eventString));
+
+    quint16 format = timeStampFormat(timeMs, timeStamp);
+    timeStampFormats.append(format);
+    if (format == 0)
+    {
+        irregularTimeStamps.insert(row, QString::fromUtf8(timeStamp));
+    }
+
+    if (isError)
+    {
+        errorRows.append(row);
+
+        //keep the first error with this id, matching a front to back search
+        if (!errorIndex.contains(id))
+        {
+            errorIndex.insert(id, row);
+        }
+        else
+        {
+            duplicateErrors.insert(id, row);
+        }
+    }
+    else
+    {
+        eventRows.append(row);
+    }
+
+    return EventRecord(this, row);
+}
+
+/**
+ * @brief Removes an error from the error rows and the error index
+ *
+ * The row is marked removed rather than taken out of the error rows, which must stay
+ * in time stamp order. Removed rows are skipped by iteration and compacted out once
+ * they make up half of the error rows, so a removal costs amortized constant time.
+ * The row's columns are left in place until the store is cleared.
+ *
+ * @param row Row of the error to remove
+ */
+void EventStore::removeError(qsizetype row)
+{
+    if (isRemoved(row))
+    {
+        return;
+    }
+
+    flags[row] |= REMOVED_ROW;
+    removedErrors++;
+
+    int id = ids[row];
+    auto it = errorIndex.find(id);
+
+    if (it != errorIndex.end() && it.value() == row)
+    {
+        errorIndex.erase(it);
+
+        //point the index at the next stored error sharing this id, the one added first
+        auto next = duplicateErrors.constFind(id);
+        if (next != duplicateErrors.cend())
+        {
+            qint32 nextRow = next.value();
+            for (; next != duplicateErrors.cend() && next.key() == id; ++next)
+            {
+                nextRow = qMin(nextRow, next.value());
+            }
+
+            duplicateErrors.remove(id, nextRow);
+            errorIndex.insert(id, nextRow);
+        }
+    }
+    else
+    {
+        duplicateErrors.remove(id, static_cast<qint32>(row));
+    }
+
+    //compact once removed rows make up half of the error rows
+    if (removedErrors * 2 >= errorRows.size())
+    {
+        errorRows.erase(std::remove_if(errorRows.begin(), errorRows.end(),
+                                       [this](qint32 errorRow) { return isRemoved(errorRow); }),
+                        errorRows.end());
+        removedErrors = 0;
+    }
+}
+
+/**
+ * @brief Removes every row from the store
+ *
+ * Columns keep their capacity, since RAM clearing refills the store up to the same
+ * number of rows.
+ */
+void EventStore::clear()
+{
+    ids.resize(0);
+    timesMs.resize(0);
+    flags.resize(0);
+    eventStringRefs.resize(0);
+    timeStampFormats.resize(0);
+    irregularTimeStamps.clear();
+    eventRows.resize(0);
+    errorRows.resize(0);
+    removedErrors = 0;
+    errorIndex.clear();
+    duplicateErrors.clear();
+    strings.clear();
+}
+
+EventStore::Range EventStore::rows(EventFilter filter) const
+{
+    //start past the end of any kind the filter excludes
+    qsizetype eventStart = (filter == ALL || filter == EVENTS) ? 0 : eventRows.size();
+    qsizetype errorStart = (filter == EVENTS) ? errorRows.size() : 0;
+
+    return Range(const_iterator(this, filter, eventStart, errorStart, eventRows.size(), errorRows.size()),
+                 const_iterator(this, filter, eventRows.size(), errorRows.size(), eventRows.size(), errorRows.size()));
+}
+
+/**
+ * @brief Finds the rows within a time window
+ *
+ * Both kinds are binary searched on their time stamps, so the cost does not depend on
+ * how many rows fall outside the window.
+ *
+ * @param filter Kinds of rows to include
+ * @param fromMs Earliest time stamp to include, in milliseconds
+ * @param toMs Latest time stamp to include, in milliseconds
+ */
+EventStore::Range EventStore::rows(EventFilter filter, qint64 fromMs, qint64 toMs) const
+{
+    auto lower = [this](qint32 row, qint64 ms) { return timesMs[row] < ms; };
+    auto upper = [this](qint64 ms, qint32 row) { return ms < timesMs[row]; };
+
+    qsizetype eventStart = std::lower_bound(eventRows.cbegin(), eventRows.cend(), fromMs, lower) - eventRows.cbegin();
+    qsizetype eventEnd = std::upper_bound(eventRows.cbegin() + eventStart, eventRows.cend(), toMs, upper) - eventRows.cbegin();
+    qsizetype errorStart = std::lower_bound(errorRows.cbegin(), errorRows.cend(), fromMs, lower) - errorRows.cbegin();
+    qsizetype errorEnd = std::upper_bound(errorRows.cbegin() + errorStart, errorRows.cend(), toMs, upper) - errorRows.cbegin();
+
+    //start at the end of any kind the filter excludes
+    if (filter != ALL && filter != EVENTS)
+    {
+        eventStart = eventEnd;
+    }
+    if (filter == EVENTS)
+    {
+        errorStart = errorEnd;
+    }
+
+    return Range(const_iterator(this, filter, eventStart, errorStart, eventEnd, errorEnd),
+                 const_iterator(this, filter, eventEnd, errorEnd, eventEnd, errorEnd));
+}
+
+EventRecord EventStore::lastEvent() const
+{
+    return eventRows.isEmpty() ? EventRecord() : EventRecord(this, eventRows.last());
+}
+
+EventRecord EventStore::lastError() const
+{
+    //skip errors removed since the last compaction
+    for (qsizetype pos = errorRows.size() - 1; pos >= 0; pos--)
+    {
+        if (!isRemoved(errorRows[pos]))
+        {
+            return EventRecord(this, errorRows[pos]);
+        }
+    }
+
+    return EventRecord();
+}
+
+/**
+ * @brief Finds an error by its position among the stored errors
+ *
+ * Positions only need to be counted past removed errors when some are waiting to be
+ * compacted, which only happens in the controller simulator.
+ *
+ * @param pos Position of the error, from 0 to errorCount() - 1
+ */
+EventRecord EventStore::error(qsizetype pos) const
+{
+    if (removedErrors == 0)
+    {
+        return EventRecord(this, errorRows[pos]);
+    }
+
+    for (qint32 errorRow : errorRows)
+    {
+        if (!isRemoved(errorRow) && pos-- == 0)
+        {
+            return EventRecord(this, errorRow);
+        }
+    }
+
+    return EventRecord();
+}
+
+/**
+ * @brief Looks up a stored error by id in constant time
+ *
+ * @param id The identification number of the error
+ * @return Record of the error, null if no stored error has this id
+ */
+EventRecord EventStore::findError(int id) const
+{
+    auto it = errorIndex.constFind(id);
+
+    return it == errorIndex.cend() ? EventRecord() : EventRecord(this, it.value());
+}
+
+/**
+ * @brief Gives back the time stamp text of a row as the controller sent it
+ */
+QString EventStore::timeStamp(qsizetype row) const
+{
+    quint16 format = timeStampFormats[row];
+    if (format == 0)
+    {
+        return irregularTimeStamps.value(static_cast<qint32>(row));
+    }
+
+    qint64 msecs = timesMs[row];
+
+    return QString("%1:%2:%3:%4")
+        .arg(msecs / 3600000, format & 0xF, 10, QChar('0'))
+        .arg((msecs / 60000) % 60, (format >> 4) & 0xF, 10, QChar('0'))
+        .arg((msecs / 1000) % 60, (format >> 8) & 0xF, 10, QChar('0'))
+        .arg(msecs % 1000, (format >> 12) & 0xF, 10, QChar('0'));
+}
+
+/**
+ * @brief Finds the digit count of each field of a time stamp
+ *
+ * Most time stamps are digits only, with fields in range (i.e. 1:02:03:004), so the
+ * text is given by the milliseconds and the digit count of each field.
+ *
+ * @param timeMs Time stamp in milliseconds
+ * @param timeStamp Text the time stamp was parsed from
+ * @return Digit counts, 4 bits per field with the hours in the low bits, or 0 if the
+ * text has anything else in it (i.e. spaces or minutes past 59)
+ */
+quint16 EventStore::timeStampFormat(qint64 timeMs, QByteArrayView timeStamp)
+{
+    //value of each field when the text is rebuilt from the milliseconds
+    const qint64 values[4] = {timeMs / 3600000, (timeMs / 60000) % 60, (timeMs / 1000) % 60, timeMs % 1000};
+
+    quint16 format = 0;
+    int field = 0;
+    int digits = 0;
+    qint64 value = 0;
+
+    for (qsizetype pos = 0; pos <= timeStamp.size(); pos++)
+    {
+        //end of a field
+        if (pos == timeStamp.size() || timeStamp[pos] == ':')
+        {
+            if (field == 4 || digits == 0 || value != values[field])
+            {
+                return 0;
+            }
+
+            format |= static_cast<quint16>(digits << (4 * field));
+            field++;
+            digits = 0;
+            value = 0;
+        }
+        //15 digits fit in 4 bits and can not overflow the value
+        else if (timeStamp[pos] >= '0' && timeStamp[pos] <= '9' && digits < 15)
+        {
+            value = value * 10 + (timeStamp[pos] - '0');
+            digits++;
+        }
+        else
+        {
+            return 0;
+        }
+    }
+
+    return field == 4 ? format : 0;
+}
+
+void EventStore::setCleared(qsizetype row)
+{
+    flags[row] |= CLEARED_ROW;
+}
+
+qsizetype EventStore::bytesReserved() const
+{
+    return ids.capacity() * static_cast<qsizetype>(sizeof(qint32))
+           + timesMs.capacity() * static_cast<qsizetype>(sizeof(qint64))
+           + flags.capacity() * static_cast<qsizetype>(sizeof(quint8))
+           + eventStringRefs.capacity() * static_cast<qsizetype>(sizeof(qint32))
+           + timeStampFormats.capacity() * static_cast<qsizetype>(sizeof(quint16))
+           + eventRows.capacity() * static_cast<qsizetype>(sizeof(qint32))
+           + errorRows.capacity() * static_cast<qsizetype>(sizeof(qint32))
+           + (errorIndex.capacity() + duplicateErrors.capacity()) * static_cast<qsizetype>(sizeof(int) + sizeof(qint32))
+           + strings.bytesReserved();
+}
@@ -0,0 +1,229 @@
+#ifndef EVENTSTORE_H
+#define EVENTSTORE_H
+
+#include <QString>
+#include <QByteArrayView>
+#include <QVector>
+#include <QHash>
+#include <QMultiHash>
+#include <iterator>
+#include "constants.h"
+
+/********************************************************************************
+** eventstore.h
+**
+** The EventStore class holds every event and error of a session as columns
+** (structure of arrays) rather than as linked nodes. Each row is an id, a time
+** stamp in milliseconds, a kind/cleared bitfield and a reference into a string pool, so
+** iterating or filtering a session reads a few contiguous arrays instead of
+** chasing pointers across the heap. Event messages repeat constantly, so their
+** text is interned and every row only stores a reference to it. The time stamp text
+** read from the controller is given back byte for byte: rows keep the digit count of
+** each of its fields and rebuild it from the milliseconds, and the few time stamps
+** that can not be rebuilt that way are kept as text.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Stores strings back to back in a single buffer
+ *
+ * Strings are referred to by index. Interned strings are stored once no matter
+ * how many times they are added.
+ */
+class StringPool
+{
+public:
+    StringPool();
+
+    // adds string to the pool if it is not already there, returns its reference
+    qint32 intern(QStringView string);
+
+    // adds string to the pool without checking for an existing copy
+    qint32 append(QStringView string);
+
+    // returns the string with the given reference, the view is invalidated by the next add
+    QStringView view(qint32 ref) const;
+
+    // removes every string, the buffers are kept for reuse
+    void clear();
+
+    // bytes reserved by the pool's buffers
+    qsizetype bytesReserved() const;
+
+private:
+    QString chars; // every string in the pool, back to back
+    QVector<qsizetype> offsets; // start of string i is offsets[i], its end is offsets[i+1]
+    QMultiHash<size_t, qint32> internedRefs; // hash of an interned string -> its reference
+};
+
+class EventStore;
+
+/**
+ * @brief Read only handle to one row of an EventStore
+ *
+ * Records are small values that are cheap to copy. Fields are read from the store
+ * when requested, so a record reflects changes made after it was created (i.e. an
+ * error being cleared). Records are invalidated when the store is cleared.
+ */
+class EventRecord
+{
+public:
+    // null record, refers to no row
+    EventRecord();
+    EventRecord(const EventStore *store, qsizetype row);
+
+    bool isNull() const { return store == nullptr; }
+    qsizetype row() const { return rowIndex; }
+
+    int id() const;
+    qint64 timeMs() const;
+    QString timeStamp() const;
+    QString eventString() const;
+    bool isError() const;
+    bool isCleared() const;
+
+private:
+    const EventStore *store;
+    qsizetype rowIndex;
+};
+
+class EventStore
+{
+public:
+    // iterates rows allowed by an EventFilter in time stamp order
+    class const_iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = EventRecord;
+        using difference_type = qsizetype;
+        using pointer = void;
+        using reference = EventRecord;
+
+        EventRecord operator*() const;
+        const_iterator &operator++();
+        bool operator==(const const_iterator &other) const;
+        bool operator!=(const const_iterator &other) const { return !(*this == other); }
+
+    private:
+        friend class EventStore;
+        const_iterator(const EventStore *store, EventFilter filter, qsizetype eventPos, qsizetype errorPos,
+                       qsizetype eventEnd, qsizetype errorEnd);
+
+        // true if the next row comes from the events rather than the errors
+        bool eventIsNext() const;
+
+        // moves errorPos past errors that the filter does not allow
+        void skipFilteredErrors();
+
+        const EventStore *store;
+        EventFilter filter;
+        qsizetype eventPos; // position in eventRows
+        qsizetype errorPos; // position in errorRows
+        qsizetype eventEnd; // end of the iterated eventRows
+        qsizetype errorEnd; // end of the iterated errorRows
+    };
+
+    // rows allowed by a filter, usable in range based for loops
+    class Range
+    {
+    public:
+        const_iterator begin() const { return first; }
+        const_iterator end() const { return last; }
+
+    private:
+        friend class EventStore;
+        Range(const_iterator first, const_iterator last) : first(first), last(last) {}
+
+        const_iterator first;
+        const_iterator last;
+    };
+
+    EventStore();
+
+    // adds a row, returns a record for it. timeStamp is the text timeMs was parsed from
+    EventRecord append(int id, qint64 timeMs, QByteArrayView timeStamp, QStringView eventString,
+                       bool isError, bool cleared);
+
+    // removes an error from iteration in amortized constant time, its row is reclaimed
+    // on the next clear
+    void removeError(qsizetype row);
+
+    // removes every row, the columns are kept for reuse
+    void clear();
+
+    // all rows allowed by filter, in time stamp order (ALL merges events and errors)
+    Range rows(EventFilter filter) const;
+
+    // rows allowed by filter with fromMs <= time stamp <= toMs, in time stamp order.
+    // rows of each kind must have been added in time stamp order
+    Range rows(EventFilter filter, qint64 fromMs, qint64 toMs) const;
+
+    // number of rows ever added since the last clear, including removed errors
+    int rowCount() const { return static_cast<int>(ids.size()); }
+
+    // events and errors in the order they were added to their kind, removed errors
+    // are not counted
+    int eventCount() const { return static_cast<int>(eventRows.size()); }
+    int errorCount() const { return static_cast<int>(errorRows.size() - removedErrors); }
+    EventRecord event(qsizetype pos) const { return EventRecord(this, eventRows[pos]); }
+    EventRecord error(qsizetype pos) const;
+
+    // most recently added event or error, null if there are none
+    EventRecord lastEvent() const;
+    EventRecord lastError() const;
+
+    // error with the given id, null if it is not stored. if several stored errors share
+    // an id, the first one added is returned
+    EventRecord findError(int id) const;
+
+    // row accessors
+    int id(qsizetype row) const { return ids[row]; }
+    qint64 timeMs(qsizetype row) const { return timesMs[row]; }
+    QString timeStamp(qsizetype row) const;
+    QString eventString(qsizetype row) const { return strings.view(eventStringRefs[row]).toString(); }
+    bool isError(qsizetype row) const { return flags[row] & ERROR_ROW; }
+    bool isCleared(qsizetype row) const { return flags[row] & CLEARED_ROW; }
+    bool isRemoved(qsizetype row) const { return flags[row] & REMOVED_ROW; }
+
+    // row modifiers
+    void setCleared(qsizetype row);
+
+    // bytes reserved by the columns and string pool
+    qsizetype bytesReserved() const;
+
+private:
+    // bits of the flags column
+    enum RowFlag : quint8 { ERROR_ROW = 0x1, CLEARED_ROW = 0x2, REMOVED_ROW = 0x4 };
+
+    // digit count of each field of a time stamp, 4 bits per field with the hours in the
+    // low bits. returns 0 if the text can not be rebuilt from timeMs and those counts
+    static quint16 timeStampFormat(qint64 timeMs, QByteArrayView timeStamp);
+
+    // columns, one entry per row
+    QVector<qint32> ids;
+    QVector<qint64> timesMs;
+    QVector<quint8> flags;
+    QVector<qint32> eventStringRefs;
+    QVector<quint16> timeStampFormats;
+
+    // row -> time stamp text of the rows with a time stamp format of 0
+    QHash<qint32, QString> irregularTimeStamps;
+
+    // rows of each kind, in the order they were added. removed errors stay in errorRows
+    // until they make up half of it
+    QVector<qint32> eventRows;
+    QVector<qint32> errorRows;
+    qsizetype removedErrors;
+
+    // error id -> row of the first error added with that id, kept in sync by append,
+    // removeError and clear. later errors sharing an id wait in duplicateErrors
+    QHash<int, qint32> errorIndex;
+    QMultiHash<int, qint32> duplicateErrors;
+
+    // event text of every row
+    StringPool strings;
+};
+
+#endif // EVENTSTORE_H
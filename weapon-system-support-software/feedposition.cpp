@@ -24,32 +24,30 @@ feedposition::feedposition(QWidget* parent)
 }
 
 /**
- * @brief Paints the feed position graphic
+ * @brief Renders the parts of the feed position graphic that do not depend on its value
+ *
+ * The background is drawn once into a pixmap and reused by every paint until the
+ * size or pixel ratio of the dial change.
+ *
+ * @param dialSize Width and height of the dial
+ * @param pixelRatio Device pixel ratio of the screen showing the dial
  */
-void feedposition::paintEvent(QPaintEvent*)
+void feedposition::renderBackground(int dialSize, qreal pixelRatio)
 {
     //variables
     int startAngle;
     int index;
-    int dialSize;
 
-    if(QDial::height() > QDial::width())
-    {
-        dialSize = QDial::width();
-    }
-    else
-    {
-        dialSize = QDial::height();
-    }
     //arc length of the dial background
     int spanAngle = (360/NUM_FEED_POSITION) * 16;
 
-    //dial value
-    int value = QDial::value();
+    //pixmap matching the screen's pixels, transparent outside the dial
+    background = QPixmap(QSize(dialSize, dialSize) * pixelRatio);
+    background.setDevicePixelRatio(pixelRatio);
+    background.fill(Qt::transparent);
 
     //painter object
-    QPainter painter(this);
-    QPen text = painter.pen();
+    QPainter painter(&background);
 
     // Smooth out the circle
     painter.setRenderHint(QPainter::Antialiasing);
@@ -114,14 +112,61 @@ void feedposition::paintEvent(QPaintEvent*)
     //draws center circle to match program background
     painter.drawEllipse(QPointF(dialSize/2, dialSize/2), dialSize/3, dialSize/3);
 
-    //area of the needle
-    QRectF needle(dialSize/8, dialSize/8, dialSize/1.33, dialSize/1.33);
-
     //change brush color
     painter.setBrush(QBrush(QColor(255, 255, 255))); // #FFFFFF color represented by RGB integers
 
     //draws knob for the needle
     painter.drawEllipse(QPointF(dialSize/2, dialSize/2), dialSize/10, dialSize/10);
+}
+
+/**
+ * @brief Paints the feed position graphic
+ *
+ * Only the needle and value are drawn on each paint, the rest comes from the cached
+ * background.
+ */
+void feedposition::paintEvent(QPaintEvent*)
+{
+    int dialSize;
+
+    if(QDial::height() > QDial::width())
+    {
+        dialSize = QDial::width();
+    }
+    else
+    {
+        dialSize = QDial::height();
+    }
+
+    //dial value
+    int value = QDial::value();
+
+    //render the background again if the dial changed
+    qreal pixelRatio = devicePixelRatioF();
+    if (background.isNull() || background.deviceIndependentSize() != QSizeF(dialSize, dialSize)
+        || background.devicePixelRatio() != pixelRatio)
+    {
+        renderBackground(dialSize, pixelRatio);
+    }
+
+    //painter object
+    QPainter painter(this);
+    QPen text = painter.pen();
+
+    //draws the cached background
+    painter.drawPixmap(0, 0, background);
+
+    // Smooth out the needle
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // No border around painted objects
+    painter.setPen(QPen(Qt::NoPen));
+
+    //area of the needle
+    QRectF needle(dialSize/8, dialSize/8, dialSize/1.33, dialSize/1.33);
+
+    //change brush color
+    painter.setBrush(QBrush(QColor(255, 255, 255))); // #FFFFFF color represented by RGB integers
 
     //draws the needle
     painter.drawPie(needle, -(value - 90) * 16, 3 * 16);
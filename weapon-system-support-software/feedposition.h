@@ -3,6 +3,7 @@
 
 #include <QDial>
 #include <QPainter>
+#include <QPixmap>
 #include <QColor>
 #include <QToolTip>
 #include <QEvent>
@@ -24,5 +25,11 @@ private:
     virtual void paintEvent(QPaintEvent*) override;
     bool event(QEvent* event) override;
 
+    // draws the parts of the graphic that do not depend on the value into background
+    void renderBackground(int dialSize, qreal pixelRatio);
+
+    // pie slices, center circle and needle knob, rendered again when the size or pixel
+    // ratio change
+    QPixmap background;
 };
 #endif // FEEDPOSITION_H
@@ -28,16 +28,23 @@ firemode::firemode(QWidget* parent)
 }
 
 /**
- * @brief Paints the firemode graphic
+ * @brief Renders the parts of the firemode graphic that do not depend on its value
+ *
+ * The background is drawn once into a pixmap and reused by every paint until the
+ * size or pixel ratio of the dial change.
+ *
+ * @param height Height of the dial, every part of the graphic is scaled to it
+ * @param pixelRatio Device pixel ratio of the screen showing the dial
  */
-void firemode::paintEvent(QPaintEvent*)
+void firemode::renderBackground(int height, qreal pixelRatio)
 {
-    //dial value
-    int value = QDial::value();
+    //pixmap matching the screen's pixels, transparent outside the graphic
+    background = QPixmap(size() * pixelRatio);
+    background.setDevicePixelRatio(pixelRatio);
+    background.fill(Qt::transparent);
 
     //painter object
-    QPainter painter(this);
-    QPen text = painter.pen();
+    QPainter painter(&background);
     QPen lines = painter.pen();
 
     // Smooth out the circle
@@ -54,52 +61,91 @@ void firemode::paintEvent(QPaintEvent*)
     painter.setBrush(QBrush(QColor(27,27,27)));
 
     //sets the area for the outline and background
-    QRectF outlineArea(-QDial::height()/14, QDial::height()/22, QDial::height()*1.55, QDial::height()*1.55);
+    QRectF outlineArea(-height/14, height/22, height*1.55, height*1.55);
 
     //draws the outline
     painter.drawPie(outlineArea, -(62.5-90)*16, 125*16);
-    painter.drawLine(QDial::height()/1.44, QDial::height()/20,QDial::height()/1.44,QDial::height()/4.5);
-    //painter.drawLine(QDial::height()/5.2, QDial::height()/4,QDial::height()/3,QDial::height()/2.7);
-
+    painter.drawLine(height/1.44, height/20,height/1.44,height/4.5);
 
     // No border
     painter.setPen(QPen(Qt::NoPen));
 
-    //area of the needle
-    QRectF needleArea(QDial::height()/4.31,  QDial::height()/3.2, QDial::height()/1.05, QDial::height()/1.05);
-
     //change brush color
     painter.setBrush(QBrush(QColor(255, 255, 255))); // #FFFFFF color represented by RGB integers
 
     //draws knob for the needle
-    painter.drawEllipse(QPointF(QDial::height()/1.414,QDial::height()/1.28),QDial::height()/15,QDial::height()/15);
-
-    //draws the needle
-    painter.drawPie(needleArea, -(value-90)*16, 3*16);
-
-    //setting text
-    painter.setPen(text);
+    painter.drawEllipse(QPointF(height/1.414,height/1.28),height/15,height/15);
 
     //sets pen color for text
     painter.setPen(QPen(QColor(255, 255, 255))); // White color represented by RGB integers
 
-    //Initilize text font
-    QFont textfont = painter.font();
+    //Initilize text font from the widget, the pixmap has no font of its own
+    QFont textfont = font();
 
     //set font size
-    textfont.setPixelSize(QDial::height()/10);
+    textfont.setPixelSize(height/10);
 
     //set painter font
     painter.setFont(textfont);
 
     //draws text
-    painter.drawText(QDial::height()/13,QDial::height()/3,QDial::height(),QDial::height(),0,"Safe");
+    painter.drawText(height/13,height/3,height,height,0,"Safe");
 
-    painter.drawText(QDial::height()/3.5,QDial::height()/6.7,QDial::height(),QDial::height(),0,"Single");
+    painter.drawText(height/3.5,height/6.7,height,height,0,"Single");
 
-    painter.drawText(QDial::height()/1.2,QDial::height()/6.7,QDial::height(),QDial::height(),0,"Burst");
+    painter.drawText(height/1.2,height/6.7,height,height,0,"Burst");
 
-    painter.drawText(QDial::height()*1.13,QDial::height()/3,QDial::height(),QDial::height(),0,"Auto");
+    painter.drawText(height*1.13,height/3,height,height,0,"Auto");
+}
+
+/**
+ * @brief Paints the firemode graphic
+ *
+ * Only the needle and the selected mode are drawn on each paint, the rest comes from
+ * the cached background.
+ */
+void firemode::paintEvent(QPaintEvent*)
+{
+    //dial value
+    int value = QDial::value();
+
+    //render the background again if the dial changed
+    qreal pixelRatio = devicePixelRatioF();
+    if (background.isNull() || background.deviceIndependentSize() != QSizeF(size())
+        || background.devicePixelRatio() != pixelRatio)
+    {
+        renderBackground(QDial::height(), pixelRatio);
+    }
+
+    //painter object
+    QPainter painter(this);
+
+    //draws the cached background
+    painter.drawPixmap(0, 0, background);
+
+    // Smooth out the needle
+    painter.setRenderHint(QPainter::Antialiasing);
+
+    // No border
+    painter.setPen(QPen(Qt::NoPen));
+
+    //area of the needle
+    QRectF needleArea(QDial::height()/4.31,  QDial::height()/3.2, QDial::height()/1.05, QDial::height()/1.05);
+
+    //change brush color
+    painter.setBrush(QBrush(QColor(255, 255, 255))); // #FFFFFF color represented by RGB integers
+
+    //draws the needle
+    painter.drawPie(needleArea, -(value-90)*16, 3*16);
+
+    //Initilize text font
+    QFont textfont = painter.font();
+
+    //set font size
+    textfont.setPixelSize(QDial::height()/10);
+
+    //set painter font
+    painter.setFont(textfont);
 
     //set paint color for highlighted text
     painter.setPen(QPen(QColor(255, 133, 51))); // #ff8533 color represented by RGB integers
@@ -125,4 +171,3 @@ void firemode::paintEvent(QPaintEvent*)
     //disable user edits on the needle
     setDisabled(true);
 }
-
@@ -4,6 +4,7 @@
 #include <QDial>
 #include <QMouseEvent>
 #include <QPainter>
+#include <QPixmap>
 #include <QColor>
 
 class firemode : public QDial
@@ -18,5 +19,11 @@ private:
     // firemode graphic painter
     virtual void paintEvent(QPaintEvent*) override;
 
+    // draws the parts of the graphic that do not depend on the value into background
+    void renderBackground(int height, qreal pixelRatio);
+
+    // outline, needle knob and mode names, rendered again when the size or pixel ratio
+    // change
+    QPixmap background;
 };
 #endif // FIREMODE_H
@@ -0,0 +1,311 @@
+#include "latencytracker.h"
+//this file wont compile if dev mode is inactive
+#if DEV_MODE
+#include <QDebug>
+#include <QFile>
+#include <QtMath>
+#include <limits>
+
+/********************************************************************************
+** latencytracker.cpp
+**
+** This file implements the ingest latency histograms.
+**
+** @author Team Controller
+********************************************************************************/
+
+// each power of two range is split into 2^(SUB_BUCKET_BITS - 1) buckets, latencies are
+// tracked up to 2^MAX_MAGNITUDE nanoseconds (about 18 minutes)
+static const int SUB_BUCKET_BITS = 7;
+static const int SUB_BUCKETS = 1 << SUB_BUCKET_BITS;
+static const int HALF_SUB_BUCKETS = SUB_BUCKETS / 2;
+static const int MAX_MAGNITUDE = 40;
+
+// names of the message types and stages shown in the report
+static const char *MESSAGE_TYPE_NAMES[] = {"EVENT_DUMP", "ERROR_DUMP", "ELECTRICAL", "EVENT", "ERROR", "STATUS",
+                                           "CLEAR_ERROR", "LISTENING", "BEGIN", "CLOSING_CONNECTION", "UNRECOGNIZED"};
+static const char *STAGE_NAMES[] = {"read", "framed", "decoded", "queued", "stored", "logqueued", "rendered", "total"};
+
+/**
+ * @brief Constructor, the buckets are allocated by the first record
+ */
+LatencyHistogram::LatencyHistogram()
+{
+    reset();
+}
+
+/**
+ * @brief Counts a latency
+ *
+ * @param nsecs The latency in nanoseconds
+ */
+void LatencyHistogram::record(qint64 nsecs)
+{
+    if (counts.isEmpty())
+    {
+        counts.fill(0, bucketCount());
+    }
+
+    nsecs = qMax<qint64>(nsecs, 0);
+    counts[bucketIndex(nsecs)]++;
+
+    total++;
+    sumNsecs += nsecs;
+    minNsecs = qMin(minNsecs, nsecs);
+    maxNsecs = qMax(maxNsecs, nsecs);
+}
+
+/**
+ * @brief Drops every counted latency, the buckets are kept for reuse
+ */
+void LatencyHistogram::reset()
+{
+    counts.fill(0);
+
+    total = 0;
+    sumNsecs = 0;
+    minNsecs = std::numeric_limits<qint64>::max();
+    maxNsecs = 0;
+}
+
+/**
+ * @brief Finds the latency that percent of the counted latencies are at or below
+ *
+ * @param percent The percentile, from 0 to 100
+ * @return The highest latency of the bucket holding the percentile (never above the
+ *         highest counted latency), 0 if nothing was counted
+ */
+qint64 LatencyHistogram::percentile(double percent) const
+{
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    qint64 target = qBound<qint64>(1, qCeil(percent / 100.0 * total), total);
+    qint64 counted = 0;
+
+    for (int i = 0; i < counts.size(); i++)
+    {
+        counted += counts[i];
+
+        if (counted >= target)
+        {
+            return qMin(bucketHighest(i), maxNsecs);
+        }
+    }
+
+    return maxNsecs;
+}
+
+int LatencyHistogram::bucketCount()
+{
+    return (MAX_MAGNITUDE - SUB_BUCKET_BITS + 1) * HALF_SUB_BUCKETS + HALF_SUB_BUCKETS;
+}
+
+/**
+ * @brief Lowest latency counted by a bucket
+ *
+ * The first SUB_BUCKETS buckets count a single nanosecond each. After that every power
+ * of two range has HALF_SUB_BUCKETS buckets, each twice as wide as in the range before.
+ */
+qint64 LatencyHistogram::bucketLowest(int index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+
+    int shift = index / HALF_SUB_BUCKETS - 1;
+    return static_cast<qint64>(index - shift * HALF_SUB_BUCKETS) << shift;
+}
+
+int LatencyHistogram::bucketIndex(qint64 nsecs)
+{
+    nsecs = qMin(nsecs, (Q_INT64_C(1) << MAX_MAGNITUDE) - 1);
+
+    if (nsecs < SUB_BUCKETS)
+    {
+        return static_cast<int>(nsecs);
+    }
+
+    //scale the latency so its top SUB_BUCKET_BITS bits pick the bucket within its range
+    int highestBit = 63 - qCountLeadingZeroBits(static_cast<quint64>(nsecs));
+    int shift = highestBit - (SUB_BUCKET_BITS - 1);
+
+    return shift * HALF_SUB_BUCKETS + static_cast<int>(nsecs >> shift);
+}
+
+//======================================================================================
+// LatencyTracker
+//======================================================================================
+
+LatencyTracker::LatencyTracker()
+    : frames(0)
+{
+}
+
+/**
+ * @brief Records a frame the gui has handled
+ *
+ * @param messageType The frame's message id, -1 if it had none
+ * @param timestamps The time the frame reached each stage so far
+ * @param awaitingRender True if the frame changed something shown by the next render
+ */
+void LatencyTracker::frameHandled(int messageType, const FrameTimestamps &timestamps, bool awaitingRender)
+{
+    if (awaitingRender)
+    {
+        waitingFrames.append(qMakePair(messageType, timestamps));
+    }
+    else
+    {
+        record(messageType, timestamps);
+    }
+}
+
+/**
+ * @brief Records every frame shown by the render that just finished
+ */
+void LatencyTracker::rendered()
+{
+    FrameTimestamps renderTime;
+    renderTime.mark(STAGE_RENDERED);
+
+    for (QPair<int, FrameTimestamps> &frame : waitingFrames)
+    {
+        frame.second.nsecs[STAGE_RENDERED] = renderTime.nsecs[STAGE_RENDERED];
+        record(frame.first, frame.second);
+    }
+
+    //keep the allocation for the next render
+    waitingFrames.resize(0);
+}
+
+void LatencyTracker::reset()
+{
+    for (LatencyHistogram (&stages)[NUM_LATENCY_STAGES + 1] : histograms)
+    {
+        for (LatencyHistogram &histogram : stages)
+        {
+            histogram.reset();
+        }
+    }
+
+    waitingFrames.clear();
+    frames = 0;
+}
+
+void LatencyTracker::record(int messageType, const FrameTimestamps &timestamps)
+{
+    //frames the reader did not stamp are skipped
+    if (timestamps.nsecs[STAGE_READ] == 0)
+    {
+        return;
+    }
+
+    if (messageType < 0 || messageType >= NUM_MESSAGE_TYPES - 1)
+    {
+        messageType = NUM_MESSAGE_TYPES - 1;
+    }
+
+    //time spent in each stage is measured from the last stage the frame reached
+    int lastStage = STAGE_READ;
+    for (int stage = STAGE_FRAMED; stage < NUM_LATENCY_STAGES; stage++)
+    {
+        if (timestamps.nsecs[stage] != 0)
+        {
+            histograms[messageType][stage].record(timestamps.nsecs[stage] - timestamps.nsecs[lastStage]);
+            lastStage = stage;
+        }
+    }
+
+    histograms[messageType][NUM_LATENCY_STAGES].record(timestamps.nsecs[lastStage] - timestamps.nsecs[STAGE_READ]);
+    frames++;
+}
+
+/**
+ * @brief Creates a table of the latencies of each stage per message type
+ *
+ * @return One row per stage reached by each message type received, in microseconds
+ */
+QString LatencyTracker::report() const
+{
+    QString report = QString::asprintf("Ingest latency in microseconds, %lld frames\n\n", frames);
+    report += QString::asprintf("%-19s %-9s %10s %10s %10s %10s %10s %10s %10s %10s\n", "message", "stage",
+                                "count", "min", "p50", "p90", "p99", "p99.9", "max", "mean");
+
+    for (int type = 0; type < NUM_MESSAGE_TYPES; type++)
+    {
+        if (histograms[type][NUM_LATENCY_STAGES].count() == 0)
+        {
+            continue;
+        }
+
+        for (int stage = STAGE_FRAMED; stage <= NUM_LATENCY_STAGES; stage++)
+        {
+            const LatencyHistogram &histogram = histograms[type][stage];
+
+            if (histogram.count() == 0)
+            {
+                continue;
+            }
+
+            report += QString::asprintf("%-19s %-9s %10lld %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n",
+                                        MESSAGE_TYPE_NAMES[type], STAGE_NAMES[stage], histogram.count(),
+                                        histogram.min() / 1000.0, histogram.percentile(50) / 1000.0,
+                                        histogram.percentile(90) / 1000.0, histogram.percentile(99) / 1000.0,
+                                        histogram.percentile(99.9) / 1000.0, histogram.max() / 1000.0,
+                                        histogram.mean() / 1000.0);
+        }
+
+        report += "\n";
+    }
+
+    return report;
+}
+
+/**
+ * @brief Writes the report and the buckets of every histogram to a file
+ *
+ * The buckets follow the report as comma separated lines (message type, stage, lowest
+ * and highest latency in nanoseconds, count) so the distributions can be plotted.
+ *
+ * @param fileName The file to write, its contents are replaced
+ * @return False if the file could not be written
+ */
+bool LatencyTracker::dumpToFile(const QString &fileName) const
+{
+    QFile file(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qDebug() << "Error: LatencyTracker::dumpToFile could not open " << fileName << Qt::endl;
+        return false;
+    }
+
+    QByteArray contents = report().toUtf8();
+    contents += "message,stage,lowest_ns,highest_ns,count\n";
+
+    for (int type = 0; type < NUM_MESSAGE_TYPES; type++)
+    {
+        for (int stage = STAGE_FRAMED; stage <= NUM_LATENCY_STAGES; stage++)
+        {
+            const LatencyHistogram &histogram = histograms[type][stage];
+
+            for (int i = 0; histogram.count() > 0 && i < LatencyHistogram::bucketCount(); i++)
+            {
+                if (histogram.bucket(i) > 0)
+                {
+                    contents += QByteArray(MESSAGE_TYPE_NAMES[type]) + ',' + STAGE_NAMES[stage] + ','
+                                + QByteArray::number(LatencyHistogram::bucketLowest(i)) + ','
+                                + QByteArray::number(LatencyHistogram::bucketHighest(i)) + ','
+                                + QByteArray::number(histogram.bucket(i)) + '\n';
+                }
+            }
+        }
+    }
+
+    return file.write(contents) == contents.size();
+}
+#endif
@@ -0,0 +1,133 @@
+#ifndef LATENCYTRACKER_H
+#define LATENCYTRACKER_H
+#if DEV_MODE
+#include <QString>
+#include <QVector>
+#include <chrono>
+#include "constants.h"
+
+/********************************************************************************
+** latencytracker.h
+**
+** Latency diagnostics for the DDM's ingest path. Each frame carries the monotonic
+** time it reached every stage of the path, from the reader thread being woken for
+** its bytes to the render that shows it. The serial reader thread stamps the read,
+** framed and decoded stages and the GUI thread stamps the rest.
+**
+** Once a frame is shown (or handled, for frames that change nothing on screen) the
+** LatencyTracker records the time spent in each stage, and from read to the last
+** stage reached, in a LatencyHistogram per message type. A stage a frame skips (i.e.
+** a status message is not logged unless advanced log files are enabled) is counted
+** in the next stage the frame reaches. The log queued stage is stamped when the log
+** line is handed to the LogWriter, it is written to disk later on the writer thread.
+**
+** @author Team Controller
+********************************************************************************/
+
+// stages of the ingest path, in the order a frame reaches them
+enum LatencyStage {STAGE_READ=0, STAGE_FRAMED=1, STAGE_DECODED=2, STAGE_DEQUEUED=3,
+                   STAGE_STORED=4, STAGE_LOG_QUEUED=5, STAGE_RENDERED=6, NUM_LATENCY_STAGES=7};
+
+/**
+ * @brief Time a frame reached each stage of the ingest path
+ */
+struct FrameTimestamps
+{
+    qint64 nsecs[NUM_LATENCY_STAGES] = {}; // monotonic time in nanoseconds, 0 if not reached
+
+    // stamps the current time for stage
+    void mark(LatencyStage stage)
+    {
+        nsecs[stage] = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+};
+
+/**
+ * @brief Histogram of latencies with a bounded relative error
+ *
+ * Like an HdrHistogram, every power of two range is split into the same number of
+ * linear buckets, so any latency from a nanosecond to about 18 minutes is kept within
+ * about 1.5% using a fixed number of counters. Longer latencies are counted in the
+ * last bucket.
+ */
+class LatencyHistogram
+{
+public:
+    LatencyHistogram();
+
+    // counts a latency in nanoseconds
+    void record(qint64 nsecs);
+
+    void reset();
+
+    qint64 count() const { return total; }
+    qint64 min() const { return total > 0 ? minNsecs : 0; }
+    qint64 max() const { return maxNsecs; }
+    double mean() const { return total > 0 ? static_cast<double>(sumNsecs) / total : 0; }
+
+    // latency that percent of the counted latencies are at or below
+    qint64 percentile(double percent) const;
+
+    // number of buckets and the range of latencies each one counts
+    static int bucketCount();
+    static qint64 bucketLowest(int index);
+    static qint64 bucketHighest(int index) { return bucketLowest(index + 1) - 1; }
+
+    // count of a bucket, 0 for every bucket until a latency is recorded
+    qint64 bucket(int index) const { return counts.isEmpty() ? 0 : counts[index]; }
+
+private:
+    static int bucketIndex(qint64 nsecs);
+
+    // allocated by the first record, most message types never use most stages
+    QVector<qint64> counts;
+
+    qint64 total;
+    qint64 minNsecs;
+    qint64 maxNsecs;
+    qint64 sumNsecs;
+};
+
+class LatencyTracker
+{
+public:
+    LatencyTracker();
+
+    // records a frame the gui has handled. a frame that changed something on screen
+    // waits for rendered() before it is recorded
+    void frameHandled(int messageType, const FrameTimestamps &timestamps, bool awaitingRender);
+
+    // stamps the render stage of every frame waiting for the render and records them
+    void rendered();
+
+    // drops every recorded latency
+    void reset();
+
+    // number of frames recorded
+    qint64 frameCount() const { return frames; }
+
+    // table of the latencies of each stage per message type, in microseconds
+    QString report() const;
+
+    // writes the report followed by the buckets of every histogram, returns false if
+    // the file could not be written
+    bool dumpToFile(const QString &fileName) const;
+
+private:
+    // records the time spent in each stage of a frame
+    void record(int messageType, const FrameTimestamps &timestamps);
+
+    // message ids have their own histograms, frames without an id share the last row.
+    // the last column is the time from read to the last stage the frame reached
+    static const int NUM_MESSAGE_TYPES = CLOSING_CONNECTION + 2;
+    LatencyHistogram histograms[NUM_MESSAGE_TYPES][NUM_LATENCY_STAGES + 1];
+
+    // frames shown by the next render
+    QVector<QPair<int, FrameTimestamps>> waitingFrames;
+
+    qint64 frames;
+};
+
+#endif //DEV_MODE
+#endif // LATENCYTRACKER_H
@@ -0,0 +1,233 @@
+#include "logfileloader.h"
+#include <QtConcurrent/QtConcurrent>
+
+/********************************************************************************
+** logfileloader.cpp
+**
+** This file implements loading a log file on the thread pool.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Constructor, nothing is loaded until start is called
+ */
+LogFileLoader::LogFileLoader(QObject *parent)
+    : QObject(parent), loading(nullptr), loaded(nullptr), corruptFound(false)
+{
+    connect(&watcher, &QFutureWatcher<LoadResult>::finished, this, &LogFileLoader::loadFinished);
+
+    connect(&watcher, &QFutureWatcher<LoadResult>::progressValueChanged, this, [this](int value) {
+        int chunkCount = qMax(1, watcher.progressMaximum());
+        emit progressChanged(value * 100 / chunkCount);
+    });
+}
+
+/**
+ * @brief Destructor, stops a running load
+ */
+LogFileLoader::~LogFileLoader()
+{
+    if (watcher.isRunning())
+    {
+        watcher.cancel();
+        watcher.waitForFinished();
+    }
+
+    delete loading;
+    delete loaded;
+}
+
+/**
+ * @brief Starts loading a log file on the thread pool
+ *
+ * @param logFileName The name of the log file that will be read in
+ * @return SUCCESS if the load started, DATA_NOT_FOUND if the file could not be opened
+ */
+int LogFileLoader::start(const QString &logFileName)
+{
+    if (watcher.isRunning())
+    {
+        qDebug() << "Error: LogFileLoader::start, a log file is already being loaded: " << file.fileName() << Qt::endl;
+        return DATA_NOT_FOUND;
+    }
+
+    file.close();
+    file.setFileName(logFileName);
+    contents.clear();
+    corruptText.clear();
+
+    //check if we cant open logfile for reading
+    if ( !file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Error: LogFileLoader::start could not open log file: " << logFileName << Qt::endl;
+        return DATA_NOT_FOUND;
+    }
+
+    //map the log file rather than copying it, fall back to reading it if it can not be mapped
+    QByteArrayView data;
+    uchar *mapped = (file.size() > 0) ? file.map(0, file.size()) : nullptr;
+
+    if (mapped != nullptr)
+    {
+        data = QByteArrayView(mapped, file.size());
+    }
+    else
+    {
+        contents = file.readAll();
+        data = contents;
+    }
+
+    chunks = splitChunks(data, LOG_LOADER_CHUNK_SIZE);
+
+    //ram clearing is applied once the events replace the current events
+    loading = new Events(false, 0);
+    corruptFound = false;
+
+    //chunks are parsed in parallel and merged in file order, one at a time
+    watcher.setFuture(QtConcurrent::mappedReduced<LoadResult>(
+        chunks,
+        [this](QByteArrayView chunk) { return parseChunk(chunk); },
+        [this](LoadResult &result, const ParsedChunk &chunk) { mergeChunk(result, chunk); },
+        LoadResult(),
+        QtConcurrent::OrderedReduce | QtConcurrent::SequentialReduce));
+
+    #if DEV_MODE && EVENTS_DEBUG
+    qDebug() << "Loading " << file.size() << " bytes in " << chunks.size() << " chunks from: " << logFileName;
+    #endif
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Stops the load, chunks being parsed are finished first
+ */
+void LogFileLoader::cancel()
+{
+    watcher.cancel();
+}
+
+/**
+ * @brief Hands over the events of the last successful load
+ *
+ * @return The loaded events, nullptr if there are none
+ */
+Events *LogFileLoader::takeEvents()
+{
+    Events *events = loaded;
+    loaded = nullptr;
+    return events;
+}
+
+/**
+ * @brief Splits text into chunks of whole lines
+ *
+ * Each chunk is extended past chunkSize bytes to the end of its last line, so no line
+ * is split between chunks.
+ *
+ * @param data Text to split
+ * @param chunkSize Minimum bytes in each chunk but the last
+ * @return The chunks, in order
+ */
+QVector<QByteArrayView> LogFileLoader::splitChunks(QByteArrayView data, qsizetype chunkSize)
+{
+    QVector<QByteArrayView> chunks;
+    qsizetype start = 0;
+
+    while (start < data.size())
+    {
+        qsizetype end = data.indexOf('\n', qMin(start + chunkSize, data.size()) - 1);
+        end = (end == -1) ? data.size() : end + 1;
+
+        chunks.append(data.sliced(start, end - start));
+        start = end;
+    }
+
+    return chunks;
+}
+
+/**
+ * @brief Reports the result of a load that finished or was cancelled
+ */
+void LogFileLoader::loadFinished()
+{
+    int result = SUCCESS;
+
+    if (watcher.isCanceled())
+    {
+        result = LOAD_CANCELLED;
+    }
+    else if (watcher.result().corrupt)
+    {
+        corruptText = watcher.result().corruptLine;
+        qDebug() << "Error: LogFileLoader, corrupt line: " << corruptText << Qt::endl;
+        result = INCORRECT_FORMAT;
+    }
+
+    if (result == SUCCESS)
+    {
+        delete loaded;
+        loaded = loading;
+    }
+    else
+    {
+        delete loading;
+    }
+    loading = nullptr;
+
+    //closing the file unmaps it, so chunks must not be used past this point
+    chunks.clear();
+    contents.clear();
+    file.close();
+
+    emit finished(result);
+}
+
+/**
+ * @brief Parses a chunk on a thread pool thread
+ */
+LogFileLoader::ParsedChunk LogFileLoader::parseChunk(QByteArrayView chunk)
+{
+    ParsedChunk parsed;
+
+    //the load will fail anyway, so dont parse the rest of the file
+    if (corruptFound)
+    {
+        parsed.corrupt = true;
+        return parsed;
+    }
+
+    QByteArrayView corruptLine;
+    if ( !Events::parseLogFile(chunk, parsed.nodes, corruptLine) )
+    {
+        parsed.corrupt = true;
+        parsed.corruptLine = corruptLine.toByteArray();
+        parsed.nodes.clear();
+        corruptFound = true;
+    }
+
+    return parsed;
+}
+
+/**
+ * @brief Adds the nodes of a chunk to the loading events, chunks are merged in file order
+ */
+void LogFileLoader::mergeChunk(LoadResult &result, const ParsedChunk &chunk)
+{
+    if (chunk.corrupt)
+    {
+        result.corrupt = true;
+
+        //report the first corrupt line in the file
+        if (result.corruptLine.isEmpty())
+        {
+            result.corruptLine = chunk.corruptLine;
+        }
+        return;
+    }
+
+    if (!result.corrupt)
+    {
+        loading->loadLogFileNodes(chunk.nodes);
+    }
+}
@@ -0,0 +1,96 @@
+#ifndef LOGFILELOADER_H
+#define LOGFILELOADER_H
+
+#include <QObject>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QVector>
+#include <atomic>
+#include "constants.h"
+#include "events.h"
+
+/********************************************************************************
+** logfileloader.h
+**
+** The LogFileLoader class loads a log file into a new Events object without
+** blocking the gui. The file is memory mapped and split into chunks of
+** LOG_LOADER_CHUNK_SIZE bytes that end on a line end. Chunks are parsed in parallel
+** on the global thread pool, then added to the new events in file order. Progress is
+** reported as chunks are parsed and a load can be cancelled at any time.
+**
+** @author Team Controller
+********************************************************************************/
+
+class LogFileLoader : public QObject
+{
+    Q_OBJECT
+public:
+    // constructors
+    LogFileLoader(QObject *parent = nullptr);
+    ~LogFileLoader();
+
+    // starts loading a log file, returns DATA_NOT_FOUND if it can not be opened.
+    // finished is emitted with SUCCESS, INCORRECT_FORMAT or LOAD_CANCELLED
+    int start(const QString &logFileName);
+
+    // stops the load, finished is emitted with LOAD_CANCELLED
+    void cancel();
+
+    bool isRunning() const { return watcher.isRunning(); }
+
+    // file being loaded, or last loaded
+    QString fileName() const { return file.fileName(); }
+
+    // first line that could not be parsed by the last load
+    QByteArray corruptLine() const { return corruptText; }
+
+    // events loaded by the last successful load, the caller takes ownership
+    Events *takeEvents();
+
+    // splits data into whole lines of about chunkSize bytes each
+    static QVector<QByteArrayView> splitChunks(QByteArrayView data, qsizetype chunkSize);
+
+signals:
+    void progressChanged(int percent);
+    void finished(int result);
+
+private slots:
+    void loadFinished();
+
+private:
+    // nodes parsed from a chunk
+    struct ParsedChunk
+    {
+        QVector<LogFileNode> nodes;
+        bool corrupt = false;
+        QByteArray corruptLine; // empty if the chunk was skipped after another was corrupt
+    };
+
+    // chunks merged so far, in file order
+    struct LoadResult
+    {
+        bool corrupt = false;
+        QByteArray corruptLine;
+    };
+
+    ParsedChunk parseChunk(QByteArrayView chunk);
+    void mergeChunk(LoadResult &result, const ParsedChunk &chunk);
+
+    QFile file;
+    QByteArray contents; // file contents if the file could not be mapped
+    QVector<QByteArrayView> chunks;
+
+    // events being loaded, nodes are only added by the merge
+    Events *loading;
+
+    // events of the last successful load, until taken
+    Events *loaded;
+
+    // set once a chunk is corrupt, chunks that have not started are skipped
+    std::atomic<bool> corruptFound;
+
+    QByteArray corruptText;
+    QFutureWatcher<LoadResult> watcher;
+};
+
+#endif // LOGFILELOADER_H
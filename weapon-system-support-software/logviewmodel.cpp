@@ -0,0 +1,473 @@
+#include "logviewmodel.h"
+#include "eventsmodel.h"
+#include <QDataStream>
+#include <QFileInfo>
+#include <QtConcurrent/QtConcurrent>
+
+/********************************************************************************
+** logviewmodel.cpp
+**
+** This file implements the log file index and the events page log view.
+**
+** @author Team Controller
+********************************************************************************/
+
+// identifies index files, the version changes whenever the index layout does
+static const quint32 LOG_VIEW_INDEX_MAGIC = 0x57535849; // "WSXI"
+static const quint32 LOG_VIEW_INDEX_VERSION = 1;
+
+static const QByteArray ADVANCED_LINE_BYTES = ADVANCED_LOG_FILE_INDICATOR.toUtf8();
+
+/**
+ * @brief Indexes the lines of a log file
+ *
+ * Lines are only split, not parsed. A line with a cleared status (more than 3 parts) is
+ * an error.
+ *
+ * @param data Log file text
+ * @param promise Receives progress from 0 to 100, may be nullptr
+ * @return False if the promise was cancelled
+ */
+bool LogFileIndex::build(QByteArrayView data, QPromise<LogFileIndex> *promise)
+{
+    const char delimeter = DELIMETER.at(0).toLatin1();
+    qsizetype pos = 0;
+    int percent = 0;
+
+    lineCount = 0;
+    blockStarts.clear();
+    errorLines.clear();
+
+    if (promise != nullptr)
+    {
+        promise->setProgressRange(0, 100);
+    }
+
+    while (pos < data.size())
+    {
+        qsizetype end = data.indexOf('\n', pos);
+        if (end == -1)
+        {
+            end = data.size();
+        }
+
+        QByteArrayView text = data.sliced(pos, end - pos);
+
+        //advanced log file lines are not shown
+        if (!text.startsWith(ADVANCED_LINE_BYTES))
+        {
+            if (lineCount % LOG_VIEW_INDEX_STRIDE == 0)
+            {
+                blockStarts.append(pos);
+            }
+
+            //errors have a 4th part holding their cleared status
+            qsizetype delimeterPos = -1;
+            int delimeters = 0;
+            while (delimeters < 3 && (delimeterPos = text.indexOf(delimeter, delimeterPos + 1)) != -1)
+            {
+                delimeters++;
+            }
+
+            if (delimeters == 3)
+            {
+                errorLines.append(lineCount);
+            }
+
+            lineCount++;
+        }
+
+        pos = end + 1;
+
+        //report progress each percent, checking for cancellation
+        if (promise != nullptr && pos * 100 / data.size() != percent)
+        {
+            if (promise->isCanceled())
+            {
+                return false;
+            }
+
+            percent = static_cast<int>(pos * 100 / data.size());
+            promise->setProgressValue(percent);
+        }
+    }
+
+    fileSize = data.size();
+    return true;
+}
+
+/**
+ * @brief Saves the index next to its log file
+ *
+ * @param indexFileName The name of the index file
+ * @return False if the index could not be written
+ */
+bool LogFileIndex::save(const QString &indexFileName) const
+{
+    QFile indexFile(indexFileName);
+
+    if (!indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        return false;
+    }
+
+    QDataStream out(&indexFile);
+    out << LOG_VIEW_INDEX_MAGIC << LOG_VIEW_INDEX_VERSION << fileSize << modifiedMs << lineCount
+        << blockStarts << errorLines;
+
+    return out.status() == QDataStream::Ok;
+}
+
+/**
+ * @brief Loads an index saved for a log file
+ *
+ * @param indexFileName The name of the index file
+ * @param fileSize Current size of the log file
+ * @param modifiedMs Current modification time of the log file
+ * @return False if there is no index, or it was built from a different log file
+ */
+bool LogFileIndex::load(const QString &indexFileName, qint64 fileSize, qint64 modifiedMs)
+{
+    QFile indexFile(indexFileName);
+
+    if (!indexFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    QDataStream in(&indexFile);
+    quint32 magic;
+    quint32 version;
+    in >> magic >> version >> this->fileSize >> this->modifiedMs;
+
+    //the log file changed since the index was built
+    if (in.status() != QDataStream::Ok || magic != LOG_VIEW_INDEX_MAGIC || version != LOG_VIEW_INDEX_VERSION
+        || this->fileSize != fileSize || this->modifiedMs != modifiedMs)
+    {
+        return false;
+    }
+
+    in >> lineCount >> blockStarts >> errorLines;
+
+    return in.status() == QDataStream::Ok
+           && blockStarts.size() == (lineCount + LOG_VIEW_INDEX_STRIDE - 1) / LOG_VIEW_INDEX_STRIDE;
+}
+
+//======================================================================================
+// LogViewModel
+//======================================================================================
+
+/**
+ * @brief Constructor, no log file is open
+ */
+LogViewModel::LogViewModel(QObject *parent)
+    : QAbstractListModel(parent), opened(false), filter(ALL)
+{
+    connect(&watcher, &QFutureWatcher<LogFileIndex>::finished, this, &LogViewModel::indexFinished);
+    connect(&watcher, &QFutureWatcher<LogFileIndex>::progressValueChanged, this, &LogViewModel::progressChanged);
+}
+
+/**
+ * @brief Destructor, stops indexing
+ */
+LogViewModel::~LogViewModel()
+{
+    if (watcher.isRunning())
+    {
+        watcher.cancel();
+        watcher.waitForFinished();
+    }
+}
+
+int LogViewModel::rowCount(const QModelIndex &parent) const
+{
+    //list models only have top level rows
+    if (parent.isValid() || !opened)
+    {
+        return 0;
+    }
+
+    switch (filter)
+    {
+    case ALL:
+        return index.lineCount;
+    case EVENTS:
+        return index.lineCount - static_cast<int>(index.errorLines.size());
+    case ERRORS:
+        return static_cast<int>(index.errorLines.size());
+    default:
+        return static_cast<int>(stateLines.size());
+    }
+}
+
+/**
+ * @brief Provides the text and kind of a row, read from the mapped log file
+ *
+ * Rows use the same roles as the events list, so they are drawn by the events delegate.
+ */
+QVariant LogViewModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= rowCount())
+    {
+        return QVariant();
+    }
+
+    QByteArrayView text = line(rowLine(index.row()));
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+        return QString::fromUtf8(text);
+
+    case EventsModel::KindRole:
+    {
+        LogFileNode node;
+        if (!Events::parseLogFileLine(text, node) || !node.isError)
+        {
+            return EventsModel::EVENT_ROW;
+        }
+        return node.cleared ? EventsModel::CLEARED_ERROR_ROW : EventsModel::ACTIVE_ERROR_ROW;
+    }
+
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Maps a log file and indexes it on the thread pool
+ *
+ * A saved index is used if it matches the file, otherwise the file is indexed and the
+ * index is saved for next time.
+ *
+ * @param logFileName The name of the log file to show
+ * @return SUCCESS if indexing started, DATA_NOT_FOUND if the file could not be mapped
+ */
+int LogViewModel::open(const QString &logFileName)
+{
+    if (watcher.isRunning())
+    {
+        qDebug() << "Error: LogViewModel::open, a log file is already being indexed: " << file.fileName() << Qt::endl;
+        return DATA_NOT_FOUND;
+    }
+
+    close();
+    file.setFileName(logFileName);
+
+    //the file is never copied into memory, so it must be mapped
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Error: LogViewModel::open could not open log file: " << logFileName << Qt::endl;
+        return DATA_NOT_FOUND;
+    }
+
+    if (file.size() > 0)
+    {
+        uchar *mapped = file.map(0, file.size());
+        if (mapped == nullptr)
+        {
+            qDebug() << "Error: LogViewModel::open could not map log file: " << logFileName << Qt::endl;
+            file.close();
+            return DATA_NOT_FOUND;
+        }
+        fileData = QByteArrayView(mapped, file.size());
+    }
+
+    QString indexFileName = logFileName + LOG_VIEW_INDEX_SUFFIX;
+    qint64 modifiedMs = QFileInfo(file).lastModified().toMSecsSinceEpoch();
+    QByteArrayView data = fileData;
+
+    watcher.setFuture(QtConcurrent::run([indexFileName, modifiedMs, data](QPromise<LogFileIndex> &promise) {
+        LogFileIndex index;
+
+        if (!index.load(indexFileName, data.size(), modifiedMs))
+        {
+            if (!index.build(data, &promise))
+            {
+                return;
+            }
+
+            //the log view works without a saved index (i.e. read only log folders)
+            index.modifiedMs = modifiedMs;
+            index.save(indexFileName);
+        }
+
+        promise.addResult(std::move(index));
+    }));
+
+    return SUCCESS;
+}
+
+/**
+ * @brief Stops indexing the log file being opened
+ */
+void LogViewModel::cancel()
+{
+    watcher.cancel();
+}
+
+/**
+ * @brief Stops showing the log file and unmaps it
+ */
+void LogViewModel::close()
+{
+    beginResetModel();
+
+    opened = false;
+    index = LogFileIndex();
+    stateLines.clear();
+    fileData = QByteArrayView();
+
+    //closing the file unmaps it
+    file.close();
+
+    endResetModel();
+}
+
+/**
+ * @brief Shows the rows of another filter
+ *
+ * @param filter Kinds of lines to show
+ */
+void LogViewModel::setFilter(EventFilter filter)
+{
+    beginResetModel();
+
+    this->filter = filter;
+
+    //cleared status can change in the file, so error state rows are read when shown
+    if (opened && (filter == CLEARED_ERRORS || filter == NON_CLEARED_ERRORS))
+    {
+        buildStateLines();
+    }
+
+    endResetModel();
+}
+
+/**
+ * @brief Finds a line in the mapped file
+ *
+ * Scans at most LOG_VIEW_INDEX_STRIDE lines from the nearest indexed line.
+ *
+ * @param line Line number, advanced log file lines are not counted
+ * @return Text of the line without its line end
+ */
+QByteArrayView LogViewModel::line(qint32 line) const
+{
+    qsizetype pos = index.blockStarts[line / LOG_VIEW_INDEX_STRIDE];
+    int skip = line % LOG_VIEW_INDEX_STRIDE;
+
+    while (pos < fileData.size())
+    {
+        qsizetype end = fileData.indexOf('\n', pos);
+        if (end == -1)
+        {
+            end = fileData.size();
+        }
+
+        QByteArrayView text = fileData.sliced(pos, end - pos);
+        pos = end + 1;
+
+        if (text.startsWith(ADVANCED_LINE_BYTES))
+        {
+            continue;
+        }
+
+        if (skip-- == 0)
+        {
+            //files written on windows end lines with \r\n
+            if (text.endsWith('\r'))
+            {
+                text.chop(1);
+            }
+            return text;
+        }
+    }
+
+    return QByteArrayView();
+}
+
+/**
+ * @brief Opens the log view once the index is ready
+ */
+void LogViewModel::indexFinished()
+{
+    if (watcher.isCanceled() || watcher.future().resultCount() == 0)
+    {
+        close();
+        emit indexed(LOAD_CANCELLED);
+        return;
+    }
+
+    beginResetModel();
+
+    index = watcher.result();
+    opened = true;
+
+    if (filter == CLEARED_ERRORS || filter == NON_CLEARED_ERRORS)
+    {
+        buildStateLines();
+    }
+
+    endResetModel();
+
+    #if DEV_MODE && EVENTS_DEBUG
+    qDebug() << "Log view indexed " << index.lineCount << " lines of: " << file.fileName();
+    #endif
+
+    emit indexed(SUCCESS);
+}
+
+qint32 LogViewModel::rowLine(int row) const
+{
+    switch (filter)
+    {
+    case ALL:
+        return row;
+
+    case ERRORS:
+        return index.errorLines[row];
+
+    //the row-th line that is not an error, there are errorLines[k] - k events before error k
+    case EVENTS:
+    {
+        const QVector<qint32> &errors = index.errorLines;
+        qint32 errorsBefore = 0;
+        qint32 count = static_cast<qint32>(errors.size());
+
+        while (count > 0)
+        {
+            qint32 step = count / 2;
+            if (errors[errorsBefore + step] - (errorsBefore + step) <= row)
+            {
+                errorsBefore += step + 1;
+                count -= step + 1;
+            }
+            else
+            {
+                count = step;
+            }
+        }
+        return row + errorsBefore;
+    }
+
+    default:
+        return stateLines[row];
+    }
+}
+
+void LogViewModel::buildStateLines()
+{
+    stateLines.clear();
+
+    for (qint32 errorLine : index.errorLines)
+    {
+        LogFileNode node;
+        bool cleared = Events::parseLogFileLine(line(errorLine), node) && node.cleared;
+
+        if (cleared == (filter == CLEARED_ERRORS))
+        {
+            stateLines.append(errorLine);
+        }
+    }
+}
@@ -0,0 +1,109 @@
+#ifndef LOGVIEWMODEL_H
+#define LOGVIEWMODEL_H
+
+#include <QAbstractListModel>
+#include <QFile>
+#include <QFutureWatcher>
+#include <QPromise>
+#include <QVector>
+#include "constants.h"
+#include "events.h"
+
+/********************************************************************************
+** logviewmodel.h
+**
+** The LogViewModel class shows a log file on the events page without loading it
+** into an Events object, so logs larger than RAM can be reviewed. The file is
+** memory mapped and only a LogFileIndex is kept in memory: the offset of every
+** LOG_VIEW_INDEX_STRIDE-th line and the line numbers of errors. Rows are read from
+** the mapped file when the view draws them, the operating system pages the file in
+** and out as needed.
+**
+** The index is built on the thread pool and saved next to the log file
+** (LOG_VIEW_INDEX_SUFFIX), so viewing the same log again does not rescan it.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Line index of a log file, advanced log file lines are not counted
+ */
+struct LogFileIndex
+{
+    // log file the index was built from, an index is only reused if they match
+    qint64 fileSize = 0;
+    qint64 modifiedMs = 0;
+
+    qint32 lineCount = 0;
+    QVector<qint64> blockStarts; // offset of line i * LOG_VIEW_INDEX_STRIDE
+    QVector<qint32> errorLines; // lines holding errors, ascending
+
+    // indexes log file text, progress is reported to promise. returns false if it
+    // is cancelled through promise
+    bool build(QByteArrayView data, QPromise<LogFileIndex> *promise = nullptr);
+
+    // index files, load fails if the index does not match the log file
+    bool save(const QString &indexFileName) const;
+    bool load(const QString &indexFileName, qint64 fileSize, qint64 modifiedMs);
+};
+
+class LogViewModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // constructors
+    LogViewModel(QObject *parent = nullptr);
+    ~LogViewModel();
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // maps a log file and starts indexing it, returns DATA_NOT_FOUND if it can not be
+    // mapped. indexed is emitted with SUCCESS or LOAD_CANCELLED
+    int open(const QString &logFileName);
+
+    // stops indexing, indexed is emitted with LOAD_CANCELLED
+    void cancel();
+
+    // unmaps the log file, the model is empty
+    void close();
+
+    bool isOpen() const { return opened; }
+    bool isIndexing() const { return watcher.isRunning(); }
+    QString fileName() const { return file.fileName(); }
+
+    // shows the rows of another filter
+    void setFilter(EventFilter filter);
+
+    // text of a line without its line end
+    QByteArrayView line(qint32 line) const;
+
+signals:
+    void progressChanged(int percent);
+    void indexed(int result);
+
+private slots:
+    void indexFinished();
+
+private:
+    // line shown in a row of the current filter
+    qint32 rowLine(int row) const;
+
+    // rebuilds the lines of an error state filter from the cleared status in the file
+    void buildStateLines();
+
+    QFile file;
+    QByteArrayView fileData; // mapped file
+    bool opened;
+
+    LogFileIndex index;
+    EventFilter filter;
+
+    // lines shown by the cleared or non cleared errors filters
+    QVector<qint32> stateLines;
+
+    QFutureWatcher<LogFileIndex> watcher;
+};
+
+#endif // LOGVIEWMODEL_H
@@ -0,0 +1,363 @@
+#include "logwriter.h"
+
+#ifdef Q_OS_WIN
+    #include <io.h>
+#else
+    #include <unistd.h>
+#endif
+
+/********************************************************************************
+** logwriter.cpp
+**
+** This file implements the log writer thread used for auto saved log files. The
+** creating (GUI) thread only queues records, the writer thread is the only thread
+** that writes to the file while it is open.
+**
+** @author Team Controller
+********************************************************************************/
+
+// new line written after each line, must be NEW_LINE_SIZE bytes
+static const QByteArray LOG_FILE_NEW_LINE = (NEW_LINE_SIZE == 1) ? QByteArray("\n") : QByteArray("\r\n");
+
+/**
+ * @brief Constructor, no file is set
+ */
+LogWriter::LogWriter(QObject *parent, LogWriterMode mode)
+    : QThread(parent), logicalSize(0), synchronous(mode == LOG_WRITER_SYNCHRONOUS), pendingBytes(0), submittedRecords(0), writtenRecords(0),
+    flushRequested(false), writeFailed(false), stopping(false)
+{
+    // avoid starting the thread until a file is opened
+}
+
+/**
+ * @brief Destructor, queued records are written before the file is closed
+ */
+LogWriter::~LogWriter()
+{
+    close();
+
+    mutex.lock();
+    stopping = true;
+    workAvailable.wakeOne();
+    mutex.unlock();
+
+    wait();
+}
+
+void LogWriter::setFileName(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+    indicatorOffsets.clear();
+}
+
+/**
+ * @brief Opens the log file and starts the writer thread if needed
+ *
+ * The file is opened once and kept open until it is closed or the file name changes.
+ *
+ * @param truncate True to clear existing contents of the file
+ * @return False if the file could not be opened
+ */
+bool LogWriter::open(bool truncate)
+{
+    //closing waits for the writer thread to finish with the file
+    close();
+
+    QIODevice::OpenMode mode = QIODevice::ReadWrite | QIODevice::Unbuffered;
+    if (truncate)
+    {
+        mode |= QIODevice::Truncate;
+    }
+
+    if (file.fileName().isEmpty() || !file.open(mode))
+    {
+        qDebug() << "Error: LogWriter could not open log file: " << file.fileName() << " " << file.errorString() << Qt::endl;
+        return false;
+    }
+
+    logicalSize = file.size();
+
+    //indicators of a cleared file are gone
+    if (truncate)
+    {
+        indicatorOffsets.clear();
+    }
+
+    if (!synchronous && !isRunning())
+    {
+        start();
+    }
+
+    return true;
+}
+
+void LogWriter::close()
+{
+    if (!file.isOpen())
+    {
+        return;
+    }
+
+    flush();
+
+    if (LOG_WRITER_SYNC_INTERVAL > 0)
+    {
+        syncToDisk();
+    }
+
+    file.close();
+    logicalSize = 0;
+}
+
+/**
+ * @brief Queues a line to be appended to the log file
+ *
+ * @param line Utf-8 text of the line, without a new line
+ * @return Offset of the line in the log file, -1 if the file could not be opened
+ */
+qint64 LogWriter::writeLine(const QByteArray &line)
+{
+    if (!file.isOpen() && !open(false))
+    {
+        return -1;
+    }
+
+    qint64 offset = logicalSize;
+    QByteArray bytes = line + LOG_FILE_NEW_LINE;
+    logicalSize += bytes.size();
+
+    submit(LogRecord{offset, bytes});
+
+    return offset;
+}
+
+/**
+ * @brief Queues bytes that overwrite part of the log file
+ *
+ * Used to replace indicators in lines that were already queued. Records are written
+ * in the order they were queued, so the patch always lands on the line it targets.
+ *
+ * @param offset Offset of the first byte to overwrite
+ * @param bytes Replacement bytes
+ * @return False if the bytes are not within the file
+ */
+bool LogWriter::overwrite(qint64 offset, const QByteArray &bytes)
+{
+    if (!file.isOpen() || offset < 0 || offset + bytes.size() > logicalSize)
+    {
+        return false;
+    }
+
+    submit(LogRecord{offset, bytes});
+
+    return true;
+}
+
+/**
+ * @brief Waits for the writer thread to write every queued record
+ *
+ * @return False if any write failed since the last flush
+ */
+bool LogWriter::flush()
+{
+    QMutexLocker locker(&mutex);
+
+    if (synchronous)
+    {
+        writePending();
+    }
+
+    qint64 target = submittedRecords;
+
+    if (writtenRecords < target)
+    {
+        flushRequested = true;
+        workAvailable.wakeOne();
+
+        while (writtenRecords < target)
+        {
+            batchWritten.wait(&mutex);
+        }
+
+        flushRequested = false;
+    }
+
+    bool succeeded = !writeFailed;
+    writeFailed = false;
+
+    return succeeded;
+}
+
+void LogWriter::indexIndicator(int errorId, qint64 offset)
+{
+    if (!indicatorOffsets.contains(errorId))
+    {
+        indicatorOffsets.insert(errorId, offset);
+    }
+}
+
+void LogWriter::submit(LogRecord &&record)
+{
+    QMutexLocker locker(&mutex);
+
+    bool wasEmpty = pending.isEmpty();
+
+    pendingBytes += record.bytes.size();
+    pending.append(std::move(record));
+
+    //a synchronous writer writes its own records once the buffer fills
+    if (synchronous)
+    {
+        if (pendingBytes >= LOG_WRITER_BUFFER_SIZE)
+        {
+            writePending();
+        }
+        return;
+    }
+
+    submittedRecords++;
+
+    //the first record starts the writer's wait, a full buffer ends it early
+    if (wasEmpty || pendingBytes >= LOG_WRITER_BUFFER_SIZE)
+    {
+        workAvailable.wakeOne();
+    }
+}
+
+void LogWriter::writePending()
+{
+    if (!writeBatch(pending))
+    {
+        writeFailed = true;
+    }
+
+    pending.clear();
+    pendingBytes = 0;
+}
+
+/**
+ * @brief Writer thread entry point
+ *
+ * Once a record is queued the thread waits for more records to arrive (group commit),
+ * then takes everything queued and writes it as one batch.
+ */
+void LogWriter::run()
+{
+    QVector<LogRecord> batch;
+    QElapsedTimer sinceSync;
+    sinceSync.start();
+
+    QMutexLocker locker(&mutex);
+
+    while (true)
+    {
+        if (pending.isEmpty())
+        {
+            if (stopping)
+            {
+                break;
+            }
+
+            workAvailable.wait(&mutex);
+            continue;
+        }
+
+        //let more records arrive unless a full buffer, flush or stop is waiting
+        if (!stopping && !flushRequested && pendingBytes < LOG_WRITER_BUFFER_SIZE)
+        {
+            workAvailable.wait(&mutex, LOG_WRITER_FLUSH_INTERVAL);
+        }
+
+        batch.swap(pending);
+        pendingBytes = 0;
+        qint64 batchEnd = submittedRecords;
+
+        //write without holding the lock so the gui can keep queueing
+        locker.unlock();
+
+        bool succeeded = writeBatch(batch);
+        batch.clear();
+
+        if (LOG_WRITER_SYNC_INTERVAL > 0 && sinceSync.hasExpired(LOG_WRITER_SYNC_INTERVAL))
+        {
+            syncToDisk();
+            sinceSync.restart();
+        }
+
+        locker.relock();
+
+        writtenRecords = batchEnd;
+        if (!succeeded)
+        {
+            writeFailed = true;
+        }
+        batchWritten.wakeAll();
+    }
+}
+
+/**
+ * @brief Writes a batch of records
+ *
+ * Consecutive lines are joined into one write, and patches that land on lines in the
+ * same batch are applied in memory, so a burst of records usually costs a single write.
+ *
+ * @param batch Records in the order they were queued
+ * @return False if any write failed
+ */
+bool LogWriter::writeBatch(const QVector<LogRecord> &batch)
+{
+    qint64 chunkStart = 0;
+    QByteArray chunk;
+    bool succeeded = true;
+
+    for (const LogRecord &record : batch)
+    {
+        qint64 chunkEnd = chunkStart + chunk.size();
+
+        //record continues the chunk
+        if (!chunk.isEmpty() && record.offset == chunkEnd)
+        {
+            chunk.append(record.bytes);
+        }
+        //record patches bytes within the chunk
+        else if (!chunk.isEmpty() && record.offset >= chunkStart && record.offset + record.bytes.size() <= chunkEnd)
+        {
+            chunk.replace(record.offset - chunkStart, record.bytes.size(), record.bytes);
+        }
+        //otherwise write the chunk and start a new one
+        else
+        {
+            succeeded = writeAt(chunkStart, chunk) && succeeded;
+            chunkStart = record.offset;
+            chunk = record.bytes;
+        }
+    }
+
+    return writeAt(chunkStart, chunk) && succeeded;
+}
+
+bool LogWriter::writeAt(qint64 offset, const QByteArray &bytes)
+{
+    if (bytes.isEmpty())
+    {
+        return true;
+    }
+
+    if (!file.seek(offset) || file.write(bytes) != bytes.size())
+    {
+        qDebug() << "Error: LogWriter could not write to log file: " << file.fileName() << " " << file.errorString() << Qt::endl;
+        return false;
+    }
+
+    return true;
+}
+
+void LogWriter::syncToDisk()
+{
+    #ifdef Q_OS_WIN
+        _commit(file.handle());
+    #else
+        fsync(file.handle());
+    #endif
+}
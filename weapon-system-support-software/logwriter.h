@@ -0,0 +1,140 @@
+#ifndef LOGWRITER_H
+#define LOGWRITER_H
+
+#include <QThread>
+#include <QDebug>
+#include <QFile>
+#include <QMutex>
+#include <QWaitCondition>
+#include <QElapsedTimer>
+#include <QHash>
+#include "constants.h"
+
+/********************************************************************************
+** logwriter.h
+**
+** The LogWriter class keeps a log file open for the length of a session and writes
+** to it from a dedicated thread. Lines and in place patches (i.e. clearing an error's
+** indicator) are queued by the GUI thread and the writer thread coalesces everything
+** queued into as few writes as possible. Queued records are written once
+** LOG_WRITER_BUFFER_SIZE bytes are waiting, once the oldest has waited
+** LOG_WRITER_FLUSH_INTERVAL, or when the writer is flushed or closed.
+**
+** The GUI thread tracks the size of the file itself, so the offset of every line is
+** known as soon as it is queued, without waiting for the writer thread. The writer
+** also indexes where each active error's indicator is in the file. The index belongs
+** to the file rather than to the events in RAM, so it survives RAM clears and an
+** error can always be cleared with a single write.
+**
+** A synchronous writer (LOG_WRITER_SYNCHRONOUS) never starts a thread. Records are
+** coalesced the same way but written by the creating thread once the buffer fills
+** or the writer is flushed or closed. It suits writers that only live for a single
+** call, where starting and joining a thread would cost more than the writes.
+**
+** @author Team Controller
+********************************************************************************/
+
+// who writes a log writer's records to its file
+enum LogWriterMode {LOG_WRITER_THREADED=0, LOG_WRITER_SYNCHRONOUS=1};
+
+class LogWriter : public QThread
+{
+    Q_OBJECT
+public:
+    // constructors, a threaded writer's thread is started when a file is first opened
+    LogWriter(QObject *parent = nullptr, LogWriterMode mode = LOG_WRITER_THREADED);
+    ~LogWriter();
+
+    /**
+     * These methods must only be called from the thread that created the writer
+     */
+    // closes the current file and sets the file used by the next write. The file is
+    // opened by the first write so empty log files are not created
+    void setFileName(const QString &fileName);
+    QString fileName() const { return file.fileName(); }
+
+    // opens the file now, truncate clears existing contents
+    bool open(bool truncate);
+    bool isOpen() const { return file.isOpen(); }
+
+    // writes queued records and closes the file
+    void close();
+
+    // queues a line (without its new line), returns the offset of its first byte in
+    // the file or -1 if the file could not be opened
+    qint64 writeLine(const QByteArray &line);
+
+    // queues bytes that replace part of the file, whether or not it has been written yet
+    bool overwrite(qint64 offset, const QByteArray &bytes);
+
+    // size of the file including queued lines
+    qint64 size() const { return logicalSize; }
+
+    // waits for every queued record to be written, returns false if any write failed
+    bool flush();
+
+    // records the offset of an active error's indicator. If several errors share an
+    // id, the first one indexed is kept
+    void indexIndicator(int errorId, qint64 offset);
+
+    // offset of an active error's indicator, -1 if it is not indexed
+    qint64 indicatorOffset(int errorId) const { return indicatorOffsets.value(errorId, -1); }
+
+    // removes an error from the index once it is cleared
+    void removeIndicator(int errorId) { indicatorOffsets.remove(errorId); }
+
+private:
+    /**
+     * @brief Bytes to be written at an offset of the log file
+     *
+     * Lines are records at the end of the file, patches are records within it.
+     */
+    struct LogRecord
+    {
+        qint64 offset;
+        QByteArray bytes;
+    };
+
+    // writes queued records until the writer is destroyed
+    void run() override;
+
+    // hands a record to the writer thread
+    void submit(LogRecord &&record);
+
+    // synchronous writers only, writes every pending record on the calling thread
+    void writePending();
+
+    // writer thread, coalesces a batch of records into as few writes as possible
+    bool writeBatch(const QVector<LogRecord> &batch);
+    bool writeAt(qint64 offset, const QByteArray &bytes);
+
+    // asks the operating system to commit written data to disk
+    void syncToDisk();
+
+    // opened and closed by the creating thread while the writer thread is idle, only
+    // written by the writer thread
+    QFile file;
+
+    // size of the file once every queued record is written (creating thread only)
+    qint64 logicalSize;
+
+    // true if records are written by the creating thread instead of a writer thread
+    const bool synchronous;
+
+    // error id -> offset of its active indicator in the file (creating thread only)
+    QHash<int, qint64> indicatorOffsets;
+
+    // guards every member below
+    QMutex mutex;
+    QWaitCondition workAvailable; // records queued, flush requested or stopping
+    QWaitCondition batchWritten; // the writer thread finished writing a batch
+    QVector<LogRecord> pending; // records waiting for the writer thread
+    qint64 pendingBytes;
+    qint64 submittedRecords; // records queued since the writer was created
+    qint64 writtenRecords; // records written since the writer was created
+    bool flushRequested;
+    bool writeFailed; // a write failed since the last flush
+    bool stopping;
+};
+
+#endif // LOGWRITER_H
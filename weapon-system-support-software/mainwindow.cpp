@@ -1,6 +1,5 @@
 #include "mainwindow.h"
-#include <QTextDocument>
-#include <QTextCursor>
+#include <QScrollBar>
 
 /********************************************************************************
 ** mainwindow.cpp
@@ -25,11 +24,31 @@ MainWindow::MainWindow(QWidget *parent)
     //initialize imbedded classes/vars
     : QMainWindow(parent),
     ui(new Ui::MainWindow),
+    serialReader(nullptr),
     ddmCon(nullptr),
     status(new Status()),
     electricalData(new electrical()),
     events(nullptr),
 
+    //log writer is given the auto save log file each time a session begins
+    logWriter(new LogWriter(this)),
+
+    //events page list only formats the rows that are on screen
+    eventsModel(new EventsModel(this)),
+    eventsDelegate(new EventsDelegate(this)),
+
+    //search covers the nodes of the session, whether or not they are still in RAM
+    eventSearch(new EventSearch()),
+
+    //notifications page keeps a bounded number of notifications
+    notificationsModel(new NotificationsModel(this)),
+
+    //log files are parsed on the thread pool
+    logFileLoader(new LogFileLoader(this)),
+
+    //log files too large to load are shown straight from the file
+    logViewModel(new LogViewModel(this)),
+
     //this determines what will be shown on the events page
     eventFilter(ALL),
 
@@ -48,12 +67,26 @@ MainWindow::MainWindow(QWidget *parent)
     //timer for preventing spam of handshake button
     handshakeCooldownTimer(new QTimer(this)),
 
+    //timer is used to consume messages decoded by the serial reader thread
+    serialFrameTimer(new QTimer(this)),
+
+    //timer is used to redraw gui parts changed by messages at most once per frame
+    renderTimer(new QTimer(this)),
+
     //init user settings to our organization and project
     userSettings("Team Controller", "WSSS"),
 
     //init to false until connection page is setup
     allowSettingChanges(false),
 
+    //no session until the handshake starts
+    connectionChangesLocked(false),
+
+    //nothing to redraw until messages arrive
+    dirtyRegions(0),
+
+    urgentNotification(false),
+
     //Load graphical resources
     BLANK_LIGHT(":/resources/Images/blankButton.png"),
 
@@ -66,6 +99,12 @@ MainWindow::MainWindow(QWidget *parent)
     //init gui
     ui->setupUi(this);
 
+    //show notifications from the notifications ring buffer
+    QFont notificationFont = ui->notificationOutput->font();
+    notificationFont.setPixelSize(NOTIFICATION_SIZE);
+    ui->notificationOutput->setFont(notificationFont);
+    ui->notificationOutput->setModel(notificationsModel);
+
     //setup user settings and init settings related gui elements
     setupSettings();
 
@@ -77,6 +116,21 @@ MainWindow::MainWindow(QWidget *parent)
     //using 1 signal-slot connection
     connect(events, &Events::RAMCleared, this, &MainWindow::handleRAMClear);
 
+    //replace the events class once a log file is loaded
+    connect(logFileLoader, &LogFileLoader::finished, this, &MainWindow::logFileLoaded);
+
+    //show a log file on the events page once it is indexed
+    connect(logViewModel, &LogViewModel::indexed, this, &MainWindow::logViewIndexed);
+
+    //show the events class on the events page list
+    QFont eventsFont = ui->events_output->font();
+    eventsFont.setPixelSize(EVENT_OUTPUT_SIZE);
+    ui->events_output->setFont(eventsFont);
+    ui->events_output->setModel(eventsModel);
+    ui->events_output->setItemDelegate(eventsDelegate);
+    eventsDelegate->setColored(coloredEventOutput);
+    eventsModel->reset(events, eventFilter);
+
     //will be disabled until RAM is cleared
     ui->truncated_label->setVisible(false);
 
@@ -100,6 +154,9 @@ MainWindow::MainWindow(QWidget *parent)
         csimHandle->generationInterval = CSIM_GENERATION_INTERVAL;
         ui->csim_generation_interval_selection->setValue(csimHandle->generationInterval);
 
+        //init load profile
+        ui->csim_load_profile->setText(CSIM_LOAD_PROFILE);
+
         //CSIM control slots ==============================================================
 
         //connect custom transmission requests from ddm to csims execution slot
@@ -110,10 +167,20 @@ MainWindow::MainWindow(QWidget *parent)
 
         //connect output session string to ddm output session string slot
         connect(this, &MainWindow::outputMessagesSentRequest, csimHandle, &CSim::outputMessagesSent);
+
+        //init session replayer, it reports back from its own thread
+        replayer = new SessionReplayer();
+        connect(replayer, &SessionReplayer::replayFinished, this, &MainWindow::replayFinished);
+
+        //refresh the latency report while the diagnostics page is shown
+        diagnosticsTimer = new QTimer(this);
+        diagnosticsTimer->setInterval(DIAGNOSTICS_REFRESH_INTERVAL);
+        connect(diagnosticsTimer, &QTimer::timeout, this, &MainWindow::updateDiagnosticsPage);
         //=================================================================================
-    //dev mode is not active, hide dev page button
+    //dev mode is not active, hide dev and diagnostics page buttons
     #else
         ui->DevPageButton->setVisible(false);
+        ui->DiagnosticsPageButton->setVisible(false);
     #endif
 
     //Timers ===============================================================================
@@ -143,6 +210,15 @@ MainWindow::MainWindow(QWidget *parent)
     //connect running controller timer to slot
     runningControllerTimer->setInterval(ONE_SECOND);
     connect(runningControllerTimer, &QTimer::timeout, this, &MainWindow::updateElapsedTime);
+
+    //consume decoded serial messages at a bounded rate rather than once per message
+    serialFrameTimer->setInterval(SERIAL_FRAME_INTERVAL);
+    connect(serialFrameTimer, &QTimer::timeout, this, &MainWindow::processSerialFrames);
+
+    //redraw changed gui parts once per frame rather than once per message
+    renderTimer->setInterval(RENDER_INTERVAL);
+    renderTimer->setSingleShot(true);
+    connect(renderTimer, &QTimer::timeout, this, &MainWindow::renderDirtyRegions);
     //======================================================================================
 
     //init trigger to grey buttons until updated by serial status updates
@@ -160,17 +236,23 @@ MainWindow::~MainWindow()
 {
     //call destructors for classes declared in main window
     delete ui;
-    delete ddmCon;
+    delete serialReader;
     delete status;
     delete events;
+    delete logWriter;
+    delete eventSearch;
     delete handshakeTimer;
     delete notificationTimer;
     delete lastMessageTimer;
     delete runningControllerTimer;
     delete handshakeCooldownTimer;
+    delete serialFrameTimer;
+    delete renderTimer;
     delete electricalData;
     #if DEV_MODE
         delete csimHandle;
+        delete replayer;
+        delete diagnosticsTimer;
     #endif
 }
 
@@ -232,10 +314,10 @@ void MainWindow::updateConnectionStatus(bool connectionStatus)
         ui->connectionLabel->setText("Connected ");
         ui->connectionStatus->setPixmap(GREEN_LIGHT);
 
-        //clear events and full clear the class output box
-        ui->events_output->clear();
-
-        events->freeLinkedLists(true);
+        //clear events and full clear the class output list
+        events->freeNodes(true);
+        eventsModel->reset(events, eventFilter);
+        eventSearch->clear();
 
         //reset event counters
         ui->TotalEventsOutput->setText("0");
@@ -281,6 +363,12 @@ void MainWindow::updateConnectionStatus(bool connectionStatus)
             logAdvancedDetails(ELECTRICAL);
             logAdvancedDetails(CLOSING_CONNECTION);
         }
+
+        //make sure the whole session is in the log file
+        logWriter->flush();
+
+        //the capture ends with the session
+        stopSessionCapture();
     }
 }
 
@@ -293,40 +381,41 @@ void MainWindow::updateConnectionStatus(bool connectionStatus)
 void MainWindow::createDDMCon()
 {
     //close current connection
-    if (ddmCon != nullptr)
+    if (serialReader != nullptr)
     {
         //notify user of closed connection class
         notifyUser(ddmPortName + " closed",  false);
-        delete ddmCon;
+
+        //stopping the reader thread destroys its connection
+        serialFrameTimer->stop();
+        delete serialReader;
+        serialReader = nullptr;
         ddmCon = nullptr;
     }
 
-    //open new connection
-    ddmCon = new Connection(ui->ddm_port_selection->currentText(),
-                            fromStringBaudRate(ui->baud_rate_selection->currentText()),
-                            fromStringDataBits(ui->data_bits_selection->currentText()),
-                            fromStringParity(ui->parity_selection->currentText()),
-                            fromStringStopBits(ui->stop_bit_selection->currentText()),
-                            fromStringFlowControl(ui->flow_control_selection->currentText()));
+    //open new connection on its own thread
+    serialReader = new SerialReader(nullptr, ui->ddm_port_selection->currentText(),
+                                    fromStringBaudRate(ui->baud_rate_selection->currentText()),
+                                    fromStringDataBits(ui->data_bits_selection->currentText()),
+                                    fromStringParity(ui->parity_selection->currentText()),
+                                    fromStringStopBits(ui->stop_bit_selection->currentText()),
+                                    fromStringFlowControl(ui->flow_control_selection->currentText()));
+    ddmCon = serialReader->startReader();
 
-    if (ddmCon == nullptr)
-    {
-        notifyUser("Failed to open " + ui->ddm_port_selection->currentText(), true);
-    }
     //check for failure to open
-    else if (!ddmCon->serialPort.isOpen())
+    if (ddmCon == nullptr)
     {
-        delete ddmCon;
-        ddmCon = nullptr;
+        delete serialReader;
+        serialReader = nullptr;
 
         //generate notification
         notifyUser("Failed to open " + ui->ddm_port_selection->currentText(), true);
     }
     else
     {
-        //set up signal and slot (when a message is sent to DDMs serial port, the readyRead signal is emitted and
-        //readSerialData() is called)
-        connect(&ddmCon->serialPort, &QSerialPort::readyRead, this, &MainWindow::readSerialData);
+        //the reader thread decodes incoming messages as they arrive, the gui consumes them
+        //each time the serial frame timer runs processSerialFrames()
+        serialFrameTimer->start();
 
         qDebug() << "GUI is now listening to port " << ddmCon->portName;
 
@@ -346,86 +435,100 @@ void MainWindow::handshake()
         return;
     }
 
-    // send handshake message if Con object ready
-    ddmCon->sendHandshakeMsg();
+    // send handshake message if Con object ready (queued to the serial reader thread)
+    QMetaObject::invokeMethod(ddmCon, &Connection::sendHandshakeMsg);
 }
 
 /**
- * @brief Reads and processes incoming serial data from the DDM port
+ * @brief Processes serial messages decoded by the serial reader thread
  *
- * This method is called as a result of the readyRead signal being emitted by
- * a connected serial port, indicating that new data has been received. It processes
- * the incoming data, identifies the type of message, and performs the corresponding
- * actions based on the message type.
+ * This method is called by the serial frame timer. The serial reader thread reads the DDM
+ * port, frames each message and decodes it into a typed frame, this method consumes those
+ * frames and performs the corresponding actions based on the message type. Depending on
+ * the message type, it may update the GUI, data structures, log file, etc.
  *
- * It reads lines from the serial port until all data in the buffer is processed. Depending
- * on the message type, it may update the GUI, data structures, log file, etc.
+ * At most MAX_FRAMES_PER_UPDATE frames are processed per call, any remaining frames
+ * are processed on the next call so large bursts can't freeze the GUI.
  *
  * This method is also the point at which errors are handled by invalid messages or
- * unexpected input, and the load() methods that are ran redudantly check as well.
+ * unexpected input.
  */
-void MainWindow::readSerialData()
+void MainWindow::processSerialFrames()
 {
     if (ddmCon == nullptr)
     {
         //this should never happen..
-        qDebug() <<"Error: readSerialData called with no connection class declared"<<Qt::endl;
-        notifyUser("Could not read serial data", "Connection class is not declared", true);
+        qDebug() <<"Error: processSerialFrames called with no connection class declared"<<Qt::endl;
+        serialFrameTimer->stop();
+        return;
+    }
+
+    //check for new messages
+    if (serialReader->frameQueue.isEmpty())
+    {
         return;
     }
 
     //prevent timeout during long processing
     lastMessageTimer->stop();
 
-    //read lines until all data in buffer is processed
-    while (ddmCon->checkForValidMessage() == VALID_MESSAGE)
-    {
-        // declare variables
-        SerialMessageIdentifier messageId;
-        int errorId;
-        int result;
+    //frame is reused for every message so its storage is only allocated once
+    DecodedFrame frame;
 
-        //get serialized string from port
-        QByteArray serializedMessage = ddmCon->serialPort.readLine();
+    //ids from consecutive clear error messages, cleared together
+    QVector<int> pendingClears;
 
-        //deserialize string
-        QString message = QString::fromUtf8(serializedMessage);
+    #if DEV_MODE
+    //stage times of the clear error messages in pendingClears
+    QVector<FrameTimestamps> pendingClearTimes;
+    #endif
 
+    //process messages until all decoded messages are processed or the update limit is reached
+    for (int numFrames = 0; numFrames < MAX_FRAMES_PER_UPDATE && serialReader->frameQueue.pop(frame); numFrames++)
+    {
+        #if DEV_MODE
+        frame.timestamps.mark(STAGE_DEQUEUED);
+        #endif
         #if DEV_MODE && SERIAL_COMM_DEBUG
-        qDebug() << "message: " << message;
+        qDebug() << "message: " << frame.message;
         #endif
         #if DEV_MODE
-        //update gui with new message
-        ui->stdout_label->setText(message);
+        //show the latest message on the next render
+        lastFrameMessage = frame.message;
+        scheduleRender(RENDER_LAST_MESSAGE);
         #endif
 
-        //check if message id is present and followed by the proper delimeter
-        if (message[0].isDigit() && message[1] == DELIMETER)
+        //apply clears before any other message is handled so messages stay in order
+        if (!pendingClears.isEmpty() && !(frame.hasMessageId && frame.messageId == CLEAR_ERROR))
         {
-            //extract message id
-            messageId = static_cast<SerialMessageIdentifier>(QString(message[0]).toInt());
+            applyErrorClears(pendingClears);
+
+            #if DEV_MODE
+            recordClearLatencies(pendingClearTimes);
+            #endif
+        }
 
+        //check if message id is present and followed by the proper delimeter
+        if (frame.hasMessageId)
+        {
             //ensure we are in an active connection or attempting to connect
             if(!(handshakeTimer->isActive() || ddmCon->connected))
             {
-                qDebug() << "Error: readSerialData unexpected communication from controller"<< Qt::endl;
-                notifyUser("Unexpected communication from controller", message, true);
-                ddmCon->sendDisconnectMsg();
+                qDebug() << "Error: processSerialFrames unexpected communication from controller"<< Qt::endl;
+                notifyUser("Unexpected communication from controller", QString::fromUtf8(frame.message), true);
+                QMetaObject::invokeMethod(ddmCon, &Connection::sendDisconnectMsg);
                 return;
             }
             //ensure we are only getting begin message during handshake
-            else if (handshakeTimer->isActive() && messageId != BEGIN)
+            else if (handshakeTimer->isActive() && frame.messageId != BEGIN)
             {
-                notifyUser("Invalid handshake is occurring", message, true);
-                ddmCon->sendDisconnectMsg();
+                notifyUser("Invalid handshake is occurring", QString::fromUtf8(frame.message), true);
+                QMetaObject::invokeMethod(ddmCon, &Connection::sendDisconnectMsg);
                 return;
             }
 
-            //remove message id from message (id has len=1 and delimeter has len=1 so 2 total)
-            message = message.mid(2);
-
             //determine what kind of message this is
-            switch ( messageId )
+            switch ( frame.messageId )
             {
             case STATUS:
                 // STATUS MESSAGE TYPE
@@ -434,16 +537,31 @@ void MainWindow::readSerialData()
                 #endif
 
                 //update status class with new data
-                if (!status->loadData(message))
+                if (!frame.valid)
+                {
+                    notifyUser("Invalid status message received", QString::fromUtf8(frame.payload), true);
+                }
+                else
                 {
-                    notifyUser("Invalid status message received", message, true);
+                    status->loadData(frame.status);
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_STORED);
+                    #endif
                 }
 
-                //update gui
-                updateStatusDisplay();
+                //update gui on the next render
+                scheduleRender(RENDER_STATUS);
 
                 //if advanced log file is enabled, log the status
-                if (advancedLogFile) logAdvancedDetails(STATUS);
+                if (advancedLogFile)
+                {
+                    logAdvancedDetails(STATUS);
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_LOG_QUEUED);
+                    #endif
+                }
 
                 break;
 
@@ -454,18 +572,29 @@ void MainWindow::readSerialData()
                 #endif
 
                 //add new event to event ll, check for fail
-                if (!events->loadEventData(message))
+                if (!frame.valid)
                 {
-                    notifyUser("Invalid event message received", message, true);
+                    notifyUser("Invalid event message received", QString::fromUtf8(frame.payload), true);
                 }
                 //otherwise success
                 else
                 {
-                    // update log file
-                    events->appendToLogfile(autosaveLogFile, events->lastEventNode);
+                    events->loadEventData(frame.event);
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_STORED);
+                    #endif
+
+                    // update log file and search index
+                    events->appendToLogfile(*logWriter, events->store.lastEvent());
+                    eventSearch->add(events->store.lastEvent());
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_LOG_QUEUED);
+                    #endif
 
                     // update GUI elements
-                    updateEventsOutput(events->lastEventNode);
+                    updateEventsOutput(events->store.lastEvent());
                 }
 
                 break;
@@ -477,23 +606,34 @@ void MainWindow::readSerialData()
                 #endif
 
                 //add new error to error ll, check for fail
-                if (!events->loadErrorData( message ))
+                if (!frame.valid)
                 {
-                    notifyUser("Invalid error message received", message, true);
+                    notifyUser("Invalid error message received", QString::fromUtf8(frame.payload), true);
                 }
                 //otherwise success
                 else
                 {
-                    // update log file
-                    events->appendToLogfile(autosaveLogFile, events->lastErrorNode);
+                    events->loadErrorData(frame.error);
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_STORED);
+                    #endif
+
+                    // update log file and search index
+                    events->appendToLogfile(*logWriter, events->store.lastError());
+                    eventSearch->add(events->store.lastError());
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_LOG_QUEUED);
+                    #endif
 
                     //update gui elements
-                    updateEventsOutput(events->lastErrorNode);
+                    updateEventsOutput(events->store.lastError());
 
                     #if DEV_MODE
                         //update the cleared error selection box in dev tools
                         //(this can be removed when dev page is removed)
-                        update_non_cleared_error_selection();
+                        scheduleRender(RENDER_ERROR_SELECTION);
                     #endif
                 }
 
@@ -505,16 +645,23 @@ void MainWindow::readSerialData()
                 qDebug() <<  "Message id: electrical" << qPrintable("\n");
                 #endif
 
-                //load new data into electrical ll, notify if fail
-                if (!electricalData->loadElecDump(message))
+                //load new data into electrical ll (components before an invalid one are kept)
+                electricalData->loadElecDump(frame.electrical);
+
+                #if DEV_MODE
+                frame.timestamps.mark(STAGE_STORED);
+                #endif
+
+                //notify if fail
+                if (!frame.valid)
                 {
-                    notifyUser("Invalid electrical dump received", message, true);
+                    notifyUser("Invalid electrical dump received", QString::fromUtf8(frame.payload), true);
                 }
                 //otherwise success
                 else
                 {
-                    //dynamically generate nodes on electrical page
-                    renderElectricalPage();
+                    //dynamically generate nodes on electrical page on the next render
+                    scheduleRender(RENDER_ELECTRICAL);
                 }
 
                 break;
@@ -525,10 +672,16 @@ void MainWindow::readSerialData()
                 qDebug() <<  "Message id: event dump" << qPrintable("\n");
                 #endif
 
-                // load all events to event linked list, notify if fail
-                if (!events->loadEventDump(message))
+                // load all valid events to event linked list, notify if fail
+                events->loadEventDump(frame.eventDump);
+
+                #if DEV_MODE
+                frame.timestamps.mark(STAGE_STORED);
+                #endif
+
+                if (!frame.valid)
                 {
-                    notifyUser("Invalid event dump received", message, true);
+                    notifyUser("Invalid event dump received", QString::fromUtf8(frame.payload), true);
                 }
                 else if (events->totalEvents == 1)
                 {
@@ -540,16 +693,21 @@ void MainWindow::readSerialData()
                 }
 
                 // create log file
-                if (!events->outputToLogFile( autosaveLogFile, advancedLogFile ))
+                if (!events->outputToLogFile( *logWriter, advancedLogFile ))
                 {
                     notifyUser("Failed to open logfile","Manual download could save the data.", true);
                 }
 
+                #if DEV_MODE
+                frame.timestamps.mark(STAGE_LOG_QUEUED);
+                #endif
+
                 //new auto save file created, enforce auto save limit
                 enforceAutoSaveLimit();
 
-                //refresh the events output with dumped event data
+                //refresh the events output and search index with dumped event data
                 refreshEventsOutput();
+                eventSearch->rebuild(events->store);
 
                 break;
 
@@ -559,10 +717,16 @@ void MainWindow::readSerialData()
                 qDebug() <<  "Message id: error dump" << qPrintable("\n");
                 #endif
 
-                // load all errors to error linked list, notify if fail
-                if (!events->loadErrorDump(message))
+                // load all valid errors to error linked list, notify if fail
+                events->loadErrorDump(frame.errorDump);
+
+                #if DEV_MODE
+                frame.timestamps.mark(STAGE_STORED);
+                #endif
+
+                if (!frame.valid)
                 {
-                    notifyUser("Invalid error dump received", message, true);
+                    notifyUser("Invalid error dump received", QString::fromUtf8(frame.payload), true);
                 }
                 else if (events->totalErrors == 1)
                 {
@@ -574,82 +738,67 @@ void MainWindow::readSerialData()
                 }
 
                 // create log file
-                if (!events->outputToLogFile( autosaveLogFile, advancedLogFile ))
+                if (!events->outputToLogFile( *logWriter, advancedLogFile ))
                 {
                     notifyUser("Failed to open logfile","Manual download could save the data.", true);
                 }
 
+                #if DEV_MODE
+                frame.timestamps.mark(STAGE_LOG_QUEUED);
+                #endif
+
                 //new auto save file created, enforce auto save limit
                 enforceAutoSaveLimit();
 
-                //refresh the events output with dumped error data
+                //refresh the events output and search index with dumped error data
                 refreshEventsOutput();
+                eventSearch->rebuild(events->store);
 
                 break;
 
             case CLEAR_ERROR:
                 // CLEAR ERROR MESSAGE TYPE
                 #if DEV_MODE && SERIAL_COMM_DEBUG
-                qDebug() << "Message id: clear error " << message << qPrintable("\n");
+                qDebug() << "Message id: clear error " << frame.payload << qPrintable("\n");
                 #endif
 
-                //extract error id from message
-                errorId = message.left(message.indexOf(DELIMETER)).trimmed().toInt();
-
-                //attempt clear
-                result = events->clearError(errorId, autosaveLogFile );
-
-                //check for fail (here failed to clear from ll indicates RAM dump)
-                if (result != SUCCESS && result != FAILED_TO_CLEAR_FROM_LL)
+                //check for invalid error id
+                if (!frame.valid)
                 {
-                    //notify user of fail type
-                    if (result == FAILED_TO_CLEAR)
-                    {
-                        notifyUser("Failed to clear error", message, true);
-                    }
-                    else if (result == FAILED_TO_CLEAR_FROM_LOGFILE)
-                    {
-                        notifyUser("Error "+ QString::number(errorId) + " can't be cleared from logfile", true);
-                    }
+                    notifyUser("Failed to clear error", QString::fromUtf8(frame.payload), true);
+                    break;
                 }
-                //otherwise success
-                else
-                {
-                    //attempt to clear in events output
-                    if (result == SUCCESS) clearErrorFromEventsOutput(errorId);
 
-                    //update counters
-                    ui->ClearedErrorsOutput->setText(QString::number(events->totalClearedErrors));
-                    ui->statusClearedErrors->setText(QString::number(events->totalClearedErrors));
-
-                    if (notifyOnErrorCleared) notifyUser("Error " + message.left(message.indexOf(DELIMETER)) + " Cleared", false);
-                }
-
-                #if DEV_MODE
-                //update the cleared error selection box in dev tools (can be removed when dev page is removed)
-                update_non_cleared_error_selection();
-                #endif
+                //clears are applied in bulk once the burst of clear messages ends
+                pendingClears.append(frame.clear.errorId);
 
                 break;
 
             case BEGIN:
                 // BEGIN MESSAGE TYPE
                 #if DEV_MODE && SERIAL_COMM_DEBUG
-                qDebug() << "Message id: begin " << message << qPrintable("\n");
+                qDebug() << "Message id: begin " << frame.payload << qPrintable("\n");
                 #endif
 
-                //load controller crc and version, check for fail
-                if (!status->loadVersionData(message))
+                //check for invalid controller crc and version
+                if (!frame.valid)
                 {
                     //report
-                    notifyUser("Invalid 'begin' message received", message, true);
+                    notifyUser("Invalid 'begin' message received", QString::fromUtf8(frame.payload), true);
 
                     //end connection attempt
-                    ddmCon->sendDisconnectMsg();
+                    QMetaObject::invokeMethod(ddmCon, &Connection::sendDisconnectMsg);
                 }
                 //otherwise success
                 else
                 {
+                    //load controller crc and version
+                    status->loadVersionData(frame.begin);
+
+                    #if DEV_MODE
+                    frame.timestamps.mark(STAGE_STORED);
+                    #endif
+
                     notifyUser("Handshake complete", "Session start", false);
 
                     //set connection status to connected and update related objects
@@ -684,10 +833,10 @@ void MainWindow::readSerialData()
 
             default:
                 // invalid message id detected
-                qDebug() << "ERROR: readSerialData message from controller is not recognized"<< Qt::endl;
+                qDebug() << "ERROR: processSerialFrames message from controller is not recognized"<< Qt::endl;
 
                 //report
-                notifyUser("Unrecognized message received", QString::fromUtf8(serializedMessage), true);
+                notifyUser("Unrecognized message received", QString::fromUtf8(frame.message), true);
 
                 break;
             }
@@ -695,11 +844,42 @@ void MainWindow::readSerialData()
         //invalid message id detected
         else
         {
-            qDebug() << "Error: readSerialData Unrecognized serial message received : " << message<< Qt::endl;
-            notifyUser("Unrecognized serial message received", QString::fromUtf8(serializedMessage), true);
+            qDebug() << "Error: processSerialFrames Unrecognized serial message received : " << frame.message<< Qt::endl;
+            notifyUser("Unrecognized serial message received", QString::fromUtf8(frame.message), true);
+        }
+
+        #if DEV_MODE
+        //clear error messages are recorded once their clears are applied, other messages
+        //are recorded once anything they changed is rendered
+        if (frame.hasMessageId && frame.messageId == CLEAR_ERROR && frame.valid)
+        {
+            pendingClearTimes.append(frame.timestamps);
+        }
+        else
+        {
+            latency.frameHandled(frame.hasMessageId ? frame.messageId : -1, frame.timestamps, renderTimer->isActive());
         }
+        #endif
+    }
+    // end loop processing decoded messages
+
+    //apply clears that ended the batch
+    if (!pendingClears.isEmpty())
+    {
+        applyErrorClears(pendingClears);
+
+        #if DEV_MODE
+        recordClearLatencies(pendingClearTimes);
+        #endif
+    }
+
+    //report bytes the serial reader dropped while the gui was behind
+    qint64 droppedBytes = serialReader->droppedBytes.exchange(0, std::memory_order_relaxed);
+    if (droppedBytes > 0)
+    {
+        notifyUser("Serial data dropped, messages arrived faster than they were shown",
+                   QString::number(droppedBytes) + " bytes", true);
     }
-    // end while loop checking for more data in buffer
 
     // update the timestamp of last received message
     timeLastReceived = QDateTime::currentDateTime();
@@ -708,6 +888,60 @@ void MainWindow::readSerialData()
     lastMessageTimer->start();
 }
 
+/**
+ * @brief Clears a burst of errors reported by the controller
+ *
+ * The errors are cleared in the events class and log file together, then each
+ * result is reported and the events output is updated.
+ *
+ * @param errorIds The ids of the errors to clear, emptied once they are applied
+ */
+void MainWindow::applyErrorClears(QVector<int> &errorIds)
+{
+    //attempt clear
+    QVector<int> results = events->clearErrors(errorIds, *logWriter);
+
+    for (qsizetype i = 0; i < errorIds.size(); i++)
+    {
+        int result = results[i];
+
+        //check for fail (here failed to clear from ll indicates RAM dump)
+        if (result != SUCCESS && result != FAILED_TO_CLEAR_FROM_LL)
+        {
+            //notify user of fail type
+            if (result == FAILED_TO_CLEAR)
+            {
+                notifyUser("Failed to clear error", QString::number(errorIds[i]), true);
+            }
+            else if (result == FAILED_TO_CLEAR_FROM_LOGFILE)
+            {
+                notifyUser("Error "+ QString::number(errorIds[i]) + " can't be cleared from logfile", true);
+            }
+        }
+        //otherwise success
+        else
+        {
+            //attempt to clear in events output
+            if (result == SUCCESS) clearErrorFromEventsOutput(errorIds[i]);
+
+            //errors cleared from RAM are still cleared in the search index
+            eventSearch->errorCleared(errorIds[i]);
+
+            if (notifyOnErrorCleared) notifyUser("Error " + QString::number(errorIds[i]) + " Cleared", false);
+        }
+    }
+
+    //update counters on the next render
+    scheduleRender(RENDER_COUNTERS);
+
+    #if DEV_MODE
+    //update the cleared error selection box in dev tools (can be removed when dev page is removed)
+    scheduleRender(RENDER_ERROR_SELECTION);
+    #endif
+
+    errorIds.clear();
+}
+
 /**
  * @brief Scans for available serial ports and populates the DDM port selection box
  *
@@ -730,10 +964,24 @@ void MainWindow::setup_ddm_port_selection(int index)
     //clear any current selections
     ui->ddm_port_selection->clear();
 
-    // Fetch available serial ports and add their names to the combo box
+    // Fetch available serial ports
+    QStringList portNames;
     foreach (const QSerialPortInfo &info, QSerialPortInfo::availablePorts())
     {
-        QString portName = info.portName();
+        portNames.append(info.portName());
+    }
+
+    #if DEV_MODE
+    // loopback ports reach csim without a serial cable
+    portNames.append(LOOPBACK_PIPE_PORT);
+    #ifdef Q_OS_UNIX
+    portNames.append(CSIM_PTY_LINK);
+    #endif
+    #endif
+
+    // add their names to the combo box
+    for (const QString &portName : portNames)
+    {
         ui->ddm_port_selection->addItem(portName);
 
         // Check if the current port name matches the one declared in settings
@@ -767,6 +1015,10 @@ void MainWindow::disableConnectionChanges()
     ui->restore_Button->setDisabled(true);
     ui->refresh_serial_port_selections->setVisible(false);
     ui->setLogfileFolder->setDisabled(true);
+    connectionChangesLocked = true;
+
+    //a log file must not replace the events of a session
+    logFileLoader->cancel();
 }
 
 /**
@@ -780,10 +1032,11 @@ void MainWindow::enableConnectionChanges()
     ui->parity_selection->setEnabled(true);
     ui->stop_bit_selection->setEnabled(true);
     ui->flow_control_selection->setEnabled(true);
-    ui->load_events_from_logfile->setEnabled(true);
+    ui->load_events_from_logfile->setEnabled(!logFileLoader->isRunning());
     ui->restore_Button->setEnabled(true);
     ui->refresh_serial_port_selections->setVisible(true);
     ui->setLogfileFolder->setEnabled(true);
+    connectionChangesLocked = false;
 }
 
 /**
@@ -808,6 +1061,9 @@ void MainWindow::setup_logfile_location()
         if(!dir.mkpath(autosaveLogFile))
         {
             qDebug() << "Error: setup_logfile_location Failed to create logfile folder on startup: " << autosaveLogFile<< Qt::endl;
+
+            //dont write this session to the previous session's log file
+            logWriter->setFileName(QString());
             return;
         }
     }
@@ -818,6 +1074,7 @@ void MainWindow::setup_logfile_location()
     // set unique logfile name for this session
     qint64 secsSinceEpoch = QDateTime::currentSecsSinceEpoch();
     autosaveLogFile += QString::number(secsSinceEpoch) + "-logfile-A.txt";
+    logWriter->setFileName(autosaveLogFile);
 
     notifyUser("Auto save log set", autosaveLogFile, false);
 }
@@ -893,6 +1150,9 @@ void MainWindow::enforceAutoSaveLimit()
             #endif
         }
 
+        // Remove its log view index, if it was ever viewed
+        QFile::remove(oldestFilePath + LOG_VIEW_INDEX_SUFFIX);
+
         // Remove the oldest file name from the list
         autoSaveFileList.removeOne(QFileInfo(oldestFilePath).fileName());
     }
@@ -959,6 +1219,20 @@ void MainWindow::setupSettings()
 
     //==============================================================
 
+    // Check if the record sessions setting does not exist
+    if (!userSettings.contains("recordSessions") || !userSettings.value("recordSessions").isValid()) {
+        // set the default value
+        userSettings.setValue("recordSessions", INITIAL_RECORD_SESSIONS);
+    }
+
+    //set session variable based on setting
+    recordSessions = userSettings.value("recordSessions").toBool();
+
+    //set gui display to match
+    ui->record_sessions->setChecked(recordSessions);
+
+    //==============================================================
+
     // Check if the cleared error notification setting does not exist
     if (!userSettings.contains("notifyOnErrorCleared") || !userSettings.value("notifyOnErrorCleared").isValid()) {
         // set the default value
@@ -1191,180 +1465,178 @@ void MainWindow::updateTimeSinceLastMessage()
 }
 
 /**
- * @brief Appends to the events text box on the GUI and dynamically colors output
+ * @brief Appends to the events list on the GUI
+ *
+ * The node is added to the events list if the selected filter allows it, the list
+ * delegate colors it by its type. The new row and the event and error counters are
+ * shown by the next render.
+ *
+ * @param event The event/error node containing the message information
+ */
+void MainWindow::updateEventsOutput(EventRecord event)
+{
+    //only adds a row, existing rows are not formatted again
+    eventsModel->append(event);
+
+    scheduleRender(RENDER_EVENTS_TAIL | RENDER_COUNTERS);
+}
+
+/**
+ * @brief Marks gui parts to be redrawn
  *
- * This method determines the type of message it is, and outputs it to the text box on the
- * GUI with color coding depending on its type. It also validates if any filters are set.
+ * The first part marked starts the render timer, parts marked before it expires are
+ * redrawn together.
  *
- * @param event A pointer to the eventNode containing the message information
+ * @param regions RenderRegion flags of the parts that changed
  */
-void MainWindow::updateEventsOutput(EventNode *event)
+void MainWindow::scheduleRender(int regions)
 {
-    QTextDocument document;
-    QString richText;
-    QString outString = events->nodeToString(event);
+    dirtyRegions |= regions;
 
-    //check if we have an event as input and check if filter allows printing events
-    if (!event->isError() )
+    if (!renderTimer->isActive())
     {
-        if (eventFilter == EVENTS || eventFilter == ALL)
-        {
-            //change output text color to white
-            richText = "<p style='color: "+EVENT_COLOR+"; font-size: "+EVENT_OUTPUT_SIZE+"px'>"+ outString + "</p>";
+        renderTimer->start();
+    }
+}
+
+/**
+ * @brief Redraws every gui part marked since the last render
+ */
+void MainWindow::renderDirtyRegions()
+{
+    int regions = dirtyRegions;
+    dirtyRegions = 0;
+
+    if (regions & RENDER_EVENTS_TAIL)
+    {
+        //keep following new rows if the user is already at the bottom of the list
+        QScrollBar *scrollBar = ui->events_output->verticalScrollBar();
+        bool atBottom = scrollBar->value() == scrollBar->maximum() && !isLogViewShown();
 
-            //activate html for the output
-            document.setHtml(richText);
+        //every row added since the last render is inserted at once
+        eventsModel->publishRows();
 
-            //append styled string to the events output
-            ui->events_output->append(document.toHtml());
+        if (atBottom)
+        {
+            ui->events_output->scrollToBottom();
         }
     }
-    //otherwise check for cleared error and if filter allows printing cleared errors
-    else if (static_cast<ErrorNode *>(event)->cleared)
+
+    if (regions & RENDER_COUNTERS)
     {
-        if (eventFilter == ALL || eventFilter == ERRORS || eventFilter == CLEARED_ERRORS)
-        {
-            if (coloredEventOutput)
-            {
-                //change output text color to green
-                richText = "<p style='color: "+CLEARED_ERROR_COLOR+"; font-size: "+EVENT_OUTPUT_SIZE+"px'>"+ outString + "</p>";
-            }
-            else
-            {
-                //change output text color to white
-                richText = "<p style='color: "+EVENT_COLOR+"; font-size: "+EVENT_OUTPUT_SIZE+"px'>"+ outString + "</p>";
-            }
+        updateEventCounters();
+    }
 
-            //activate html for the output
-            document.setHtml(richText);
+    if (regions & RENDER_STATUS)
+    {
+        updateStatusDisplay();
+    }
 
-            //append styled string to the events output
-            ui->events_output->append(document.toHtml());
-        }
+    if (regions & RENDER_ELECTRICAL)
+    {
+        renderElectricalPage();
     }
-    //otherwise this is a non-cleared error check if filtering allows printing non-cleared errors
-    else if (eventFilter == ALL || eventFilter == NON_CLEARED_ERRORS || eventFilter == ERRORS)
+
+    if (regions & RENDER_NOTIFICATIONS)
     {
-        if (coloredEventOutput)
-        {
-            //change output text color to red
-            richText = "<p style='color: "+ACTIVE_ERROR_COLOR+"; font-size: "+EVENT_OUTPUT_SIZE+"px'>"+ outString + "</p>";
-        }
-        else
-        {
-            //change output text color to white
-            richText = "<p style='color: "+EVENT_COLOR+"; font-size: "+EVENT_OUTPUT_SIZE+"px'>"+ outString + "</p>";
-        }
+        updateNotificationDisplay();
+    }
 
-        //activate html for the output
-        document.setHtml(richText);
+    #if DEV_MODE
+    if (regions & RENDER_ERROR_SELECTION)
+    {
+        update_non_cleared_error_selection();
+    }
 
-        //append styled string to the events output
-        ui->events_output->append(document.toHtml());
+    if (regions & RENDER_LAST_MESSAGE)
+    {
+        ui->stdout_label->setText(QString::fromUtf8(lastFrameMessage));
     }
 
+    //every frame handled since the last render is now on screen
+    latency.rendered();
+    #endif
+}
+
+/**
+ * @brief Checks if the events page shows a log file rather than the session's events
+ */
+bool MainWindow::isLogViewShown() const
+{
+    return ui->events_output->model() == logViewModel;
+}
+
+/**
+ * @brief Shows the session's events on the events page again and unmaps the viewed log file
+ */
+void MainWindow::closeLogView()
+{
+    QItemSelectionModel *selection = ui->events_output->selectionModel();
+    ui->events_output->setModel(eventsModel);
+    delete selection;
+    ui->events_output->scrollToBottom();
+    logViewModel->close();
+
+    ui->view_log_file->setText("View Log File");
+    ui->searchButton->setEnabled(true);
+}
+
+/**
+ * @brief Sets every event and error counter on the GUI
+ */
+void MainWindow::updateEventCounters()
+{
     // update total events gui
     ui->TotalEventsOutput->setText(QString::number(events->totalEvents));
     ui->statusEventOutput->setText(QString::number(events->totalEvents));
 
-    if (!event->isError()) return;
-
     // update total errors gui
     ui->TotalErrorsOutput->setText(QString::number(events->totalErrors));
     ui->statusErrorOutput->setText(QString::number(events->totalErrors));
 
-    if ( static_cast<ErrorNode *>(event)->cleared )
-    {
-        // update cleared errors gui
-        ui->ClearedErrorsOutput->setText(QString::number(events->totalClearedErrors));
-        ui->statusClearedErrors->setText(QString::number(events->totalClearedErrors));
-    }
-    else
-    {
-        // update active errors gui
-        ui->ActiveErrorsOutput->setText(QString::number(events->totalErrors - events->totalClearedErrors));
-    }
+    // update cleared errors gui
+    ui->ClearedErrorsOutput->setText(QString::number(events->totalClearedErrors));
+    ui->statusClearedErrors->setText(QString::number(events->totalClearedErrors));
+
+    // update active errors gui
+    ui->ActiveErrorsOutput->setText(QString::number(events->totalErrors - events->totalClearedErrors));
 }
 
 /**
- * @brief Empties the entire events text box on the GUI and repopulates it with the current data
+ * @brief Rebuilds the events list on the GUI from the current data
+ *
+ * Must be called whenever the events class is replaced or its nodes are freed.
  */
 void MainWindow::refreshEventsOutput()
 {
-    // reset gui element
-    ui->events_output->clear();
-
-    //init vars
-    ErrorNode *wkgErrPtr = events->headErrorNode;
-    EventNode *wkgEventPtr = events->headEventNode;
-    EventNode *nextPrintPtr;
+    //rows are rebuilt from the events store, their text is generated when drawn
+    eventsDelegate->setColored(coloredEventOutput);
+    eventsModel->reset(events, eventFilter);
 
-    //loop through all events and errors
-    while(wkgErrPtr != nullptr || wkgEventPtr != nullptr)
+    if (!isLogViewShown())
     {
-        // get next to print
-        nextPrintPtr = events->getNextNode(wkgEventPtr, wkgErrPtr);
-
-        //update events output if filter allows
-        updateEventsOutput(nextPrintPtr);
+        ui->events_output->scrollToBottom();
     }
 
+    updateEventCounters();
+
     #if DEV_MODE && GUI_DEBUG
     qDebug() << "Events output refreshed";
     #endif
 }
 
 /**
- * @brief Clears an error from the events output by replacing the active/cleared indicator
+ * @brief Clears an error from the events output by moving or redrawing its row
  * @param errorId The ID of the error to be cleared
  */
 void MainWindow::clearErrorFromEventsOutput(int errorId)
 {
-    //if user is on specific error filter, refresh to update their screen
-    if (eventFilter == NON_CLEARED_ERRORS || eventFilter == CLEARED_ERRORS)
-    {
-        refreshEventsOutput();
-        return;
-    }
-
-    QTextCharFormat newColor;
-    if (coloredEventOutput)
-    {
-        newColor.setForeground(QColor(20, 174, 92));
-    }
-
-    // Get the QTextDocument of the QTextEdit
-    QTextDocument *document = ui->events_output->document();
-
-    // Create a QTextCursor to manipulate the text
-    QTextCursor cursor(document);
+    //the error moves from the active to the cleared errors rows, its row is drawn
+    //with the indicator and color from the events store
+    EventRecord error = events->store.findError(errorId);
 
-    // Move to the beginning of the document
-    cursor.movePosition(QTextCursor::Start);
-
-    cursor = document->find("ID: " + QString::number(errorId) + ",", cursor, QTextDocument::FindWholeWords);
-    if (!cursor.isNull())
+    if (!error.isNull() && eventsModel->errorCleared(error))
     {
-        if (coloredEventOutput)
-        {
-            //store our starting place
-            QTextCursor tmpCursor = cursor;
-
-            //highlight the entire line
-            cursor.movePosition(QTextCursor::EndOfLine, QTextCursor::KeepAnchor);
-
-            // Apply new color to the highlighted text
-            cursor.mergeCharFormat(newColor);
-
-            //move cursor to prev position
-            cursor = tmpCursor;
-        }
-
-        //find active error indicator
-        cursor = document->find(events->activeIndicator, cursor, QTextDocument::FindWholeWords);
-        // Replace active indicator with cleared indicator
-        cursor.insertText(events->clearedIndicator);
-
         #if DEV_MODE && (EVENTS_DEBUG || GUI_DEBUG)
         qDebug() << "Cleared error " << errorId << " on events output";
         #endif
@@ -1393,7 +1665,8 @@ void MainWindow::notifyUser(QString notificationText, bool error)
  *
  * The notification is rendered for the user for a few seconds. If it is an error,
  * this is considered "urgent" and there will be a red indicator on the notification
- * bell indicating that there is an unread error message.
+ * bell indicating that there is an unread error message. Notifications are shown by
+ * the next render, so a burst of notifications only updates the GUI once.
  *
  * @param notificationText The string message to display to the user
  * @param logText Log information to be displayed
@@ -1402,12 +1675,7 @@ void MainWindow::notifyUser(QString notificationText, bool error)
 void MainWindow::notifyUser(QString notificationText, QString logText, bool error)
 {
     // Get the current timestamp
-    QString timeStamp = QDateTime::currentDateTime().toString("[" + TIME_FORMAT +"] ");
-
-    QString notificationRichText = "<p style='" + NOTIFICATION_TIMESTAMP_STYLE + "'>" + timeStamp +
-                                   " " + "<span style='color: ";
-
-    QString popUpStyle = "border: 3px solid ";
+    QString timeStamp = QDateTime::currentDateTime().toString("[" + TIME_FORMAT +"]");
 
     // get new lines as literals
     notificationText.replace("\n", "\\n");
@@ -1416,38 +1684,44 @@ void MainWindow::notifyUser(QString notificationText, QString logText, bool erro
     {
         //replace new line literals with \n symbols
         logText.replace("\n", "\\n");
-        notificationRichText += ERROR_COLOR;
-        popUpStyle += ERROR_COLOR;
-    }
-    else
-    {
-        notificationRichText += STANDARD_COLOR;
-        popUpStyle += STANDARD_COLOR;
+        urgentNotification = true;
     }
-    notificationRichText += "; font-size: "+NOTIFICATION_SIZE+"px'>" + notificationText;
-    popUpStyle += "; " + POP_UP_STYLE;
 
-    if (logText != "")
-    {
-        notificationRichText += " : " + logText;
-    }
-    notificationRichText+= + "</span></p>";
+    //add full notification to notification page, repeats of recent notifications are merged
+    notificationsModel->add(timeStamp, notificationText, logText, error);
+
+    scheduleRender(RENDER_NOTIFICATIONS);
+}
+
+/**
+ * @brief Shows the latest notification on the "navbar" and updates the notification counters
+ */
+void MainWindow::updateNotificationDisplay()
+{
+    QString popUpStyle = "border: 3px solid ";
+    popUpStyle += notificationsModel->latestIsError() ? ERROR_COLOR : STANDARD_COLOR;
+    popUpStyle += "; " + POP_UP_STYLE;
 
     //set pop up style
     ui->notificationPopUp->setStyleSheet(popUpStyle);
 
-    //add full notification to notification page output
-    ui->notificationOutput->append(notificationRichText);
-
     //display notification on "navbar"
-    ui->notificationPopUp->setText(notificationText);
+    ui->notificationPopUp->setText(notificationsModel->latestText());
+
+    //update severity counters
+    ui->NotificationTitle->setText("Notifications (Errors: " + QString::number(notificationsModel->totalErrors())
+                                   + ", Info: " + QString::number(notificationsModel->totalInfo()) + ")");
+
+    //keep following new notifications
+    ui->notificationOutput->scrollToBottom();
 
     //check if user is on notification page, and if this is an error
-    if (ui->Flow_Label->currentIndex() != 6 && error)
+    if (ui->Flow_Label->currentIndex() != 6 && urgentNotification)
     {
         //update the notification icon to get user attention
         ui->NotificationPageButton->setStyleSheet(URGENT_NOTIFICATION_ICON);
     }
+    urgentNotification = false;
 
     //stop old timer if running
     notificationTimer->stop();
@@ -1486,8 +1760,6 @@ void MainWindow::logAdvancedDetails(SerialMessageIdentifier id)
         return;
     }
 
-    //retreive the given file
-    QFile file(autosaveLogFile);
     QString outString;
 
     //get proper msg id
@@ -1512,26 +1784,21 @@ void MainWindow::logAdvancedDetails(SerialMessageIdentifier id)
             break;
     }
 
-    //attempt to open in append mode
-    if (!file.open(QIODevice::Append | QIODevice::Text))
+    //append the text to the log file
+    if (logWriter->writeLine(outString.toUtf8()) < 0)
     {
         qDebug() <<  "Error: logAdvancedDetails Could not open log file for appending: " << autosaveLogFile << Qt::endl;
         notifyUser("Failed to open logfile", "log text \"" + outString + "\" discarded", true);
     }
-    else
-    {
-        //append the text to the log file
-        QTextStream out(&file);
-        out << outString << Qt::endl;
-        file.close();
-    }
 }
 
 /**
  * @brief Dynamically populates the eletrical page using data from the Electrical class
  *
  * This method renders the widgets for displaying the electrical boxes side by side in
- * the GUI. Each electrical box corresponds to a node in the linked list
+ * the GUI. Each electrical box corresponds to a node in the linked list. Boxes are kept
+ * between dumps, components that were already shown only have their values updated,
+ * and the boxes are only laid out again when components are added or removed.
  */
 void MainWindow::renderElectricalPage()
 {
@@ -1541,78 +1808,79 @@ void MainWindow::renderElectricalPage()
         return;
     }
 
-    // Get the parent container into a widget object
-    QWidget *elecParentContainer = ui->scrollAreaWidgetContents;
+    // Check if the vertical layout exists
+    if (qobject_cast<QVBoxLayout*>(ui->scrollAreaWidgetContents->layout()) == nullptr)
+    {
+        // Vertical layout doesn't exist, handle error or create it
+        qDebug() << "Error: renderElectricalPage No vertical layout found for elecParentContainer";
+        notifyUser("Error rendering electrical page", "Turn on advanced log file on settings page to view electrical data at the end of the session",true);
+        return;
+    }
 
-    // Find the existing vertical layout of elecParentContainer
-    QVBoxLayout *verticalLayout = qobject_cast<QVBoxLayout*>(elecParentContainer->layout());
+    //keys of the components in this dump, in order
+    QStringList keys;
+    QHash<QString, int> occurrences;
 
-    // Check if the vertical layout already exists
-    if (verticalLayout)
+    //loop through the electrical linked list
+    for (electricalNode *wkgPtr = electricalData->headNode; wkgPtr != nullptr; wkgPtr = wkgPtr->nextNode)
     {
-        // Set the alignment of the vertical layout to top
-        verticalLayout->setAlignment(Qt::AlignTop);
+        //components sharing a name are told apart by their occurrence
+        int occurrence = occurrences[wkgPtr->name]++;
+        QString key = (occurrence == 0) ? wkgPtr->name : wkgPtr->name + "#" + QString::number(occurrence);
+        keys.append(key);
 
-        // Set the margins of the scroll area's contents
-        verticalLayout->setSpacing(0);
+        auto box = electricalBoxes.find(key);
 
-        //get wkg pointer at head of electrical ll
-        electricalNode *wkgPtr = electricalData->headNode;
-
-        //loop through the electrical linked list
-        while (wkgPtr != nullptr)
+        //new component, create its box
+        if (box == electricalBoxes.end())
         {
-            // create a horizontal widget (for displaying 2 electrical boxes side by side)
-            QWidget *horizontalWidget = new QWidget(elecParentContainer);
-
-            // create a layout for the horizontal widget
-            QHBoxLayout *horizontalLayout = new QHBoxLayout(horizontalWidget);
-
-            //remove pre set spacing
-            horizontalLayout->setContentsMargins(0, 0, 0, 0);
-            horizontalLayout->setSpacing(0);
-
-            //add a box for this node
-            addElecBox(horizontalWidget, horizontalLayout, wkgPtr);
-
-            //get next node
-            wkgPtr=wkgPtr->nextNode;
-
-            //check if we have not reached end of ll
-            if (wkgPtr != nullptr)
-            {
-                //add next box to the horizontal layout
-                addElecBox(horizontalWidget, horizontalLayout, wkgPtr);
-
-                //get next node
-                wkgPtr = wkgPtr->nextNode;
-            }
-
-            // Set the horizontal layout for the widget
-            horizontalWidget->setLayout(horizontalLayout);
+            electricalBoxes.insert(key, addElecBox(wkgPtr));
+            continue;
+        }
 
-            // Add the horizontal widget to the existing vertical layout
-            verticalLayout->addWidget(horizontalWidget);
+        //known component, only update values that changed
+        QString contentText = "Voltage: " + QString::number(wkgPtr->voltage) +
+                              "\nAmps: " + QString::number(wkgPtr->amps);
+        if (contentText != box->contentText)
+        {
+            box->content->setPlainText(contentText);
+            box->contentText = contentText;
         }
     }
-    else
+
+    //the same components in the same order keep their places
+    if (keys == electricalBoxOrder)
     {
-        // Vertical layout doesn't exist, handle error or create it
-        qDebug() << "Error: renderElectricalPage No vertical layout found for elecParentContainer";
-        notifyUser("Error rendering electrical page", "Turn on advanced log file on settings page to view electrical data at the end of the session",true);
+        return;
+    }
+
+    //remove boxes of components missing from this dump
+    QSet<QString> dumpKeys(keys.cbegin(), keys.cend());
+    for (auto box = electricalBoxes.begin(); box != electricalBoxes.end();)
+    {
+        if (!dumpKeys.contains(box.key()))
+        {
+            box->box->deleteLater();
+            box = electricalBoxes.erase(box);
+        }
+        else
+        {
+            ++box;
+        }
     }
+
+    layoutElectricalBoxes(keys);
 }
 
 /**
- * @brief Adds an electrical box widget to the layout
- * @param horizontalWidget The parent horizontal widget
- * @param horizontalLayout The horizontal layout to which the box will be added to
+ * @brief Creates an electrical box widget
  * @param component The eletrical node containing the data to be displayed in the box
+ * @return The box and the widget showing its values
  */
-void MainWindow::addElecBox(QWidget *horizontalWidget, QLayout *horizontalLayout, electricalNode *component)
+MainWindow::ElectricalBox MainWindow::addElecBox(electricalNode *component)
 {
     //Create vertical layout (for header on top of content)
-    QWidget *elecBox = new QWidget(horizontalWidget);
+    QWidget *elecBox = new QWidget(ui->scrollAreaWidgetContents);
     QVBoxLayout *elecBoxLayout = new QVBoxLayout(elecBox);
     elecBoxLayout->setContentsMargins(3, 0, 3, 13);
     elecBoxLayout->setSpacing(0);
@@ -1627,37 +1895,104 @@ void MainWindow::addElecBox(QWidget *horizontalWidget, QLayout *horizontalLayout
     elecBoxLayout->addWidget(elecBoxTitle);
 
     //create box content
+    QString contentText = "Voltage: " + QString::number(component->voltage) +
+                          "\nAmps: " + QString::number(component->amps);
     QTextEdit *elecBoxContent = new QTextEdit( elecBox);
     elecBoxContent->setAlignment(Qt::AlignCenter);
-    elecBoxContent->setPlainText("Voltage: " + QString::number(component->voltage) +
-                                 "\nAmps: " + QString::number(component->amps));
+    elecBoxContent->setPlainText(contentText);
     elecBoxContent->setStyleSheet(ELECTRICAL_BOX_CONTENT_STYLE);
     elecBoxContent->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Fixed); // Set expanding size policy
     elecBoxContent->setFixedHeight(100);
 
-    //add box to layout
+    //add content to the box
     elecBoxLayout->addWidget(elecBoxContent);
     elecBox->setLayout(elecBoxLayout);
-    horizontalLayout->addWidget(elecBox);
+
+    return ElectricalBox{elecBox, elecBoxContent, contentText};
+}
+
+/**
+ * @brief Places the electrical boxes in rows of 2 on the electrical page
+ *
+ * Rows are reused, only missing rows are created and extra rows deleted.
+ *
+ * @param keys Keys of the boxes, in the order they are displayed
+ */
+void MainWindow::layoutElectricalBoxes(const QStringList &keys)
+{
+    // Find the existing vertical layout of the electrical page
+    QVBoxLayout *verticalLayout = qobject_cast<QVBoxLayout*>(ui->scrollAreaWidgetContents->layout());
+
+    // Set the alignment of the vertical layout to top
+    verticalLayout->setAlignment(Qt::AlignTop);
+
+    // Set the margins of the scroll area's contents
+    verticalLayout->setSpacing(0);
+
+    //take every box out of its row
+    for (QWidget *row : electricalRows)
+    {
+        while (QLayoutItem *item = row->layout()->takeAt(0))
+        {
+            delete item;
+        }
+    }
+
+    //create any missing rows (for displaying 2 electrical boxes side by side)
+    qsizetype rowsNeeded = (keys.size() + 1) / 2;
+    while (electricalRows.size() < rowsNeeded)
+    {
+        // create a horizontal widget
+        QWidget *horizontalWidget = new QWidget(ui->scrollAreaWidgetContents);
+
+        // create a layout for the horizontal widget
+        QHBoxLayout *horizontalLayout = new QHBoxLayout(horizontalWidget);
+
+        //remove pre set spacing
+        horizontalLayout->setContentsMargins(0, 0, 0, 0);
+        horizontalLayout->setSpacing(0);
+
+        // Set the horizontal layout for the widget
+        horizontalWidget->setLayout(horizontalLayout);
+
+        // Add the horizontal widget to the existing vertical layout
+        verticalLayout->addWidget(horizontalWidget);
+        electricalRows.append(horizontalWidget);
+    }
+
+    //add the boxes in order, adding a box to a row moves it into that row
+    for (qsizetype i = 0; i < keys.size(); i++)
+    {
+        QWidget *box = electricalBoxes.value(keys[i]).box;
+        electricalRows[i / 2]->layout()->addWidget(box);
+        box->show();
+    }
+
+    //extra rows no longer hold any boxes
+    while (electricalRows.size() > rowsNeeded)
+    {
+        electricalRows.takeLast()->deleteLater();
+    }
+
+    electricalBoxOrder = keys;
 }
 
 /**
  * @brief Frees the memory allocated for widgets in the electrical page
  *
- * Iterates over all child widgets in the electrical scroll area and deletes them
+ * Deletes every row of the electrical page along with the boxes laid out in them
  */
 void MainWindow::freeElectricalPage()
 {
-    QWidget *scrollAreaWidgetContents = ui->scrollAreaWidgetContents;
-
-    // Iterate over all children of scrollAreaWidgetContents
-    QList<QWidget*> children = scrollAreaWidgetContents->findChildren<QWidget*>();
-    for (QWidget *child : children) {
-        // Check if the child is not the scrollAreaWidgetContents itself
-        if (child != scrollAreaWidgetContents) {
-            child->deleteLater(); // Schedule the child widget for deletion
-        }
+    // rows own the boxes laid out in them
+    for (QWidget *row : electricalRows)
+    {
+        row->deleteLater(); // Schedule the row widget for deletion
     }
+
+    electricalRows.clear();
+    electricalBoxes.clear();
+    electricalBoxOrder.clear();
 }
 
 /**
@@ -1676,15 +2011,196 @@ void MainWindow::handleRAMClear()
     //show truncated label on the events page to tell user not all nodes are displayed
     ui->truncated_label->setVisible(true);
 
+    //cleared nodes are only in the log file, the search index drops them with the store
+    eventSearch->storeCleared();
+
     //get rid of outdated display
     refreshEventsOutput();
 }
 
+/**
+ * @brief Shows a log file on the events page once it has been indexed
+ *
+ * This slot is triggered by the log view model when a log file opened from the events
+ * page is ready to be shown.
+ *
+ * @param result SUCCESS or LOAD_CANCELLED
+ */
+void MainWindow::logViewIndexed(int result)
+{
+    if (result == LOAD_CANCELLED)
+    {
+        ui->view_log_file->setText("View Log File");
+        notifyUser("Log view cancelled.", logViewModel->fileName(), false);
+        return;
+    }
+
+    //rows are read from the log file as they are drawn
+    logViewModel->setFilter(eventFilter);
+    QItemSelectionModel *selection = ui->events_output->selectionModel();
+    ui->events_output->setModel(logViewModel);
+    delete selection;
+    ui->events_output->scrollToTop();
+
+    //search only indexes the session's events, so it is off while a log file is shown
+    ui->searchButton->setEnabled(false);
+
+    ui->view_log_file->setText("Close Log View");
+    notifyUser("Viewing logfile, search is off until the log view is closed.", logViewModel->fileName(), false);
+}
+
+/**
+ * @brief Shows the events of a log file once it has been loaded
+ *
+ * This slot is triggered by the log file loader when a load started on the events
+ * page ends.
+ *
+ * @param result SUCCESS, INCORRECT_FORMAT or LOAD_CANCELLED
+ */
+void MainWindow::logFileLoaded(int result)
+{
+    QString loadedFile = logFileLoader->fileName();
+
+    //no session is starting or running
+    bool disconnected = !connectionChangesLocked;
+
+    //a new log file can be chosen
+    ui->load_events_from_logfile->setEnabled(disconnected);
+
+    //a session started while the file was loading
+    if (result == SUCCESS && !disconnected)
+    {
+        delete logFileLoader->takeEvents();
+        result = LOAD_CANCELLED;
+    }
+
+    if (result == INCORRECT_FORMAT)
+    {
+        qDebug() << "Error: logFileLoaded() Log file was of incorrect format." << Qt::endl;
+        notifyUser("Load failed on corrupt logfile.", loadedFile, true);
+        return;
+    }
+    else if (result == LOAD_CANCELLED)
+    {
+        notifyUser("Logfile load cancelled.", loadedFile, false);
+        return;
+    }
+
+    //replace the events class with the loaded events
+    Events::replaceEvents(events, logFileLoader->takeEvents());
+    connect(events, &Events::RAMCleared, this, &MainWindow::handleRAMClear);
+
+    notifyUser("Logfile loaded.", loadedFile, false);
+    ui->truncated_label->setVisible(false);
+
+    //refresh the events output and search index
+    refreshEventsOutput();
+    eventSearch->rebuild(events->store);
+}
+
+/**
+ * @brief Starts capturing the frames received this session
+ *
+ * The capture is saved in the log file folder, it is started with the handshake so it
+ * holds the controller's reply to it.
+ */
+void MainWindow::startSessionCapture()
+{
+    if (serialReader == nullptr)
+    {
+        return;
+    }
+
+    stopSessionCapture();
+
+    QString fileName = userSettings.value("logfileLocation").toString()
+                       + QString::number(QDateTime::currentSecsSinceEpoch()) + SESSION_CAPTURE_SUFFIX;
+
+    if (serialReader->startCapture(fileName))
+    {
+        sessionCaptureFile = fileName;
+    }
+    else
+    {
+        notifyUser("Failed to start session capture", fileName, true);
+    }
+}
+
+/**
+ * @brief Stops capturing the frames received this session
+ */
+void MainWindow::stopSessionCapture()
+{
+    if (sessionCaptureFile.isEmpty())
+    {
+        return;
+    }
+
+    qint64 frames = (serialReader != nullptr) ? serialReader->stopCapture() : 0;
+
+    //a handshake that was never answered leaves nothing to replay
+    if (frames == 0)
+    {
+        QFile::remove(sessionCaptureFile);
+    }
+    else
+    {
+        notifyUser("Session capture saved", sessionCaptureFile + " (" + QString::number(frames) + " messages)", false);
+    }
+
+    sessionCaptureFile.clear();
+}
+
 //======================================================================================
 //DEV_MODE exclusive methods
 //======================================================================================
 
 #if DEV_MODE
+/**
+ * @brief Reports the end of a session replay
+ *
+ * @param frames Frames replayed, -1 if the replay could not start
+ * @param elapsedMs Time taken to send the frames
+ */
+void MainWindow::replayFinished(qint64 frames, qint64 elapsedMs)
+{
+    ui->replay_button->setText("Replay Capture");
+    ui->replay_fast->setEnabled(true);
+
+    if (frames < 0)
+    {
+        notifyUser("Replay failed", "Could not open the capture or " + ui->csim_port_selection->currentText(), true);
+        return;
+    }
+
+    QString rate = (elapsedMs > 0) ? QString::number(frames * 1000 / elapsedMs) + " messages/s" : "";
+    notifyUser("Replay finished", QString::number(frames) + " messages in " + QString::number(elapsedMs) + " ms " + rate, false);
+}
+
+/**
+ * @brief Records the latencies of clear error messages once their clears are applied
+ *
+ * @param timestamps Stage times of the clear error messages applied, emptied once recorded
+ */
+void MainWindow::recordClearLatencies(QVector<FrameTimestamps> &timestamps)
+{
+    for (FrameTimestamps &frameTimes : timestamps)
+    {
+        frameTimes.mark(STAGE_STORED);
+        latency.frameHandled(CLEAR_ERROR, frameTimes, renderTimer->isActive());
+    }
+
+    timestamps.clear();
+}
+
+/**
+ * @brief Shows the latest latency report on the diagnostics page
+ */
+void MainWindow::updateDiagnosticsPage()
+{
+    ui->latency_output->setPlainText(latency.report());
+}
+
 /**
  * @brief Scans for available serial ports and adds them to the CSIM selection box
  * @param index The index of the selected item in the selection box
@@ -1697,10 +2213,22 @@ void MainWindow::setup_csim_port_selection(int index)
 
     ui->csim_port_selection->clear();
 
-    // Fetch available serial ports and add their names to the combo box
+    // Fetch available serial ports
+    QStringList portNames;
     foreach (const QSerialPortInfo &info, QSerialPortInfo::availablePorts())
     {
-        QString portName = info.portName();
+        portNames.append(info.portName());
+    }
+
+    // loopback ports reach the ddm without a serial cable
+    portNames.append(LOOPBACK_PIPE_PORT);
+    #ifdef Q_OS_UNIX
+    portNames.append(TRANSPORT_PTY_PREFIX + CSIM_PTY_LINK);
+    #endif
+
+    // add their names to the combo box
+    for (const QString &portName : portNames)
+    {
         ui->csim_port_selection->addItem(portName);
 
         // Check if the current port name matches the one declared in settings
@@ -1723,17 +2251,11 @@ void MainWindow::update_non_cleared_error_selection()
     //check for valid events ptr
     if (csimHandle->eventsPtr != nullptr)
     {
-        //get head node
-        ErrorNode *wkgPtr = csimHandle->eventsPtr->headErrorNode;
-
-        //loop until list ends
-        while (wkgPtr != nullptr)
+        //loop through stored errors
+        for (EventRecord error : csimHandle->eventsPtr->store.rows(ERRORS))
         {
             //add the uncleared error to the combo box
-            ui->non_cleared_error_selection->addItem(QString::number(wkgPtr->id) + DELIMETER + wkgPtr->eventString);
-
-            //get next error
-            wkgPtr = wkgPtr->nextPtr;
+            ui->non_cleared_error_selection->addItem(QString::number(error.id()) + DELIMETER + error.eventString());
         }
     }
 }
@@ -1773,6 +2295,7 @@ void MainWindow::displaySavedSettings()
     qDebug() << "Auto Save Limit: " << userSettings.value("autoSaveLimit").toInt();
     qDebug() << "Notify on error cleared: " << userSettings.value("notifyOnErrorCleared").toBool();
     qDebug() << "Advanced log file: " << userSettings.value("advancedLogFile").toBool();
+    qDebug() << "Record sessions: " << userSettings.value("recordSessions").toBool();
     qDebug() << "Connection Timeout duration: " << userSettings.value("connectionTimeout").toInt();
     qDebug() << "RAM Clearing: " << userSettings.value("RAMClearing").toBool();
     qDebug() << "Max Data Nodes: " << userSettings.value("maxDataNodes").toInt() << Qt::endl;
@@ -5,17 +5,23 @@
 #include <QMainWindow>
 #include <QDesktopServices>
 #include <QShortcut>
-#include <QTextCursor>
 #include <QMessageBox>
 #include <QInputDialog>
+#include <QProgressDialog>
 #include <QObject>
 #include <QtCore>
-#include <QTextDocument>
 
 //Team Controller code
 #include "constants.h"
 #include "connection.h"
+#include "serialreader.h"
 #include "events.h"
+#include "logwriter.h"
+#include "logfileloader.h"
+#include "logviewmodel.h"
+#include "eventsmodel.h"
+#include "eventsearch.h"
+#include "notificationsmodel.h"
 #include "status.h"
 #include "electrical.h"
 #include "./ui_mainwindow.h"
@@ -23,6 +29,8 @@
 
 #if DEV_MODE
     #include "csim.h"
+    #include "sessionreplayer.h"
+    #include "latencytracker.h"
     #include <QtConcurrent/QtConcurrent>
 #endif
 
@@ -52,12 +60,35 @@ public:
     MainWindow(QWidget *parent = nullptr);
     ~MainWindow();
 
-    // class for ddms serial communication
+    // thread which owns the ddms serial port, reads and decodes incoming messages
+    SerialReader *serialReader;
+
+    // class for ddms serial communication, lives on the serial reader thread. Other than
+    // the connected flag, it must only be used through queued calls (QMetaObject::invokeMethod)
     Connection *ddmCon;
 
     // data class member variables
     Status *status;
     Events *events;
+
+    // keeps the auto save log file open for the session and writes to it on its own thread
+    LogWriter *logWriter;
+
+    // rows and row colors of the events page list
+    EventsModel *eventsModel;
+    EventsDelegate *eventsDelegate;
+
+    // index of every node of the session (including nodes cleared from RAM) for search
+    EventSearch *eventSearch;
+
+    // notifications shown on the notifications page
+    NotificationsModel *notificationsModel;
+
+    // loads log files chosen on the events page without blocking the gui
+    LogFileLoader *logFileLoader;
+
+    // shows a log file on the events page without loading it
+    LogViewModel *logViewModel;
     electrical *electricalData;
     QSettings userSettings;
 
@@ -69,17 +100,38 @@ public:
     QTimer* runningControllerTimer;
     QTimer* notificationTimer;
     QTimer *handshakeCooldownTimer;
+    QTimer *serialFrameTimer;
+    QTimer *renderTimer;
     QDateTime timeLastReceived;
     EventFilter eventFilter;
     QString autosaveLogFile;
+
+    // capture of the current session, empty while frames are not captured
+    QString sessionCaptureFile;
     bool allowSettingChanges;
 
+    // true from disableConnectionChanges until enableConnectionChanges, while a session
+    // is starting or running
+    bool connectionChangesLocked;
+
+    // RenderRegion flags of gui parts waiting for the next render
+    int dirtyRegions;
+
+    // an error was notified since the last render
+    bool urgentNotification;
+
+    #if DEV_MODE
+    // latest message received, shown on the dev page by the next render
+    QByteArray lastFrameMessage;
+    #endif
+
     // user managed settings
     bool coloredEventOutput;
     int autoSaveLimit;
     int connectionTimeout;
     bool advancedLogFile;
     bool notifyOnErrorCleared;
+    bool recordSessions;
 
     // creates a new connection using currently selected serial port settings
     void createDDMCon();
@@ -88,6 +140,14 @@ public:
         //csim simulator is contained within this class. It makes thread that can be managed through the handle
         CSim *csimHandle;
         QString csimPortName;
+
+        //replays session captures to the ddm through the csim port
+        SessionReplayer *replayer;
+
+        //latency of every frame from the serial port to the screen, shown on the diagnostics page
+        LatencyTracker latency;
+        QTimer *diagnosticsTimer;
+
         //logs empty line to qDebug() output
         void logEmptyLine();
     #endif
@@ -113,21 +173,37 @@ private slots:
     void notifyUser(QString notificationText, bool error);
     void notifyUser(QString notificationText, QString logText, bool error);
     void updateElapsedTime();
-    void readSerialData();
+    void processSerialFrames();
     void updateStatusDisplay();
+
+    //marks gui parts (RenderRegion flags) to be redrawn by the next render, at most
+    //once per RENDER_INTERVAL no matter how many messages change them
+    void scheduleRender(int regions);
+
+    //redraws every gui part marked since the last render
+    void renderDirtyRegions();
+
+    //shows the latest notification on the navbar and the notification counters
+    void updateNotificationDisplay();
     void handshake();
     void resetPageButton();
     void disableConnectionChanges();
     void enableConnectionChanges();
-    void updateEventsOutput(EventNode *event);
+    void updateEventsOutput(EventRecord event);
 
-    //clears current content of the events page text output and replaces
+    //sets the event and error counters on the gui from the events class
+    void updateEventCounters();
+
+    //clears current content of the events page list and replaces
     //it with freshly generated data based on current contents of events class
     void refreshEventsOutput();
 
     //clears error in events output
     void clearErrorFromEventsOutput(int errorId);
 
+    //clears a burst of errors from the events class, log file and events output
+    void applyErrorClears(QVector<int> &errorIds);
+
     //checks if the current number of auto saved files is higher than the limit, deletes the
     //oldest one each iteration until the limit is enforced
     void enforceAutoSaveLimit();
@@ -135,9 +211,22 @@ private slots:
     QString getSessionStatistics();
     void logAdvancedDetails(SerialMessageIdentifier id);
     void handleRAMClear();
+    void logFileLoaded(int result);
+    void logViewIndexed(int result);
+
+    //session captures, a capture is started with each handshake when recordSessions is set
+    void startSessionCapture();
+    void stopSessionCapture();
 
     #if DEV_MODE
         void displaySavedSettings();
+        void replayFinished(qint64 frames, qint64 elapsedMs);
+
+        //records the latency of clear error frames once their burst of clears is applied
+        void recordClearLatencies(QVector<FrameTimestamps> &timestamps);
+
+        //shows the latency report on the diagnostics page
+        void updateDiagnosticsPage();
     #endif
     //==================================================================================
 
@@ -154,8 +243,31 @@ private slots:
     void setupSettings();
     void setupConnectionPage();
     void renderElectricalPage();
-    void addElecBox(QWidget *horizontalWidget, QLayout *horizontalLayout, electricalNode *component);
     void freeElectricalPage();
+
+    // the events page shows a log file rather than the events of the session
+    bool isLogViewShown() const;
+    void closeLogView();
+
+    // widgets showing one electrical component
+    struct ElectricalBox
+    {
+        QWidget *box;
+        QTextEdit *content;
+        QString contentText; // text last set on content
+    };
+
+    // creates the box for a component, it is placed in a row by layoutElectricalBoxes
+    ElectricalBox addElecBox(electricalNode *component);
+
+    // places the boxes side by side in rows, in the order of keys
+    void layoutElectricalBoxes(const QStringList &keys);
+
+    // electrical page boxes kept between dumps, by component name (repeated names have
+    // their occurrence appended), and the rows they are laid out in
+    QHash<QString, ElectricalBox> electricalBoxes;
+    QStringList electricalBoxOrder;
+    QVector<QWidget *> electricalRows;
     //========================================================================================================
 
 
@@ -180,10 +292,12 @@ private slots:
     void on_openLogfileFolder_clicked();
     void on_setLogfileFolder_clicked();
     void on_load_events_from_logfile_clicked();
+    void on_view_log_file_clicked();
     void on_refresh_serial_port_selections_clicked();
 
     //settings
     void on_advanced_log_file_stateChanged(int arg1);
+    void on_record_sessions_stateChanged(int arg1);
     void on_colored_events_output_stateChanged(int arg1);
     void on_auto_save_limit_valueChanged(int arg1);
     void on_notify_error_cleared_stateChanged(int arg1);
@@ -201,6 +315,11 @@ private slots:
         void on_toggle_num_triggers_clicked();
         void on_csim_generation_interval_selection_valueChanged(int arg1);
         void on_pause_csim_button_clicked();
+        void on_csim_load_button_clicked();
+        void on_replay_button_clicked();
+        void on_DiagnosticsPageButton_clicked();
+        void on_latency_reset_button_clicked();
+        void on_latency_dump_button_clicked();
     #endif
     //=========================================================================================================
 
@@ -105,36 +105,41 @@ void MainWindow::on_baud_rate_selection_currentIndexChanged(int index)
         return;
     }
 
+    QSerialPort::BaudRate baudRate;
+
     switch (index)
     {
     case 0:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud1200);
+        baudRate = QSerialPort::Baud1200;
         break;
     case 1:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud2400);
+        baudRate = QSerialPort::Baud2400;
         break;
     case 2:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud4800);
+        baudRate = QSerialPort::Baud4800;
         break;
     case 3:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud9600);
+        baudRate = QSerialPort::Baud9600;
         break;
     case 4:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud19200);
+        baudRate = QSerialPort::Baud19200;
         break;
     case 5:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud38400);
+        baudRate = QSerialPort::Baud38400;
         break;
     case 6:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud57600);
+        baudRate = QSerialPort::Baud57600;
         break;
     case 7:
-        ddmCon->serialPort.setBaudRate(QSerialPort::Baud115200);
+        baudRate = QSerialPort::Baud115200;
         break;
     default:
-        // Handle default case
-        break;
+        // unsupported selection, leave the port unchanged
+        return;
     }
+
+    //the port belongs to the serial reader thread, apply the setting there
+    QMetaObject::invokeMethod(ddmCon, [con = ddmCon, baudRate]() { con->serialPort.setBaudRate(baudRate); });
 }
 
 /**
@@ -152,24 +157,29 @@ void MainWindow::on_data_bits_selection_currentIndexChanged(int index)
         return;
     }
 
+    QSerialPort::DataBits dataBits;
+
     switch (index)
     {
     case 0:
-        ddmCon->serialPort.setDataBits(QSerialPort::Data5);
+        dataBits = QSerialPort::Data5;
         break;
     case 1:
-        ddmCon->serialPort.setDataBits(QSerialPort::Data6);
+        dataBits = QSerialPort::Data6;
         break;
     case 2:
-        ddmCon->serialPort.setDataBits(QSerialPort::Data7);
+        dataBits = QSerialPort::Data7;
         break;
     case 3:
-        ddmCon->serialPort.setDataBits(QSerialPort::Data8);
+        dataBits = QSerialPort::Data8;
         break;
     default:
-        // Handle default case
-        break;
+        // unsupported selection, leave the port unchanged
+        return;
     }
+
+    //the port belongs to the serial reader thread, apply the setting there
+    QMetaObject::invokeMethod(ddmCon, [con = ddmCon, dataBits]() { con->serialPort.setDataBits(dataBits); });
 }
 
 /**
@@ -187,21 +197,26 @@ void MainWindow::on_flow_control_selection_currentIndexChanged(int index)
         return;
     }
 
+    QSerialPort::FlowControl flowControl;
+
     switch (index)
     {
     case 0:
-        ddmCon->serialPort.setFlowControl(QSerialPort::NoFlowControl);
+        flowControl = QSerialPort::NoFlowControl;
         break;
     case 1:
-        ddmCon->serialPort.setFlowControl(QSerialPort::HardwareControl);
+        flowControl = QSerialPort::HardwareControl;
         break;
     case 2:
-        ddmCon->serialPort.setFlowControl(QSerialPort::SoftwareControl);
+        flowControl = QSerialPort::SoftwareControl;
         break;
     default:
-        // Handle default case
-        break;
+        // unsupported selection, leave the port unchanged
+        return;
     }
+
+    //the port belongs to the serial reader thread, apply the setting there
+    QMetaObject::invokeMethod(ddmCon, [con = ddmCon, flowControl]() { con->serialPort.setFlowControl(flowControl); });
 }
 
 /**
@@ -219,21 +234,26 @@ void MainWindow::on_stop_bit_selection_currentIndexChanged(int index)
         return;
     }
 
+    QSerialPort::StopBits stopBits;
+
     switch (index)
     {
     case 0:
-        ddmCon->serialPort.setStopBits(QSerialPort::OneStop);
+        stopBits = QSerialPort::OneStop;
         break;
     case 1:
-        ddmCon->serialPort.setStopBits(QSerialPort::OneAndHalfStop);
+        stopBits = QSerialPort::OneAndHalfStop;
         break;
     case 2:
-        ddmCon->serialPort.setStopBits(QSerialPort::TwoStop);
+        stopBits = QSerialPort::TwoStop;
         break;
     default:
-        // Handle default case
-        break;
+        // unsupported selection, leave the port unchanged
+        return;
     }
+
+    //the port belongs to the serial reader thread, apply the setting there
+    QMetaObject::invokeMethod(ddmCon, [con = ddmCon, stopBits]() { con->serialPort.setStopBits(stopBits); });
 }
 
 /**
@@ -251,27 +271,32 @@ void MainWindow::on_parity_selection_currentIndexChanged(int index)
         return;
     }
 
+    QSerialPort::Parity parity;
+
     switch (index)
     {
     case 0:
-        ddmCon->serialPort.setParity(QSerialPort::NoParity);
+        parity = QSerialPort::NoParity;
         break;
     case 1:
-        ddmCon->serialPort.setParity(QSerialPort::EvenParity);
+        parity = QSerialPort::EvenParity;
         break;
     case 2:
-        ddmCon->serialPort.setParity(QSerialPort::OddParity);
+        parity = QSerialPort::OddParity;
         break;
     case 3:
-        ddmCon->serialPort.setParity(QSerialPort::SpaceParity);
+        parity = QSerialPort::SpaceParity;
         break;
     case 4:
-        ddmCon->serialPort.setParity(QSerialPort::MarkParity);
+        parity = QSerialPort::MarkParity;
         break;
     default:
-        // do nothing
-        break;
+        // unsupported selection, leave the port unchanged
+        return;
     }
+
+    //the port belongs to the serial reader thread, apply the setting there
+    QMetaObject::invokeMethod(ddmCon, [con = ddmCon, parity]() { con->serialPort.setParity(parity); });
 }
 
 //======================================================================================
@@ -82,6 +82,10 @@ void MainWindow::resetPageButton()
 
 #if DEV_MODE
     ui->DevPageButton->setStyleSheet(NAV_BUTTON_STYLE);
+    ui->DiagnosticsPageButton->setStyleSheet(NAV_BUTTON_STYLE);
+
+    //the latency report is only refreshed while it is shown
+    diagnosticsTimer->stop();
 #endif
 }
 
@@ -175,8 +179,14 @@ void MainWindow::on_FilterBox_currentIndexChanged(int index)
         qDebug() << "Error: on_FilterBox_currentIndexChanged unrecognized filter index."<< Qt::endl ;
     }
 
-    //refresh to display with filter
-    refreshEventsOutput();
+    //show the rows kept for the filter
+    eventsModel->setFilter(eventFilter);
+
+    //a viewed log file is filtered as well
+    if (logViewModel->isOpen())
+    {
+        logViewModel->setFilter(eventFilter);
+    }
 }
 
 /**
@@ -201,8 +211,8 @@ void MainWindow::on_handshake_button_clicked()
         }
     }
 
-    //catch possible errors
-    if (!ddmCon->serialPort.isOpen())
+    //catch possible errors (the reader thread stops if its port can't be opened)
+    if (!serialReader->isRunning())
     {
         notifyUser("Failed to open port" + ui->ddm_port_selection->currentText(), true);
         return;
@@ -218,6 +228,17 @@ void MainWindow::on_handshake_button_clicked()
         // Start the timer to periodically check the handshake status
         handshakeTimer->start();
 
+        //latencies are reported per session
+        #if DEV_MODE
+        latency.reset();
+        #endif
+
+        //capture the session from the controller's first reply
+        if (recordSessions)
+        {
+            startSessionCapture();
+        }
+
         //refreshes connection button/displays
         ui->handshake_button->setText("Connecting");
         ui->handshake_button->setStyleSheet(CONNECTING_STYLE);
@@ -229,8 +250,8 @@ void MainWindow::on_handshake_button_clicked()
     }
     else
     {
-        //disconnect from controller
-        ddmCon->sendDisconnectMsg();
+        //disconnect from controller (queued to the serial reader thread)
+        QMetaObject::invokeMethod(ddmCon, &Connection::sendDisconnectMsg);
 
         //update connection status to disconnected and update related objects
         //we use timer to allow grace period for final messages (disregard clazy warning)
@@ -378,8 +399,8 @@ void MainWindow::on_setLogfileFolder_clicked()
 }
 
 /**
- * @brief opens file explorer to log file directory. User selects file then then
- * data is loaded into events class and rendered in events page.
+ * @brief opens file explorer to log file directory. User selects file then the
+ * file is loaded in the background, the events page is updated once it is loaded.
  */
 void MainWindow::on_load_events_from_logfile_clicked()
 {
@@ -403,29 +424,76 @@ void MainWindow::on_load_events_from_logfile_clicked()
         qDebug() << "Loading data from: " << selectedFile;
     #endif
 
-    // Pass the selected file name to the loadDataFromLogFile function
-    int result = events->loadDataFromLogFile(events, selectedFile);
+    // Start loading the selected file, logFileLoaded is called once it is loaded
+    if (logFileLoader->start(selectedFile) == DATA_NOT_FOUND)
+    {
+        qDebug() << "Error: on_load_events_from_logfile_clicked() Log file could not be found" << Qt::endl;
+        notifyUser("Load failed on missing logfile.", true);
+        return;
+    }
+
+    //only one log file is loaded at a time
+    ui->load_events_from_logfile->setEnabled(false);
 
-    // Handle the result if needed
-    if (result == INCORRECT_FORMAT)
+    //show progress of long loads, the user can cancel the load from the dialog
+    QProgressDialog *progress = new QProgressDialog(tr("Loading log file..."), tr("Cancel"), 0, 100, this);
+    progress->setWindowTitle(tr("Load Log File"));
+    connect(logFileLoader, &LogFileLoader::progressChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, logFileLoader, &LogFileLoader::cancel);
+    connect(logFileLoader, &LogFileLoader::finished, progress, &QObject::deleteLater);
+}
+
+/**
+ * @brief opens file explorer to log file directory. User selects file then it is shown
+ * on the events page straight from the file, so logs too large to load can be reviewed.
+ * Pressed again, the events page shows the session's events again.
+ */
+void MainWindow::on_view_log_file_clicked()
+{
+    //close the log view if one is shown
+    if (isLogViewShown())
     {
-        qDebug() << "Error: on_load_events_from_logfile_clicked() Log file was of incorrect format." << Qt::endl;
-        notifyUser("Load failed on corrupt logfile.", selectedFile, true);
+        closeLogView();
+        return;
     }
-    else if (result == DATA_NOT_FOUND)
+
+    //a log file is being indexed
+    if (logViewModel->isIndexing())
     {
-        qDebug() << "Error: on_load_events_from_logfile_clicked() Log file could not be found" << Qt::endl;
-        notifyUser("Load failed on missing logfile.", true);
+        return;
     }
-    else
+
+    //declare file browser class
+    QFileDialog dialog(this);
+
+    //get user logfile setting as starting dir
+    dialog.setDirectory(userSettings.value("logfileLocation").toString());
+
+    // Open a file dialog for the user to select a logfile
+    QString selectedFile = dialog.getOpenFileName(this, tr("Select Log File"), QString(), tr("Log Files (*.txt);;All Files (*)"));
+
+    // Check if the user canceled the dialog
+    if (selectedFile.isEmpty())
+    {
+        return;
+    }
+
+    // Start indexing the selected file, logViewIndexed is called once it can be shown
+    if (logViewModel->open(selectedFile) == DATA_NOT_FOUND)
     {
-        notifyUser("Logfile loaded.", selectedFile, false);
-        ui->truncated_label->setVisible(false);
-        connect(events, &Events::RAMCleared, this, &MainWindow::handleRAMClear);
+        qDebug() << "Error: on_view_log_file_clicked() Log file could not be mapped" << Qt::endl;
+        notifyUser("View failed on missing logfile.", selectedFile, true);
+        return;
     }
 
-    //refresh the events output
-    refreshEventsOutput();
+    ui->view_log_file->setText("Indexing...");
+
+    //show progress of long scans, the user can cancel from the dialog
+    QProgressDialog *progress = new QProgressDialog(tr("Indexing log file..."), tr("Cancel"), 0, 100, this);
+    progress->setWindowTitle(tr("View Log File"));
+    connect(logViewModel, &LogViewModel::progressChanged, progress, &QProgressDialog::setValue);
+    connect(progress, &QProgressDialog::canceled, logViewModel, &LogViewModel::cancel);
+    connect(logViewModel, &LogViewModel::indexed, progress, &QObject::deleteLater);
 }
 
 /**
@@ -443,7 +511,12 @@ void MainWindow::on_refresh_serial_port_selections_clicked()
     #endif
 }
 /**
- * @brief Opens search dialog for searching keywords in events output
+ * @brief Opens search dialog for searching the events and errors of the session
+ *
+ * Searches the session's search index, which holds the same nodes as the events
+ * store. The button is disabled while a log file is viewed. Each "Find Next" moves to
+ * the next hit, best match first. Hits shown by the events list are selected, other
+ * hits are shown in the dialog.
  */
 void MainWindow::on_searchButton_clicked()
 {
@@ -451,7 +524,7 @@ void MainWindow::on_searchButton_clicked()
     QString searchText;
     QInputDialog inputDialog = QInputDialog(this);
     inputDialog.setInputMode(QInputDialog::TextInput);
-    inputDialog.setLabelText("Search for some text:");
+    inputDialog.setLabelText(SEARCH_LABEL);
     inputDialog.setOkButtonText("Find Next");
     inputDialog.setWindowTitle("Search");
     inputDialog.setStyleSheet("color:white;");
@@ -462,6 +535,11 @@ void MainWindow::on_searchButton_clicked()
     QLineEdit *lineEdit = inputDialog.findChild<QLineEdit *>();
     if (lineEdit) lineEdit->setPlaceholderText("Enter text to find...");
 
+    // hits of the last search, the next one is shown by the next "Find Next"
+    QString lastSearch;
+    SearchResults results;
+    qsizetype nextHit = 0;
+
     bool windowOpen = true;
 
     // start loop for continuous search until the user presses cancel or closes the window
@@ -472,41 +550,63 @@ void MainWindow::on_searchButton_clicked()
 
         // get text from user input
         searchText = inputDialog.textValue();
-        int index = 0;
 
         // check if the window is still open and the search text is not empty
         if (windowOpen && !searchText.isEmpty())
         {
-            // get all the text content from events_output
-            QString eventsText = ui->events_output->toPlainText();
+            // search again when the text changes
+            if (searchText != lastSearch)
+            {
+                results = eventSearch->search(EventSearch::parseQuery(searchText), MAX_SEARCH_HITS);
+                lastSearch = searchText;
+                nextHit = 0;
 
-            // set up cursor object
-            QTextCursor cursor = ui->events_output->textCursor();
+                #if DEV_MODE && GUI_DEBUG
+                qDebug() << "Search for" << searchText << "found" << results.totalHits << "hits";
+                #endif
+            }
 
-            // check if we have done a search in this loop
-            if (cursor.hasSelection())
+            // check if we have actually found the text
+            if (nextHit < results.hits.size())
             {
-                // set index to current position
-                index = cursor.position() + 1;
-            }
+                const SearchHit &hit = results.hits[nextHit++];
+                QString status = "Result " + QString::number(nextHit) + " of " + QString::number(results.totalHits);
 
-            // find the next occurrence of the text in the events_output, ignoring caps
-            int position = eventsText.indexOf(searchText, index, Qt::CaseInsensitive);
+                // if the hit is in the events list, select its row and scroll to it
+                int row = eventsModel->shownRow(hit.storeRow);
+                if (row != -1)
+                {
+                    QModelIndex found = eventsModel->index(row);
+                    ui->events_output->setCurrentIndex(found);
+                    ui->events_output->scrollTo(found);
+                }
+                // otherwise it is hidden by the filter, show it here
+                else
+                {
+                    ui->events_output->setCurrentIndex(QModelIndex());
+                    ui->events_output->clearSelection();
+
+                    status += " (not in the events list):\nID: " + QString::number(hit.id) + DELIMETER + " "
+                              + events->store.timeStamp(hit.storeRow) + DELIMETER + " " + hit.eventString;
+                    if (hit.isError)
+                    {
+                        status += DELIMETER + " " + (hit.cleared ? CLEARED_INDICATOR : ACTIVE_INDICATOR);
+                    }
+                }
 
-            // check if we have actually found the text
-            if (position != -1) {
-                // if the text is found, move the cursor to the found position and highlight it
-                cursor.setPosition(position);
-                cursor.movePosition(QTextCursor::NextCharacter, QTextCursor::KeepAnchor, searchText.length());
-                ui->events_output->setTextCursor(cursor);
+                inputDialog.setLabelText(SEARCH_LABEL + "\n" + status);
+                inputDialog.setFixedSize(inputDialog.minimumSizeHint());
             }
             // otherwise, assume we have not found the text
             else
             {
-                // reset cursor selection
-                cursor.clearSelection();
-                cursor.setPosition(0);
-                ui->events_output->setTextCursor(cursor);
+                // reset selection, the next search starts from the best hit again
+                ui->events_output->setCurrentIndex(QModelIndex());
+                ui->events_output->clearSelection();
+                nextHit = 0;
+
+                inputDialog.setLabelText(SEARCH_LABEL);
+                inputDialog.setFixedSize(minSize);
 
                 // show error message
                 QMessageBox informationBox = QMessageBox(this);
@@ -520,10 +620,8 @@ void MainWindow::on_searchButton_clicked()
         else
         {
             // break the loop if the window is closed or the search text is empty
-            QTextCursor cursor = ui->events_output->textCursor();
-            cursor.clearSelection();
-            cursor.setPosition(0);
-            ui->events_output->setTextCursor(cursor);
+            ui->events_output->setCurrentIndex(QModelIndex());
+            ui->events_output->clearSelection();
             break;
         }
     }
@@ -555,7 +653,10 @@ void MainWindow::on_colored_events_output_stateChanged(int arg1)
     userSettings.setValue("coloredEventOutput", coloredEventOutput);
 
     if (!allowSettingChanges) return;
-    refreshEventsOutput();
+
+    //rows are colored when drawn, so only redraw them
+    eventsDelegate->setColored(coloredEventOutput);
+    ui->events_output->viewport()->update();
 
     //write changes to the registry
     userSettings.sync();
@@ -612,6 +713,21 @@ void MainWindow::on_notify_error_cleared_stateChanged(int arg1)
     userSettings.sync();
 }
 
+/**
+ * @brief Toggles capturing the messages received each session for replay
+ * @param arg1 The users on-off selection
+ */
+void MainWindow::on_record_sessions_stateChanged(int arg1)
+{
+    //arg1 represents the state of the checkbox, a session in progress keeps its capture state
+    recordSessions = (arg1 != 0);
+
+    userSettings.setValue("recordSessions", recordSessions);
+
+    //write changes to the registry
+    userSettings.sync();
+}
+
 /**
  * @brief Toggles advanced log file outputs (electrical details, status updates, session statistics)
  * @param arg1 The users on-off selection
@@ -643,27 +759,14 @@ void MainWindow::on_advanced_log_file_stateChanged(int arg1)
     //if connected, add updated advanced log file setting notification to logfile
     if (ddmCon->connected)
     {
-        QFile file(autosaveLogFile);
+        QString outString = ADVANCED_LOG_FILE_INDICATOR
+                            + (advancedLogFile ? "ADVANCED LOG FILE ENABLED" : "ADVANCED LOG FILE DISABLED");
 
-        //attempt to open in append mode
-        if (!file.open(QIODevice::Append | QIODevice::Text))
+        //append the setting change to the log file
+        if (logWriter->writeLine(outString.toUtf8()) < 0)
         {
             qDebug() << "Error: on_advanced_log_file_stateChanged could not open log file for appending: " << autosaveLogFile << Qt::endl;
         }
-        else
-        {
-            QTextStream out(&file);
-
-            if (advancedLogFile)
-            {
-                out << ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE ENABLED" << "\n";
-            }
-            else
-            {
-                out << ADVANCED_LOG_FILE_INDICATOR + "ADVANCED LOG FILE DISABLED" << "\n";
-            }
-            file.close();
-        }
     }
 
     //write changes to the registry
@@ -729,6 +832,17 @@ void MainWindow::on_DevPageButton_clicked()
     ui->DevPageButton->setStyleSheet(SELECTED_NAV_BUTTON_STYLE);
 }
 
+//sends user to diagnostics page when clicked
+void MainWindow::on_DiagnosticsPageButton_clicked()
+{
+    ui->Flow_Label->setCurrentIndex(7);
+    resetPageButton();
+    ui->DiagnosticsPageButton->setStyleSheet(SELECTED_NAV_BUTTON_STYLE);
+
+    updateDiagnosticsPage();
+    diagnosticsTimer->start();
+}
+
 //manually clear errors from dev page
 void MainWindow::on_clear_error_button_clicked()
 {
@@ -768,6 +882,11 @@ void MainWindow::on_CSim_button_clicked()
 
         ui->non_cleared_error_selection->clear();
     }
+    //the replayer is standing in for the controller
+    else if (replayer->isRunning())
+    {
+        notifyUser("Stop the replay before starting CSim", true);
+    }
     //csim is not running, start it
     else
     {
@@ -879,7 +998,7 @@ void MainWindow::on_send_message_button_clicked()
         // Send message through csim port
         conn->transmit(userInput);
 
-        conn->serialPort.waitForReadyRead(1000);
+        conn->device->waitForReadyRead(1000);
     }
 }
 
@@ -902,4 +1021,81 @@ void MainWindow::on_pause_csim_button_clicked()
         ui->pause_csim_button->setText("unpause");
     }
 }
+
+//replays a session capture through the csim port, second click stops the replay
+void MainWindow::on_replay_button_clicked()
+{
+    if (replayer->isRunning())
+    {
+        replayer->stopReplay();
+        return;
+    }
+
+    //csim and the replayer both stand in for the controller
+    if (csimHandle->isRunning())
+    {
+        notifyUser("Stop CSim before replaying a capture", true);
+        return;
+    }
+
+    QString captureFile = QFileDialog::getOpenFileName(this, "Select session capture",
+                                                       userSettings.value("logfileLocation").toString(),
+                                                       "Session captures (*" + SESSION_CAPTURE_SUFFIX + ")");
+    if (captureFile.isEmpty())
+    {
+        return;
+    }
+
+    replayer->startReplay(ui->csim_port_selection->currentText(), captureFile, ui->replay_fast->isChecked());
+
+    ui->replay_button->setText("Stop Replay");
+    ui->replay_fast->setEnabled(false);
+    notifyUser("Replay waiting for handshake", captureFile, false);
+}
+
+//toggles csim load mode, the profile is read when load mode starts
+void MainWindow::on_csim_load_button_clicked()
+{
+    if (csimHandle->loadMode.load(std::memory_order_acquire))
+    {
+        csimHandle->loadMode.store(false, std::memory_order_release);
+        ui->csim_load_button->setText("Start Load Mode");
+        ui->csim_load_profile->setEnabled(true);
+        return;
+    }
+
+    CSimLoadProfile profile;
+    if (!CSimLoadProfile::parse(ui->csim_load_profile->text(), profile))
+    {
+        notifyUser("Invalid load profile: " + ui->csim_load_profile->text(), true);
+        return;
+    }
+
+    csimHandle->startLoadMode(profile);
+
+    ui->csim_load_button->setText("Stop Load Mode");
+    ui->csim_load_profile->setEnabled(false);
+}
+
+//drops every recorded latency
+void MainWindow::on_latency_reset_button_clicked()
+{
+    latency.reset();
+    updateDiagnosticsPage();
+}
+
+//saves the latency report and histogram buckets next to the log files
+void MainWindow::on_latency_dump_button_clicked()
+{
+    QString reportFile = userSettings.value("logfileLocation").toString() + QString::number(QDateTime::currentSecsSinceEpoch()) + LATENCY_REPORT_SUFFIX;
+
+    if (latency.dumpToFile(reportFile))
+    {
+        notifyUser("Latency report saved", "Report location: " + reportFile, false);
+    }
+    else
+    {
+        notifyUser("Latency report failed", "Could not open " + reportFile + " for writing", true);
+    }
+}
 #endif
@@ -0,0 +1,535 @@
+#include "messagedecoder.h"
+
+/********************************************************************************
+** messagedecoder.cpp
+**
+** This file implements the decoding of serial messages into typed frames. The
+** validation performed here is the validation the load methods of Status, Events
+** and electrical have always performed, it has only been moved in front of them.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Initialization constructor for the field tokenizer
+ *
+ * @param text The text to be split, must outlive the tokenizer
+ * @param delimiter The delimiter separating each field
+ */
+FieldTokenizer::FieldTokenizer(QByteArrayView text, QByteArrayView delimiter)
+    : text(text), delimiter(delimiter), position(0), finished(false)
+{
+}
+
+/**
+ * @brief Retrieves the next field from the text
+ *
+ * @param field Set to a view of the next field
+ * @return False if every field has already been retrieved
+ */
+bool FieldTokenizer::next(QByteArrayView &field)
+{
+    if (finished)
+    {
+        return false;
+    }
+
+    qsizetype end = text.indexOf(delimiter, position);
+
+    //last field runs to the end of the text
+    if (end == -1)
+    {
+        field = text.sliced(position);
+        finished = true;
+    }
+    else
+    {
+        field = text.sliced(position, end - position);
+        position = end + delimiter.size();
+    }
+    return true;
+}
+
+/**
+ * @brief Splits text along the message delimeter into a fixed number of fields
+ *
+ * @param text The text to be split
+ * @param fields Array that receives up to maxFields fields
+ * @param maxFields Capacity of fields
+ * @return The number of fields, maxFields + 1 if the text contains more than maxFields
+ */
+int MessageDecoder::tokenize(QByteArrayView text, QByteArrayView *fields, int maxFields)
+{
+    FieldTokenizer tokenizer(text, ",");
+    QByteArrayView field;
+    int numFields = 0;
+
+    while (tokenizer.next(field))
+    {
+        //too many fields, no need to look any further
+        if (numFields == maxFields)
+        {
+            return maxFields + 1;
+        }
+        fields[numFields++] = field;
+    }
+    return numFields;
+}
+
+/**
+ * @brief Validates a HH:MM:SS:mmm time stamp and converts it to milliseconds
+ *
+ * Used for time stamps from serial messages, log files and searches alike.
+ *
+ * @param timeStamp The time stamp to convert
+ * @param msecs Set to the total number of milliseconds if the time stamp is valid
+ * @return True if the time stamp has 4 parts, all numeric and none of them negative
+ */
+bool MessageDecoder::parseTimeStamp(QByteArrayView timeStamp, qint64 &msecs)
+{
+    static const qint64 PART_MSECS[4] = {3600000LL, 60000LL, 1000LL, 1LL};
+
+    FieldTokenizer tokenizer(timeStamp, ":");
+    QByteArrayView part;
+    int numParts = 0;
+    qint64 total = 0;
+
+    while (tokenizer.next(part))
+    {
+        bool numeric = false;
+        int value = part.toInt(&numeric);
+        if (numParts == 4 || !numeric || value <= -1)
+        {
+            return false;
+        }
+        total += value * PART_MSECS[numParts++];
+    }
+
+    if (numParts != 4)
+    {
+        return false;
+    }
+
+    msecs = total;
+    return true;
+}
+
+/**
+ * @brief Formats milliseconds as a time stamp
+ *
+ * Produces a time stamp for milliseconds that were not read from one. Stored events
+ * keep the text the controller sent instead, see EventStore::timeStamp.
+ *
+ * @param msecs Milliseconds since the controller started
+ * @return Time stamp in the format HH:MM:SS:mmm, hours grow past 2 digits if needed
+ */
+QString MessageDecoder::formatTimeStamp(qint64 msecs)
+{
+    return QString("%1:%2:%3:%4")
+        .arg(msecs / 3600000, 2, 10, QChar('0'))
+        .arg((msecs / 60000) % 60, 2, 10, QChar('0'))
+        .arg((msecs / 1000) % 60, 2, 10, QChar('0'))
+        .arg(msecs % 1000, 3, 10, QChar('0'));
+}
+
+/**
+ * @brief Separates the message id from the rest of the serial message
+ *
+ * @param message The full serial message
+ * @param messageId Set to the message id
+ * @param payload Set to a view of everything after the message id and delimeter
+ * @return False if the message does not begin with an id followed by the delimeter
+ */
+bool MessageDecoder::splitMessageId(QByteArrayView message, SerialMessageIdentifier &messageId,
+                                    QByteArrayView &payload)
+{
+    //id has len=1 and delimeter has len=1 so 2 total
+    if (message.size() < 2 || message[0] < '0' || message[0] > '9' || message[1] != ',')
+    {
+        return false;
+    }
+
+    messageId = static_cast<SerialMessageIdentifier>(message[0] - '0');
+    payload = message.sliced(2);
+    return true;
+}
+
+/**
+ * @brief Decodes a status message
+ *
+ * @param payload The status message with the message id removed
+ * @param frame Receives the decoded status data
+ * @return False if the message is invalid, frame is left unspecified
+ */
+bool MessageDecoder::decodeStatus(QByteArrayView payload, StatusFrame &frame)
+{
+    QByteArrayView values[NUM_STATUS_ELEMENTS + 1];
+
+    // check if message contains too few or too many items
+    if (tokenize(payload, values, NUM_STATUS_ELEMENTS + 1) != NUM_STATUS_ELEMENTS + 1)
+    {
+        qDebug() << "Error: decodeStatus invalid number of delimeters: " << payload << Qt::endl;
+        return false;
+    }
+
+    bool firRateConversionResult = false;
+    int trig1 = values[1].toInt();
+    int trig2 = values[2].toInt();
+    int conState = values[3].toInt();
+    int firMode = values[4].toInt();
+    int feedPos = values[5].toInt();
+    int totFirEvents = values[6].toInt();
+    int burLen = values[7].toInt();
+    double firRate = values[8].toDouble(&firRateConversionResult);
+
+    //if the toInt() method fails the return will be 0. So if we find an int =0 and
+    //its string != 0, its a fail. Firing mode and feed position are checked against
+    //each value manually because their enumerations represent degrees.
+
+    //armed
+    if (values[0] != "0" && values[0] != "1")
+    {
+        qDebug() << "Error: decodeStatus invalid armed value: " << values[0] << Qt::endl;
+    }
+    //trigger 1
+    else if ((values[1] != "0" && trig1 == 0) || trig1 < 0 || trig1 >= NUM_TRIGGER_STATUS)
+    {
+        qDebug() << "Error: decodeStatus invalid trigger 1 value: " << values[1] << Qt::endl;
+    }
+    //trigger 2
+    else if ((values[2] != "0" && trig2 == 0) || trig2 < 0 || trig2 >= NUM_TRIGGER_STATUS)
+    {
+        qDebug() << "Error: decodeStatus invalid trigger 2 value: " << values[2] << Qt::endl;
+    }
+    //controller state
+    else if ((values[3] != "0" && conState == 0) || conState < 0
+             || conState >= NUM_CONTROLLER_STATE)
+    {
+        qDebug() << "Error: decodeStatus invalid controller state value: " << values[3] << Qt::endl;
+    }
+    //firing mode
+    else if ((values[4] != "0" && firMode == 0) || (firMode != SAFE &&
+              firMode != SINGLE && firMode != BURST && firMode != FULL_AUTO))
+    {
+        qDebug() << "Error: decodeStatus invalid firing mode value: " << values[4] << Qt::endl;
+    }
+    //feed pos
+    else if ((values[5] != "0" && feedPos == 0) || (feedPos != CHAMBERING
+              && feedPos != LOCKING
+              && feedPos != FIRING && feedPos != UNLOCKING
+              && feedPos != EXTRACTING && feedPos != EJECTING
+              && feedPos != COCKING && feedPos != FEEDING))
+    {
+        qDebug() << "Error: decodeStatus invalid feed position value: " << values[5] << Qt::endl;
+    }
+    //total firing events
+    else if ((values[6] != "0" && totFirEvents == 0) || totFirEvents < 0)
+    {
+        qDebug() << "Error: decodeStatus invalid total firing events value: " << values[6] << Qt::endl;
+    }
+    //burst length
+    else if ((values[7] != "0" && burLen == 0) || burLen < 0)
+    {
+        qDebug() << "Error: decodeStatus invalid burst length value: " << values[7] << Qt::endl;
+    }
+    //firing rate
+    else if (!firRateConversionResult || firRate < 0)
+    {
+        qDebug() << "Error: decodeStatus invalid firing rate value: " << values[8] << Qt::endl;
+    }
+    //all data has been verified at this point
+    else
+    {
+        frame.armed = (values[0] == "1");
+        frame.trigger1 = static_cast<TriggerStatus>(trig1);
+        frame.trigger2 = static_cast<TriggerStatus>(trig2);
+        frame.controllerState = static_cast<ControllerState>(conState);
+        frame.firingMode = static_cast<FiringMode>(firMode);
+        frame.feedPosition = static_cast<FeedPosition>(feedPos);
+        frame.totalFiringEvents = totFirEvents;
+        frame.burstLength = burLen;
+        frame.firingRate = firRate;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * @brief Decodes an event message
+ *
+ * @param payload The event message with the message id removed
+ * @param frame Receives the decoded event, text fields are views into payload
+ * @return False if the message is invalid
+ */
+bool MessageDecoder::decodeEvent(QByteArrayView payload, EventFrame &frame)
+{
+    QByteArrayView values[NUM_EVENT_ELEMENTS + 1];
+    int numValues = tokenize(payload, values, NUM_EVENT_ELEMENTS + 1);
+
+    // check for real event (allows new line at the end or no new line at the end)
+    if (numValues != NUM_EVENT_ELEMENTS && numValues != NUM_EVENT_ELEMENTS + 1)
+    {
+        qDebug() << "Error: Invalid input to decode event data: " << payload << Qt::endl;
+        return false;
+    }
+
+    frame.id = values[0].toInt();
+    if (frame.id <= -1)
+    {
+        qDebug() << "Error: decodeEvent invalid id: " << values[0] << Qt::endl;
+        return false;
+    }
+
+    frame.timeStamp = values[1];
+    if (!parseTimeStamp(frame.timeStamp, frame.timeMs))
+    {
+        qDebug() << "Error: decodeEvent invalid time stamp: " << frame.timeStamp << Qt::endl;
+        return false;
+    }
+
+    frame.eventString = values[2];
+    if (frame.eventString.isEmpty())
+    {
+        qDebug() << "Error: decodeEvent empty event string" << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes an error message
+ *
+ * @param payload The error message with the message id removed
+ * @param frame Receives the decoded error, text fields are views into payload
+ * @return False if the message is invalid
+ */
+bool MessageDecoder::decodeError(QByteArrayView payload, ErrorFrame &frame)
+{
+    QByteArrayView values[NUM_ERROR_ELEMENTS + 1];
+    int numValues = tokenize(payload, values, NUM_ERROR_ELEMENTS + 1);
+
+    // check for real error (allows new line at the end or no new line at the end)
+    if (numValues != NUM_ERROR_ELEMENTS && numValues != NUM_ERROR_ELEMENTS + 1)
+    {
+        qDebug() << "Error: Invalid input to decode error data: " << payload << Qt::endl;
+        return false;
+    }
+
+    frame.id = values[0].toInt();
+    if (frame.id <= -1)
+    {
+        qDebug() << "Error: decodeError invalid id: " << values[0] << Qt::endl;
+        return false;
+    }
+
+    frame.timeStamp = values[1];
+    if (!parseTimeStamp(frame.timeStamp, frame.timeMs))
+    {
+        qDebug() << "Error: decodeError invalid time stamp: " << frame.timeStamp << Qt::endl;
+        return false;
+    }
+
+    frame.eventString = values[2];
+    if (frame.eventString.isEmpty())
+    {
+        qDebug() << "Error: decodeError empty event string" << Qt::endl;
+        return false;
+    }
+
+    frame.cleared = (values[3] == "1");
+    return true;
+}
+
+/**
+ * @brief Decodes a clear error message
+ *
+ * @param payload The clear error message with the message id removed
+ * @param frame Receives the id of the cleared error
+ * @return False if the error id is not a number
+ */
+bool MessageDecoder::decodeClear(QByteArrayView payload, ClearFrame &frame)
+{
+    bool conversionResult = false;
+    qsizetype end = payload.indexOf(',');
+
+    //error id runs to the first delimeter, or the entire message if there is none
+    frame.errorId = (end == -1 ? payload : payload.first(end)).trimmed().toInt(&conversionResult);
+
+    if (!conversionResult || frame.errorId < 0)
+    {
+        qDebug() << "Error: decodeClear invalid error id: " << payload << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes a begin message
+ *
+ * @param payload The begin message with the message id removed
+ * @param frame Receives the controller time, version and crc
+ * @return False if the message is invalid
+ */
+bool MessageDecoder::decodeBegin(QByteArrayView payload, BeginFrame &frame)
+{
+    QByteArrayView values[NUM_BEGIN_ELEMENTS + 1];
+
+    //ensure message has correct format
+    if (tokenize(payload, values, NUM_BEGIN_ELEMENTS + 1) != NUM_BEGIN_ELEMENTS + 1)
+    {
+        return false;
+    }
+
+    // calculate total milliseconds
+    if (!parseTimeStamp(values[0], frame.elapsedMsecs))
+    {
+        qDebug() << "Error: decodeBegin: Invalid time string format: " << values[0] << Qt::endl;
+        return false;
+    }
+
+    frame.version = values[1];
+    frame.crc = values[2];
+    return true;
+}
+
+/**
+ * @brief Decodes one electrical component
+ *
+ * @param payload The component data (name, voltage, amps)
+ * @param frame Receives the decoded component, name is a view into payload
+ * @return False if the component is invalid
+ */
+bool MessageDecoder::decodeElectrical(QByteArrayView payload, ElectricalFrame &frame)
+{
+    QByteArrayView values[NUM_ELECTRIC_ELEMENTS + 1];
+
+    if (tokenize(payload, values, NUM_ELECTRIC_ELEMENTS + 1) != NUM_ELECTRIC_ELEMENTS + 1)
+    {
+        qDebug() << "Invalid input to decode electrical data: " << payload << Qt::endl;
+        return false;
+    }
+
+    frame.name = values[0];
+    if (frame.name.isEmpty())
+    {
+        qDebug() << "Error: decodeElectrical empty electrical component name" << Qt::endl;
+        return false;
+    }
+
+    frame.voltage = values[1].toDouble();
+    if (frame.voltage <= -1 || (values[1] != "0" && frame.voltage == 0.0))
+    {
+        qDebug() << "Error: decodeElectrical invalid voltage: " << values[1] << Qt::endl;
+        return false;
+    }
+
+    frame.amps = values[2].toDouble();
+    if (frame.amps <= -1 || (values[2] != "0" && frame.amps == 0.0))
+    {
+        qDebug() << "Error: decodeElectrical invalid amps: " << values[2] << Qt::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Decodes an event dump
+ *
+ * @param payload The event dump with the message id removed
+ * @param frames Every valid event in the dump is appended to frames
+ * @return False if the dump is empty or any event is invalid
+ */
+bool MessageDecoder::decodeEventDump(QByteArrayView payload, QVector<EventFrame> &frames)
+{
+    FieldTokenizer tokenizer(payload, ",,");
+    QByteArrayView entry;
+    EventFrame frame;
+    bool successfulDecode = true;
+    bool emptyDump = true;
+
+    while (tokenizer.next(entry))
+    {
+        // skip empty parts and the trailing new line
+        if (entry.isEmpty() || entry == "\n")
+        {
+            continue;
+        }
+        emptyDump = false;
+
+        if (decodeEvent(entry, frame))
+        {
+            frames.append(frame);
+        }
+        else
+        {
+            successfulDecode = false;
+        }
+    }
+    return successfulDecode && !emptyDump;
+}
+
+/**
+ * @brief Decodes an error dump
+ *
+ * @param payload The error dump with the message id removed
+ * @param frames Every valid error in the dump is appended to frames
+ * @return False if the dump is empty or any error is invalid
+ */
+bool MessageDecoder::decodeErrorDump(QByteArrayView payload, QVector<ErrorFrame> &frames)
+{
+    FieldTokenizer tokenizer(payload, ",,");
+    QByteArrayView entry;
+    ErrorFrame frame;
+    bool successfulDecode = true;
+    bool emptyDump = true;
+
+    while (tokenizer.next(entry))
+    {
+        // skip empty parts and the trailing new line
+        if (entry.isEmpty() || entry == "\n")
+        {
+            continue;
+        }
+        emptyDump = false;
+
+        if (decodeError(entry, frame))
+        {
+            frames.append(frame);
+        }
+        else
+        {
+            successfulDecode = false;
+        }
+    }
+    return successfulDecode && !emptyDump;
+}
+
+/**
+ * @brief Decodes an electrical message containing one or more components
+ *
+ * @param payload The electrical message with the message id removed
+ * @param frames Every component before the first invalid one is appended to frames
+ * @return False if any component is invalid
+ */
+bool MessageDecoder::decodeElectricalDump(QByteArrayView payload, QVector<ElectricalFrame> &frames)
+{
+    FieldTokenizer tokenizer(payload, ",,");
+    QByteArrayView entry;
+    ElectricalFrame frame;
+
+    while (tokenizer.next(entry))
+    {
+        // skip empty parts and the trailing new line
+        if (entry.isEmpty() || entry == "\n")
+        {
+            continue;
+        }
+
+        if (!decodeElectrical(entry, frame))
+        {
+            return false;
+        }
+        frames.append(frame);
+    }
+    return true;
+}
@@ -0,0 +1,145 @@
+#ifndef MESSAGEDECODER_H
+#define MESSAGEDECODER_H
+
+#include <QByteArrayView>
+#include <QString>
+#include <QDebug>
+#include <QVector>
+#include "constants.h"
+
+/********************************************************************************
+** messagedecoder.h
+**
+** The MessageDecoder class tokenizes serial messages in place and produces a typed
+** frame for each SerialMessageIdentifier. Text fields in the frames are views into
+** the original message, so no intermediate strings or string lists are created
+** while decoding. Frames are only valid while the message they were decoded from
+** is alive.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Data carried by a STATUS message
+ */
+struct StatusFrame
+{
+    bool armed;
+    TriggerStatus trigger1;
+    TriggerStatus trigger2;
+    ControllerState controllerState;
+    FiringMode firingMode;
+    FeedPosition feedPosition;
+    int totalFiringEvents;
+    int burstLength;
+    double firingRate;
+};
+
+/**
+ * @brief Data carried by an EVENT message or by one entry of an EVENT_DUMP
+ */
+struct EventFrame
+{
+    int id; // unique identifier of the event
+    QByteArrayView timeStamp; // controller time stamp (HH:MM:SS:mmm)
+    qint64 timeMs; // time stamp converted to milliseconds
+    QByteArrayView eventString; // the message from the controller
+};
+
+/**
+ * @brief Data carried by an ERROR message or by one entry of an ERROR_DUMP
+ *
+ * NOTE: This struct inherits all member variables from the EventFrame defined above
+ */
+struct ErrorFrame : public EventFrame
+{
+    bool cleared; // status of whether or not this error has been cleared yet
+};
+
+/**
+ * @brief Data carried by a CLEAR_ERROR message
+ */
+struct ClearFrame
+{
+    int errorId; // id of the error that was cleared
+};
+
+/**
+ * @brief Data carried by a BEGIN message
+ */
+struct BeginFrame
+{
+    qint64 elapsedMsecs; // controller run time when the session began
+    QByteArrayView version; // controller version
+    QByteArrayView crc; // controller crc
+};
+
+/**
+ * @brief Data carried by one component of an ELECTRICAL message
+ */
+struct ElectricalFrame
+{
+    QByteArrayView name;
+    double voltage;
+    double amps;
+};
+
+/**
+ * @brief Splits text on a delimiter without allocating
+ *
+ * Produces the same fields as QString::split with Qt::KeepEmptyParts, one at a time.
+ */
+class FieldTokenizer
+{
+public:
+    FieldTokenizer(QByteArrayView text, QByteArrayView delimiter);
+
+    // stores the next field in field, returns false when no fields are left
+    bool next(QByteArrayView &field);
+
+private:
+    QByteArrayView text;
+    QByteArrayView delimiter;
+    qsizetype position;
+    bool finished;
+};
+
+class MessageDecoder
+{
+public:
+    // separates the message id from the rest of the message, fails if the message
+    // does not begin with a single digit id followed by the delimeter
+    static bool splitMessageId(QByteArrayView message, SerialMessageIdentifier &messageId,
+                               QByteArrayView &payload);
+
+    // decoders for each message payload (message id already removed)
+    static bool decodeStatus(QByteArrayView payload, StatusFrame &frame);
+    static bool decodeEvent(QByteArrayView payload, EventFrame &frame);
+    static bool decodeError(QByteArrayView payload, ErrorFrame &frame);
+    static bool decodeClear(QByteArrayView payload, ClearFrame &frame);
+    static bool decodeBegin(QByteArrayView payload, BeginFrame &frame);
+    static bool decodeElectrical(QByteArrayView payload, ElectricalFrame &frame);
+
+    // dump decoders append every valid entry to frames and return false if the dump
+    // was empty or any entry failed to decode
+    static bool decodeEventDump(QByteArrayView payload, QVector<EventFrame> &frames);
+    static bool decodeErrorDump(QByteArrayView payload, QVector<ErrorFrame> &frames);
+
+    // electrical dumps stop at the first invalid component
+    static bool decodeElectricalDump(QByteArrayView payload, QVector<ElectricalFrame> &frames);
+
+    // converts a HH:MM:SS:mmm time stamp to milliseconds, fails unless it has 4 non
+    // negative numeric parts
+    static bool parseTimeStamp(QByteArrayView timeStamp, qint64 &msecs);
+
+    // converts milliseconds to a HH:MM:SS:mmm time stamp. stored events keep the time
+    // stamp text they were read from instead
+    static QString formatTimeStamp(qint64 msecs);
+
+private:
+    // splits text into at most maxFields fields, returns the number of fields found
+    // (maxFields + 1 indicates there were more fields than requested)
+    static int tokenize(QByteArrayView text, QByteArrayView *fields, int maxFields);
+};
+
+#endif // MESSAGEDECODER_H
@@ -0,0 +1,133 @@
+#include "notificationsmodel.h"
+
+/********************************************************************************
+** notificationsmodel.cpp
+**
+** This file implements the ring buffer of notifications shown on the notifications
+** page.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Constructor, there are no notifications
+ */
+NotificationsModel::NotificationsModel(QObject *parent)
+    : QAbstractListModel(parent), first(0), count(0), errorCount(0), infoCount(0), lastError(false)
+{
+}
+
+int NotificationsModel::rowCount(const QModelIndex &parent) const
+{
+    //list models only have top level rows
+    return parent.isValid() ? 0 : count;
+}
+
+/**
+ * @brief Provides the text and color of a notification
+ *
+ * Rows are formatted when the view asks for them, only rows on screen are formatted.
+ */
+QVariant NotificationsModel::data(const QModelIndex &index, int role) const
+{
+    if (!index.isValid() || index.row() >= count)
+    {
+        return QVariant();
+    }
+
+    const Notification &notification = entry(index.row());
+
+    switch (role)
+    {
+    case Qt::DisplayRole:
+    {
+        QString text = notification.timeStamp + " " + notification.text;
+
+        if (!notification.logText.isEmpty())
+        {
+            text += " : " + notification.logText;
+        }
+
+        if (notification.repeats > 1)
+        {
+            text += " (x" + QString::number(notification.repeats) + ")";
+        }
+
+        return text;
+    }
+
+    case Qt::ForegroundRole:
+        return QColor(notification.error ? ERROR_COLOR : STANDARD_COLOR);
+
+    default:
+        return QVariant();
+    }
+}
+
+/**
+ * @brief Adds a notification to the ring buffer
+ *
+ * @param timeStamp Time the notification was raised
+ * @param text Notification message
+ * @param logText Details of the notification, may be empty
+ * @param error True if the notification reports an error
+ * @return False if the notification repeated a recent notification
+ */
+bool NotificationsModel::add(const QString &timeStamp, const QString &text, const QString &logText, bool error)
+{
+    if (error)
+    {
+        errorCount++;
+    }
+    else
+    {
+        infoCount++;
+    }
+
+    lastText = text;
+    lastError = error;
+
+    //a repeat of a recent notification only updates it (details may differ between repeats)
+    for (int row = count - 1; row >= qMax(0, count - NOTIFICATION_DEDUPE_WINDOW); row--)
+    {
+        Notification &notification = entry(row);
+
+        if (notification.error == error && notification.text == text)
+        {
+            notification.repeats++;
+            notification.timeStamp = timeStamp;
+            notification.logText = logText;
+
+            emit dataChanged(index(row), index(row));
+            return false;
+        }
+    }
+
+    //drop the oldest notification when the buffer is full
+    if (count == NOTIFICATION_CAPACITY)
+    {
+        beginRemoveRows(QModelIndex(), 0, 0);
+        first = (first + 1) % NOTIFICATION_CAPACITY;
+        count--;
+        endRemoveRows();
+    }
+
+    beginInsertRows(QModelIndex(), count, count);
+
+    Notification notification{timeStamp, text, logText, error, 1};
+
+    //the buffer grows until it is full, then the oldest slot is reused
+    if (entries.size() < NOTIFICATION_CAPACITY)
+    {
+        entries.append(notification);
+    }
+    else
+    {
+        entry(count) = notification;
+    }
+    count++;
+
+    endInsertRows();
+
+    return true;
+}
@@ -0,0 +1,70 @@
+#ifndef NOTIFICATIONSMODEL_H
+#define NOTIFICATIONSMODEL_H
+
+#include <QAbstractListModel>
+#include <QColor>
+#include <QVector>
+#include "constants.h"
+
+/********************************************************************************
+** notificationsmodel.h
+**
+** The NotificationsModel class holds the notifications shown on the notifications
+** page. Notifications are kept in a ring buffer of NOTIFICATION_CAPACITY entries, the
+** oldest is dropped when it is full. A notification repeating one of the last
+** NOTIFICATION_DEDUPE_WINDOW notifications only increases its repeat count, so a burst
+** of identical notifications (i.e. malformed messages) is a single row.
+**
+** @author Team Controller
+********************************************************************************/
+
+class NotificationsModel : public QAbstractListModel
+{
+    Q_OBJECT
+public:
+    // constructors
+    NotificationsModel(QObject *parent = nullptr);
+
+    // QAbstractListModel interface
+    int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+
+    // adds a notification, returns false if it repeated a recent notification
+    bool add(const QString &timeStamp, const QString &text, const QString &logText, bool error);
+
+    // latest notification added, repeats included
+    QString latestText() const { return lastText; }
+    bool latestIsError() const { return lastError; }
+
+    // notifications added since the model was created, including repeats and
+    // notifications dropped from the ring buffer
+    int totalErrors() const { return errorCount; }
+    int totalInfo() const { return infoCount; }
+
+private:
+    struct Notification
+    {
+        QString timeStamp; // time of the latest repeat
+        QString text;
+        QString logText; // log text of the latest repeat
+        bool error;
+        int repeats;
+    };
+
+    // notification shown in a row, row 0 is the oldest
+    const Notification &entry(int row) const { return entries[(first + row) % NOTIFICATION_CAPACITY]; }
+    Notification &entry(int row) { return entries[(first + row) % NOTIFICATION_CAPACITY]; }
+
+    QVector<Notification> entries; // ring buffer, grows to NOTIFICATION_CAPACITY
+    int first; // index of the oldest notification in entries
+    int count;
+
+    // severity counters
+    int errorCount;
+    int infoCount;
+
+    QString lastText;
+    bool lastError;
+};
+
+#endif // NOTIFICATIONSMODEL_H
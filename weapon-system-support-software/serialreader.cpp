@@ -0,0 +1,260 @@
+#include "serialreader.h"
+
+/********************************************************************************
+** serialreader.cpp
+**
+** This file implements the serial reader thread. The reader thread is the only thread
+** that touches the DDM's serial port, other threads reach the port by queueing calls
+** to the Connection object (i.e. QMetaObject::invokeMethod).
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Initialization constructor for the serial reader
+ *
+ * @param parent Parent object
+ * @param portName The name of the serial port (i.e. COMX, /dev/ttySX, etc).
+ * @param baudRate The baud rate of the serial port (i.e. 9600).
+ * @param dataBits The number of data bits used for communication.
+ * @param parity The type of parity used for error checking.
+ * @param stopBits The number of stop bits used for framing.
+ * @param flowControl The type of flow control used for managing data flow.
+ */
+SerialReader::SerialReader(QObject *parent, QString portName, QSerialPort::BaudRate baudRate,
+                           QSerialPort::DataBits dataBits, QSerialPort::Parity parity,
+                           QSerialPort::StopBits stopBits, QSerialPort::FlowControl flowControl)
+    : QThread(parent), frameQueue(SERIAL_FRAME_QUEUE_SIZE), droppedBytes(0), conn(nullptr), retryScheduled(false),
+    portName(portName), baudRate(baudRate), dataBits(dataBits), parity(parity),
+    stopBits(stopBits), flowControl(flowControl)
+{
+    // avoid opening the port until the thread is running
+}
+
+/**
+ * @brief Destructor, stops the reader thread
+ *
+ * The connection is destroyed as the thread exits, which sends the closing message
+ * if connected and closes the port.
+ */
+SerialReader::~SerialReader()
+{
+    quit();
+    wait();
+}
+
+/**
+ * @brief Starts the reader thread and waits for it to open the port
+ *
+ * @return The connection owned by the reader thread, or nullptr if the port failed to open
+ */
+Connection* SerialReader::startReader()
+{
+    start();
+
+    // wait for run() to attempt opening the port
+    portReady.acquire();
+
+    return conn;
+}
+
+/**
+ * @brief Reader thread entry point
+ *
+ * The connection is declared here so that it, and its serial port, belong to the
+ * reader thread. The thread then runs an event loop so the port can notify us of
+ * new data.
+ */
+void SerialReader::run()
+{
+    Connection connection(portName, baudRate, dataBits, parity, stopBits, flowControl);
+
+    // check for failure to open
+    if (!connection.device->isOpen())
+    {
+        portReady.release();
+        return;
+    }
+
+    // drain the port whenever new data arrives (connection is the context object, so
+    // this runs on the reader thread)
+    connect(connection.device, &QIODevice::readyRead, &connection, [this]() {
+        readSerialData();
+    });
+
+    conn = &connection;
+    portReady.release();
+
+    // process port events until quit() is called
+    exec();
+
+    // the destructor waits for final messages, stop queueing them once the loop has ended
+    QObject::disconnect(connection.device, nullptr, &connection, nullptr);
+    conn = nullptr;
+
+    QMutexLocker locker(&captureMutex);
+    capture.close();
+}
+
+/**
+ * @brief Starts capturing the frames read from the port
+ *
+ * The capture is opened on the calling thread under captureMutex, so this never waits
+ * on the reader thread's event loop. Frames are recorded once the reader thread next
+ * drains the port.
+ *
+ * @param fileName The name of the capture file, an open capture is replaced
+ * @return False if the capture file can not be written
+ */
+bool SerialReader::startCapture(const QString &fileName)
+{
+    QMutexLocker locker(&captureMutex);
+    return capture.open(fileName);
+}
+
+/**
+ * @brief Stops capturing the frames read from the port
+ *
+ * @return The number of frames captured, 0 if there was no capture
+ */
+qint64 SerialReader::stopCapture()
+{
+    QMutexLocker locker(&captureMutex);
+
+    qint64 frames = capture.isOpen() ? capture.frameCount() : 0;
+    capture.close();
+
+    return frames;
+}
+
+/**
+ * @brief Moves complete messages from the port into the frame queue
+ *
+ * Messages are decoded here, on the reader thread. Every byte waiting in the port is
+ * first moved into the connection's receive buffer, whatever the state of the queue.
+ * If the GUI falls far enough behind that the queue fills, the remaining messages
+ * wait in the receive buffer and are framed once a retry finds room in the queue.
+ * Once SERIAL_RECEIVE_BUFFER_LIMIT bytes are waiting as well, further bytes are
+ * dropped and counted in droppedBytes.
+ */
+void SerialReader::readSerialData()
+{
+    #if DEV_MODE
+    // every frame found while draining is stamped with the time the thread woke for it
+    FrameTimestamps readTime;
+    readTime.mark(STAGE_READ);
+    #endif
+
+    // always empty the port, even when the queue is full. a pty's read notifier is level
+    // triggered and would wake this thread again at once for bytes left in the port. the
+    // bytes are dropped rather than buffered without bound if the gui stays behind
+    if (frameQueue.isFull() && conn->bufferedBytes() >= SERIAL_RECEIVE_BUFFER_LIMIT)
+    {
+        conn->discardAvailable();
+    }
+    else
+    {
+        conn->readAvailable();
+    }
+
+    // read lines until all data in buffer is processed or the gui falls behind
+    while (!frameQueue.isFull() && conn->checkForValidMessage() == VALID_MESSAGE)
+    {
+        DecodedFrame frame;
+
+        // the frame keeps its own copy of the message, the receive buffer is reused
+        frame.message = conn->takeMessage().toByteArray();
+
+        #if DEV_MODE
+        frame.timestamps = readTime;
+        frame.timestamps.mark(STAGE_FRAMED);
+        #endif
+
+        decodeFrame(frame);
+
+        #if DEV_MODE
+        frame.timestamps.mark(STAGE_DECODED);
+        #endif
+
+        {
+            QMutexLocker locker(&captureMutex);
+            if (capture.isOpen())
+            {
+                capture.record(frame.message);
+            }
+        }
+
+        frameQueue.push(std::move(frame));
+    }
+
+    // includes the rest of a cut message skipped while framing
+    qint64 discarded = conn->takeDiscardedBytes();
+    if (discarded > 0)
+    {
+        droppedBytes.fetch_add(discarded, std::memory_order_relaxed);
+
+        #if DEV_MODE && SERIAL_COMM_DEBUG
+        qDebug() << "Receive buffer full, dropped" << discarded << "bytes" << Qt::endl;
+        #endif
+    }
+
+    // retry once the gui has had a chance to consume frames
+    if (frameQueue.isFull() && !retryScheduled)
+    {
+        retryScheduled = true;
+
+        QTimer::singleShot(SERIAL_QUEUE_RETRY_INTERVAL, conn, [this]() {
+            retryScheduled = false;
+            readSerialData();
+        });
+    }
+}
+
+/**
+ * @brief Decodes the payload of a frame according to its message id
+ *
+ * @param frame Frame containing the message to decode
+ */
+void SerialReader::decodeFrame(DecodedFrame &frame)
+{
+    frame.valid = false;
+
+    // check if message id is present and followed by the proper delimeter
+    frame.hasMessageId = MessageDecoder::splitMessageId(frame.message, frame.messageId, frame.payload);
+    if (!frame.hasMessageId)
+    {
+        return;
+    }
+
+    switch (frame.messageId)
+    {
+    case STATUS:
+        frame.valid = MessageDecoder::decodeStatus(frame.payload, frame.status);
+        break;
+    case EVENT:
+        frame.valid = MessageDecoder::decodeEvent(frame.payload, frame.event);
+        break;
+    case ERROR:
+        frame.valid = MessageDecoder::decodeError(frame.payload, frame.error);
+        break;
+    case ELECTRICAL:
+        frame.valid = MessageDecoder::decodeElectricalDump(frame.payload, frame.electrical);
+        break;
+    case EVENT_DUMP:
+        frame.valid = MessageDecoder::decodeEventDump(frame.payload, frame.eventDump);
+        break;
+    case ERROR_DUMP:
+        frame.valid = MessageDecoder::decodeErrorDump(frame.payload, frame.errorDump);
+        break;
+    case CLEAR_ERROR:
+        frame.valid = MessageDecoder::decodeClear(frame.payload, frame.clear);
+        break;
+    case BEGIN:
+        frame.valid = MessageDecoder::decodeBegin(frame.payload, frame.begin);
+        break;
+    default:
+        // closing connection carries no data, unrecognized ids are reported by the gui
+        frame.valid = true;
+        break;
+    }
+}
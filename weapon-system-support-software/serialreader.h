@@ -0,0 +1,122 @@
+#ifndef SERIALREADER_H
+#define SERIALREADER_H
+
+#include <QThread>
+#include <QMutex>
+#include <QSemaphore>
+#include "connection.h"
+#include "messagedecoder.h"
+#include "sessioncapture.h"
+#include "spscqueue.h"
+#if DEV_MODE
+#include "latencytracker.h"
+#endif
+
+/********************************************************************************
+** serialreader.h
+**
+** The SerialReader class owns the DDM's serial port on a dedicated thread. It drains
+** the port as soon as data arrives, frames and decodes each message, and hands the
+** decoded frames to the GUI thread through a lock-free queue. The GUI consumes the
+** queue on its own schedule, so slow GUI or log file work never delays reading the port.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief A serial message decoded on the serial reader thread
+ *
+ * The typed frames are views into message, which the frame owns, so they remain
+ * valid after the frame is handed to the GUI thread.
+ */
+struct DecodedFrame
+{
+    QByteArray message; // the full serial message, including its id and \n
+    bool hasMessageId; // false if the message does not begin with an id and delimeter
+    SerialMessageIdentifier messageId;
+    QByteArrayView payload; // the message with its id removed
+    bool valid; // result of decoding the payload according to messageId
+
+    // only the frame matching messageId is filled in
+    StatusFrame status;
+    EventFrame event;
+    ErrorFrame error;
+    ClearFrame clear;
+    BeginFrame begin;
+    QVector<EventFrame> eventDump;
+    QVector<ErrorFrame> errorDump;
+    QVector<ElectricalFrame> electrical;
+
+    #if DEV_MODE
+    // time the frame reached each stage of the ingest path, see latencytracker.h
+    FrameTimestamps timestamps;
+    #endif
+};
+
+class SerialReader : public QThread
+{
+    Q_OBJECT
+
+public:
+    // stores the port settings, the port is opened once the reader thread starts
+    SerialReader(QObject *parent, QString portName, QSerialPort::BaudRate baudRate,
+                 QSerialPort::DataBits dataBits, QSerialPort::Parity parity,
+                 QSerialPort::StopBits stopBits, QSerialPort::FlowControl flowControl);
+
+    // stops the reader thread, which closes the port
+    ~SerialReader();
+
+    // starts the reader thread and waits for it to open the port. returns the connection,
+    // which lives on the reader thread, or nullptr if the port could not be opened
+    Connection* startReader();
+
+    // frames decoded by the reader thread, waiting to be consumed by the GUI thread
+    SpscQueue<DecodedFrame> frameQueue;
+
+    // bytes dropped by the reader thread because the frame queue and the receive buffer
+    // were both full, taken by the GUI thread to report them
+    std::atomic<qint64> droppedBytes;
+
+    // captures every frame read from the port until stopCapture, returns false if the
+    // capture file can not be written. safe to call from any thread, whether or not the
+    // reader is running
+    bool startCapture(const QString &fileName);
+
+    // closes the capture, returns the number of frames captured
+    qint64 stopCapture();
+
+private:
+    // opens the port and processes its events until quit() is called
+    void run() override;
+
+    // moves complete messages from the port into the frame queue
+    void readSerialData();
+
+    // decodes the payload of frame according to its message id
+    static void decodeFrame(DecodedFrame &frame);
+
+    // connection created by the reader thread, nullptr while the thread is not running
+    Connection *conn;
+
+    // released by the reader thread once it has attempted to open the port
+    QSemaphore portReady;
+
+    // true while a retry is pending because the frame queue was full
+    bool retryScheduled;
+
+    // frames read from the port are recorded here while a capture is open. opened and
+    // closed by the GUI thread and recorded to by the reader thread, always under
+    // captureMutex
+    SessionCaptureWriter capture;
+    QMutex captureMutex;
+
+    // port settings
+    QString portName;
+    QSerialPort::BaudRate baudRate;
+    QSerialPort::DataBits dataBits;
+    QSerialPort::Parity parity;
+    QSerialPort::StopBits stopBits;
+    QSerialPort::FlowControl flowControl;
+};
+
+#endif // SERIALREADER_H
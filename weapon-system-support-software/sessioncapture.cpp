@@ -0,0 +1,150 @@
+#include "sessioncapture.h"
+#include <QDebug>
+
+/********************************************************************************
+** sessioncapture.cpp
+**
+** This file implements writing and reading session captures.
+**
+** @author Team Controller
+********************************************************************************/
+
+// identifies capture files, the version changes whenever the record layout does
+static const quint32 SESSION_CAPTURE_MAGIC = 0x57535343; // "WSSC"
+static const quint32 SESSION_CAPTURE_VERSION = 1;
+
+/**
+ * @brief Constructor, nothing is captured until open is called
+ */
+SessionCaptureWriter::SessionCaptureWriter()
+    : frames(0)
+{
+}
+
+/**
+ * @brief Destructor, closes the capture file
+ */
+SessionCaptureWriter::~SessionCaptureWriter()
+{
+    close();
+}
+
+/**
+ * @brief Creates a capture file, a capture already open is closed first
+ *
+ * @param fileName The name of the capture file
+ * @return False if the capture file could not be written
+ */
+bool SessionCaptureWriter::open(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qDebug() << "Error: SessionCaptureWriter::open could not open capture file: " << fileName << Qt::endl;
+        return false;
+    }
+
+    out.setDevice(&file);
+    out << SESSION_CAPTURE_MAGIC << SESSION_CAPTURE_VERSION;
+
+    frames = 0;
+    timer.start();
+
+    return out.status() == QDataStream::Ok;
+}
+
+/**
+ * @brief Appends a frame to the capture
+ *
+ * @param frame The frame as read from the port, including its \n
+ */
+void SessionCaptureWriter::record(QByteArrayView frame)
+{
+    if (!file.isOpen())
+    {
+        return;
+    }
+
+    //the frame is written straight from the receive buffer, the same way a QByteArray is streamed
+    out << timer.nsecsElapsed();
+    out.writeBytes(frame.data(), static_cast<uint>(frame.size()));
+
+    frames++;
+}
+
+/**
+ * @brief Flushes and closes the capture file
+ */
+void SessionCaptureWriter::close()
+{
+    if (!file.isOpen())
+    {
+        return;
+    }
+
+    #if DEV_MODE && SERIAL_COMM_DEBUG
+    qDebug() << "Captured " << frames << " frames to: " << file.fileName();
+    #endif
+
+    out.setDevice(nullptr);
+    file.close();
+}
+
+/**
+ * @brief Opens a capture file for replay
+ *
+ * @param fileName The name of the capture file
+ * @return False if the file can not be read or is not a capture of this version
+ */
+bool SessionCaptureReader::open(const QString &fileName)
+{
+    close();
+    file.setFileName(fileName);
+
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Error: SessionCaptureReader::open could not open capture file: " << fileName << Qt::endl;
+        return false;
+    }
+
+    in.setDevice(&file);
+
+    quint32 magic;
+    quint32 version;
+    in >> magic >> version;
+
+    if (in.status() != QDataStream::Ok || magic != SESSION_CAPTURE_MAGIC || version != SESSION_CAPTURE_VERSION)
+    {
+        qDebug() << "Error: SessionCaptureReader::open not a session capture: " << fileName << Qt::endl;
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Reads the next frame of the capture
+ *
+ * @param frame Receives the frame, its data is reused between calls
+ * @return False at the end of the capture or at a record cut short
+ */
+bool SessionCaptureReader::next(CapturedFrame &frame)
+{
+    if (!file.isOpen() || in.atEnd())
+    {
+        return false;
+    }
+
+    in >> frame.timeNs >> frame.data;
+
+    return in.status() == QDataStream::Ok;
+}
+
+void SessionCaptureReader::close()
+{
+    in.setDevice(nullptr);
+    file.close();
+}
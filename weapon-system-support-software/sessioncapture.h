@@ -0,0 +1,77 @@
+#ifndef SESSIONCAPTURE_H
+#define SESSIONCAPTURE_H
+
+#include <QByteArray>
+#include <QByteArrayView>
+#include <QDataStream>
+#include <QElapsedTimer>
+#include <QFile>
+#include "constants.h"
+
+/********************************************************************************
+** sessioncapture.h
+**
+** Session captures record every frame the DDM receives during a session, each with
+** the monotonic time it was read from the port, so the session can later be replayed
+** against another build (see sessionreplayer.h).
+**
+** A capture file holds a header (magic and version) followed by one record per
+** frame: the nanoseconds since the capture started and the frame bytes, including
+** the terminating \n. A record cut short (i.e. the DDM closed mid write) ends the
+** capture.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief A frame read back from a capture
+ */
+struct CapturedFrame
+{
+    qint64 timeNs = 0; // time the frame was received, since the capture started
+    QByteArray data; // the frame, including its \n
+};
+
+class SessionCaptureWriter
+{
+public:
+    SessionCaptureWriter();
+    ~SessionCaptureWriter();
+
+    // creates a capture file, returns false if it can not be written
+    bool open(const QString &fileName);
+
+    // appends a frame stamped with the time since open
+    void record(QByteArrayView frame);
+
+    // flushes and closes the capture file
+    void close();
+
+    bool isOpen() const { return file.isOpen(); }
+    QString fileName() const { return file.fileName(); }
+    qint64 frameCount() const { return frames; }
+
+private:
+    QFile file;
+    QDataStream out;
+    QElapsedTimer timer;
+    qint64 frames;
+};
+
+class SessionCaptureReader
+{
+public:
+    // opens a capture file, returns false if it is not a capture
+    bool open(const QString &fileName);
+
+    // reads the next frame, returns false at the end of the capture
+    bool next(CapturedFrame &frame);
+
+    void close();
+
+private:
+    QFile file;
+    QDataStream in;
+};
+
+#endif // SESSIONCAPTURE_H
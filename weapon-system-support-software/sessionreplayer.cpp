@@ -0,0 +1,212 @@
+#include "sessionreplayer.h"
+//this file wont compile if dev mode is inactive
+#if DEV_MODE
+
+/********************************************************************************
+** sessionreplayer.cpp
+**
+** This file implements replaying a session capture to the DDM.
+**
+** @author Team Controller
+********************************************************************************/
+
+/**
+ * @brief Constructor, nothing is replayed until startReplay is called
+ */
+SessionReplayer::SessionReplayer(QObject *parent)
+    : QThread(parent), stop(false), fast(false)
+{
+}
+
+/**
+ * @brief Destructor, stops the replay
+ */
+SessionReplayer::~SessionReplayer()
+{
+    stop = true;
+    wait();
+}
+
+/**
+ * @brief Starts replaying a capture on the replayer thread
+ *
+ * @param portName The port the ddm listens on
+ * @param captureFile The session capture to replay
+ * @param fast True to send frames as fast as possible
+ */
+void SessionReplayer::startReplay(const QString &portName, const QString &captureFile, bool fast)
+{
+    if (isRunning())
+    {
+        qDebug() << "Error: SessionReplayer::startReplay, a replay is already running" << Qt::endl;
+        return;
+    }
+
+    this->portName = portName;
+    this->captureFile = captureFile;
+    this->fast = fast;
+    stop = false;
+
+    start();
+}
+
+/**
+ * @brief Stops the replay
+ */
+void SessionReplayer::stopReplay()
+{
+    stop = true;
+}
+
+/**
+ * @brief Replayer thread entry point
+ *
+ * Captures begin with the controller's reply to the handshake, so nothing is sent
+ * until the ddm sends one. Frames are sent in batches of REPLAY_BATCH_SIZE bytes, or
+ * whenever the next frame is not due yet.
+ */
+void SessionReplayer::run()
+{
+    SessionCaptureReader capture;
+    if (!capture.open(captureFile))
+    {
+        emit replayFinished(-1, 0);
+        return;
+    }
+
+    Connection conn(portName);
+    if (!conn.device->isOpen())
+    {
+        emit replayFinished(-1, 0);
+        return;
+    }
+
+    bool listening = false;
+    bool closing = false;
+
+    //wait for the ddm to start a session
+    while (!stop && !listening)
+    {
+        conn.device->waitForReadyRead(REPLAY_POLL_INTERVAL);
+        readDDMMessages(conn, listening, closing);
+    }
+
+    //stopped before the ddm connected, there is no session to close
+    if (!listening)
+    {
+        emit replayFinished(0, 0);
+        return;
+    }
+
+    #if CSIM_DEBUG
+    qDebug() << "[REPLAY] Handshake received, replaying " << captureFile;
+    #endif
+
+    //the ddm is sent a closing message if the replay ends before the session does
+    conn.connected = true;
+
+    QElapsedTimer timer;
+    CapturedFrame frame;
+    QByteArray batch;
+    qint64 firstNs = -1;
+    qint64 frames = 0;
+    bool controllerClosed = false;
+    const QByteArray closingPrefix = QByteArray::number(CLOSING_CONNECTION) + ',';
+
+    while (!stop && !closing && capture.next(frame))
+    {
+        //frames are timed from the first frame of the capture
+        if (firstNs == -1)
+        {
+            firstNs = frame.timeNs;
+            timer.start();
+        }
+
+        //send what is waiting and wait until the frame is due, watching for the ddm closing
+        if (!fast && timer.nsecsElapsed() < frame.timeNs - firstNs)
+        {
+            writeBatch(conn, batch);
+
+            qint64 remainingNs;
+            while (!stop && !closing && (remainingNs = frame.timeNs - firstNs - timer.nsecsElapsed()) > 0)
+            {
+                conn.device->waitForReadyRead(static_cast<int>(qMin<qint64>(remainingNs / 1000000, REPLAY_POLL_INTERVAL)));
+                readDDMMessages(conn, listening, closing);
+            }
+        }
+
+        batch += frame.data;
+        frames++;
+        controllerClosed = frame.data.startsWith(closingPrefix);
+
+        if (batch.size() >= REPLAY_BATCH_SIZE)
+        {
+            writeBatch(conn, batch);
+            readDDMMessages(conn, listening, closing);
+        }
+    }
+
+    writeBatch(conn, batch);
+    qint64 elapsedMs = timer.isValid() ? timer.elapsed() : 0;
+
+    //the session already ended, dont send another closing message
+    if (closing || controllerClosed)
+    {
+        conn.connected = false;
+    }
+
+    #if CSIM_DEBUG
+    qDebug() << "[REPLAY] Sent " << frames << " frames in " << elapsedMs << " msec";
+    #endif
+
+    emit replayFinished(frames, elapsedMs);
+}
+
+void SessionReplayer::readDDMMessages(Connection &conn, bool &listening, bool &closing)
+{
+    while (conn.checkForValidMessage() == VALID_MESSAGE)
+    {
+        QByteArrayView message = conn.takeMessage();
+
+        //the message id ends at the first delimeter, or at the \n of a message with no fields
+        qsizetype idEnd = message.indexOf(',');
+        if (idEnd == -1)
+        {
+            idEnd = message.size() - 1;
+        }
+
+        bool valid = false;
+        int messageId = message.first(idEnd).trimmed().toInt(&valid);
+
+        if (valid && messageId == LISTENING)
+        {
+            listening = true;
+        }
+        else if (valid && messageId == CLOSING_CONNECTION)
+        {
+            closing = true;
+        }
+    }
+}
+
+void SessionReplayer::writeBatch(Connection &conn, QByteArray &batch)
+{
+    if (batch.isEmpty())
+    {
+        return;
+    }
+
+    if (conn.device->write(batch) != batch.size())
+    {
+        qDebug() << "Error: SessionReplayer::writeBatch failed to write to " << conn.portName << Qt::endl;
+    }
+
+    //a serial port buffers writes, let it drain so the buffer does not grow without bound
+    while (conn.device->bytesToWrite() > 0 && conn.device->waitForBytesWritten(REPLAY_POLL_INTERVAL))
+    {
+    }
+
+    //keep the allocation for the next batch
+    batch.resize(0);
+}
+#endif
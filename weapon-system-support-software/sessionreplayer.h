@@ -0,0 +1,60 @@
+#ifndef SESSIONREPLAYER_H
+#define SESSIONREPLAYER_H
+#if DEV_MODE
+#include <QThread>
+#include <atomic>
+#include "connection.h"
+#include "sessioncapture.h"
+
+/********************************************************************************
+** sessionreplayer.h
+**
+** The SessionReplayer class stands in for the controller and replays a session
+** capture to the DDM, so a recorded field session can be run against a new build.
+** Like CSim it runs on its own thread and opens a port (usually a loopback port).
+** Once the DDM sends its handshake, the captured frames are sent either at the
+** pace they were received or as fast as the port takes them.
+**
+** @author Team Controller
+********************************************************************************/
+
+class SessionReplayer : public QThread
+{
+    Q_OBJECT
+
+public:
+    SessionReplayer(QObject *parent = nullptr);
+
+    // stops the replay and waits for the thread to finish
+    ~SessionReplayer();
+
+    // replays captureFile through portName. fast sends frames as fast as possible
+    // instead of at their captured times
+    void startReplay(const QString &portName, const QString &captureFile, bool fast);
+
+    // stops the replay, the ddm is sent a closing message if it is connected
+    void stopReplay();
+
+signals:
+    // emitted when the replay ends, frames is -1 if the port or capture could not be opened.
+    // elapsedMs is the time from the first frame sent to the last
+    void replayFinished(qint64 frames, qint64 elapsedMs);
+
+private:
+    void run() override;
+
+    // reads messages from the ddm, flags a handshake or closing message
+    static void readDDMMessages(Connection &conn, bool &listening, bool &closing);
+
+    // writes frames waiting to be sent, a serial port is given time to drain
+    static void writeBatch(Connection &conn, QByteArray &batch);
+
+    std::atomic<bool> stop;
+
+    QString portName;
+    QString captureFile;
+    bool fast;
+};
+
+#endif //DEV_MODE
+#endif // SESSIONREPLAYER_H
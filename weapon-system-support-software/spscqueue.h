@@ -0,0 +1,113 @@
+#ifndef SPSCQUEUE_H
+#define SPSCQUEUE_H
+
+#include <QtGlobal>
+#include <atomic>
+#include <memory>
+
+/********************************************************************************
+** spscqueue.h
+**
+** The SpscQueue class is a fixed capacity, lock-free ring buffer for handing items
+** from exactly one producer thread to exactly one consumer thread. Neither side
+** ever blocks: push fails when the queue is full and pop fails when it is empty.
+**
+** @author Team Controller
+********************************************************************************/
+
+template <typename T>
+class SpscQueue
+{
+public:
+    // capacity is rounded up to the next power of 2
+    explicit SpscQueue(qsizetype capacity);
+
+    // producer side, moves item into the queue. returns false if the queue is full
+    bool push(T &&item);
+
+    // consumer side, moves the oldest item out of the queue. returns false if the queue is empty
+    bool pop(T &item);
+
+    // consumer side, true if there is nothing to pop
+    bool isEmpty() const;
+
+    // producer side, true if push would fail
+    bool isFull() const;
+
+private:
+    std::unique_ptr<T[]> items;
+    size_t capacity;
+    size_t mask;
+
+    // kept on separate cache lines so the producer and consumer do not contend
+    alignas(64) std::atomic<size_t> readIndex; // only written by the consumer
+    alignas(64) std::atomic<size_t> writeIndex; // only written by the producer
+};
+
+/**
+ * @brief Initialization constructor for the queue
+ *
+ * @param capacity Minimum number of items the queue can hold
+ */
+template <typename T>
+SpscQueue<T>::SpscQueue(qsizetype capacity)
+    : capacity(1), readIndex(0), writeIndex(0)
+{
+    //round capacity up so indices can be wrapped with a mask
+    while (this->capacity < static_cast<size_t>(capacity))
+    {
+        this->capacity <<= 1;
+    }
+    mask = this->capacity - 1;
+    items.reset(new T[this->capacity]);
+}
+
+template <typename T>
+bool SpscQueue<T>::push(T &&item)
+{
+    size_t write = writeIndex.load(std::memory_order_relaxed);
+
+    //check for full queue
+    if (write - readIndex.load(std::memory_order_acquire) == capacity)
+    {
+        return false;
+    }
+
+    items[write & mask] = std::move(item);
+
+    //publish the item to the consumer
+    writeIndex.store(write + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::pop(T &item)
+{
+    size_t read = readIndex.load(std::memory_order_relaxed);
+
+    //check for empty queue
+    if (read == writeIndex.load(std::memory_order_acquire))
+    {
+        return false;
+    }
+
+    item = std::move(items[read & mask]);
+
+    //hand the slot back to the producer
+    readIndex.store(read + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T>
+bool SpscQueue<T>::isEmpty() const
+{
+    return readIndex.load(std::memory_order_relaxed) == writeIndex.load(std::memory_order_acquire);
+}
+
+template <typename T>
+bool SpscQueue<T>::isFull() const
+{
+    return writeIndex.load(std::memory_order_relaxed) - readIndex.load(std::memory_order_acquire) == capacity;
+}
+
+#endif // SPSCQUEUE_H
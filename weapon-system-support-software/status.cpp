@@ -24,142 +24,41 @@ Status::Status(QObject *parent)
 /**
  * @brief Loads data into the status class given a status message
  *
- * Parses statusMessage and updates status class variabels with new data
+ * Decodes statusMessage and updates status class variabels with new data
  *
  * @param statusMessage Message containing data to be parsed
  */
 bool Status::loadData(QString statusMessage)
 {
-    /* the statusMessage contains data in the following order
-     *
-        bool armed;
-        TriggerStatus trigger1;
-        TriggerStatus trigger2;
-        ControllerState controllerState;
-        FiringMode firingMode;
-        FeedPosition feedPosition;
-        // to find total events including errors, add total errors and events
-        int totalFiringEvents;
-        int burstLength;
-        double firingRate;
-     *
-     */
+    QByteArray serializedMessage = statusMessage.toUtf8();
+    StatusFrame frame;
 
-    QStringList values = statusMessage.split(DELIMETER);
-
-    // check if message contains too few or too many items
-    if (values.length()-1 != NUM_STATUS_ELEMENTS)
+    //validate message, no data is loaded if any value is invalid
+    if (!MessageDecoder::decodeStatus(serializedMessage, frame))
     {
-        qDebug() << "Error: Status::loadData invalid number of delimeters: " << statusMessage << Qt::endl;
         return false;
     }
 
-    //verify all data is valid====================================================
-
-    //get data into vars to prevent inefficiency caused by recasting over and over
-    bool firRateConversionResult = false;
-    int trig1 = values[1].toInt();
-    int trig2 = values[2].toInt();
-    int conState = values[3].toInt();
-    int firMode = values[4].toInt();
-    int feedPos = values[5].toInt();
-    int totFirEvents = values[6].toInt();
-    int burLen = values[7].toInt();
-    double firRate = values[8].toDouble(&firRateConversionResult);
-
-    //check each value to ensure it is of correct type. if the toInt() method fails
-    //the return will be 0. So if we find an int =0 and its string != 0, its a fail.
-    //we also check that the integers are in range of their respective enumerations
-    //declared in constants. Firing mode and feed position are exceptions, each
-    //val is manually checked because their enumerations represent degrees.
-
-    //armed
-    if (values[0] != "0" && values[0] != "1")
-    {
-        qDebug()<< "Error: Status::loadData invalid armed value: " << values[0]<< Qt::endl;
-    }
-    //trigger 1
-    else if ((values[1] != "0" && trig1 == 0) || trig1 < 0
-               || trig1 >= NUM_TRIGGER_STATUS )
-    {
-        qDebug() << "Error: Status::loadData invalid trigger 1 value: " << values[1] << Qt::endl;
-    }
-    //trigger 2
-    else if ((values[2] != "0" && trig2 == 0) || trig2 < 0
-             || trig2 >= NUM_TRIGGER_STATUS )
-    {
-        qDebug() << "Error: Status::loadData invalid trigger 2 value: " << values[2] << Qt::endl;
-    }
-    //controller state
-    else if ((values[3] != "0" && conState == 0) || conState < 0
-             || conState >= NUM_CONTROLLER_STATE )
-    {
-        qDebug() << "Error: Status::loadData invalid controller state value: " << values[3]<< Qt::endl;
-    }
-    //firing mode
-    else if ( (values[4] != "0" && firMode == 0) || (firMode != SAFE &&
-               firMode != SINGLE && firMode != BURST && firMode != FULL_AUTO))
-    {
-        qDebug() << "Error: Status::loadData invalid firing mode value: " << values[4]<< Qt::endl;
-    }
-    //feed pos
-    else if ( (values[5] != "0" && feedPos == 0) || (feedPos != CHAMBERING
-               && feedPos != LOCKING
-               && feedPos != FIRING && feedPos != UNLOCKING
-               && feedPos != EXTRACTING && feedPos != EJECTING
-               && feedPos != COCKING && feedPos != FEEDING))
-    {
-        qDebug() << "Error: Status::loadData invalid feed position value: " << values[5] << Qt::endl;
-    }
-    //total firing events
-    else if ( (values[6] != "0" && totFirEvents == 0) || totFirEvents < 0)
-    {
-        qDebug() << "Error: Status::loadData invalid total firing events value: " << values[6]<< Qt::endl;
-    }
-    //burst length
-    else if ( (values[6] != "0" && burLen == 0) || burLen < 0)
-    {
-        qDebug() << "Error: Status::loadData invalid burst length value: " << values[7]<< Qt::endl;
-    }
-    //firing rate
-    else if ( !firRateConversionResult || firRate < 0)
-    {
-        qDebug() << "Error: Status::loadData invalid firing rate value: " << values[8]<< Qt::endl;
-    }
-    //all data has been verified at this point==========================================
-    else
-    {
-        //extract armed value from message
-        armed = (values[0] == "1");
-
-        //extract trigger1 status
-        trigger1 = static_cast<TriggerStatus>(trig1);
-
-        //extract trigger2
-        trigger2 = static_cast<TriggerStatus>(trig2);
-
-        //extract controller state
-        controllerState = static_cast<ControllerState>(conState);
-
-        //extract firing mode
-        firingMode = static_cast<FiringMode>(firMode);
-
-        //extract feed pos
-        feedPosition = static_cast<FeedPosition>(feedPos);
-
-        //extract
-        totalFiringEvents = totFirEvents;
-
-        //extract
-        burstLength = burLen;
-
-        //extract
-        firingRate = firRate;
+    loadData(frame);
+    return true;
+}
 
-        return true;
-    }
-    //one of the tests failed, no data was loaded from this message
-    return false;
+/**
+ * @brief Loads data into the status class given a decoded status message
+ *
+ * @param frame Status data that has already been validated by the message decoder
+ */
+void Status::loadData(const StatusFrame &frame)
+{
+    armed = frame.armed;
+    trigger1 = frame.trigger1;
+    trigger2 = frame.trigger2;
+    controllerState = frame.controllerState;
+    firingMode = frame.firingMode;
+    feedPosition = frame.feedPosition;
+    totalFiringEvents = frame.totalFiringEvents;
+    burstLength = frame.burstLength;
+    firingRate = frame.firingRate;
 }
 
 /**
@@ -171,35 +70,31 @@ bool Status::loadData(QString statusMessage)
  */
 bool Status::loadVersionData(QString versionMessage)
 {
-    //split along delimeter
-    QStringList values = versionMessage.split(DELIMETER);
+    QByteArray serializedMessage = versionMessage.toUtf8();
+    BeginFrame frame;
 
     //ensure message has correct format
-    if(values.length()-1 != NUM_BEGIN_ELEMENTS)
+    if (!MessageDecoder::decodeBegin(serializedMessage, frame))
     {
         return false;
     }
 
-    //message is valid, load data
-
-    // Split time string
-    QStringList parts = values[0].split(':');
-    if (parts.size() != 4) {
-        qDebug() << "Error: loadVersionData: Invalid time string format in load version data: " << values[0]<< Qt::endl;
-        return false;
-    }
-
-    // Calculate total milliseconds
-    qint64 totalMilliseconds = parts[0].toInt() * 3600000LL + parts[1].toInt() * 60000LL + parts[2].toInt()
-                               * 1000LL + parts[3].toInt();
-
+    loadVersionData(frame);
+    return true;
+}
 
-    // Initialize elapsedControllerTime
-    elapsedControllerTime = QTime::fromMSecsSinceStartOfDay(totalMilliseconds);
+/**
+ * @brief Updates crc and controller versions given a decoded begin message
+ *
+ * @param frame Begin data that has already been validated by the message decoder
+ */
+void Status::loadVersionData(const BeginFrame &frame)
+{
+    // initialize elapsedControllerTime
+    elapsedControllerTime = QTime::fromMSecsSinceStartOfDay(frame.elapsedMsecs);
 
-    version = values[1];
-    crc = values[2];
-    return true;
+    version = QString::fromUtf8(frame.version);
+    crc = QString::fromUtf8(frame.crc);
 }
 
 /**
@@ -4,6 +4,7 @@
 #include <QObject>
 #include <QString>
 #include "constants.h"
+#include "messagedecoder.h"
 #if DEV_MODE
 #include <QRandomGenerator>
 #endif
@@ -46,9 +47,11 @@ public:
 
     //reads a status message from controller and updates class variables
     bool loadData(QString statusMessage);
+    void loadData(const StatusFrame &frame);
 
     //reads a message containing controller version and crc and updates corresponding class variables
     bool loadVersionData(QString versionMessage);
+    void loadVersionData(const BeginFrame &frame);
 
     //outputs values of status class to string format
     QString toString();
@@ -0,0 +1,410 @@
+#include "transport.h"
+#include <QDeadlineTimer>
+#include <QDebug>
+#include <QFile>
+
+#ifdef Q_OS_UNIX
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+#if defined(Q_OS_MACOS)
+#include <util.h>
+#else
+#include <pty.h>
+#endif
+#endif
+
+/********************************************************************************
+** transport.cpp
+**
+** This file implements the loopback transports used in place of a serial port.
+**
+** @author Team Controller
+********************************************************************************/
+
+QMutex PipeTransport::waitingPipesMutex;
+QHash<QString, QSharedPointer<PipeTransport::Pipe>> PipeTransport::waitingPipes;
+
+/**
+ * @brief Constructor, the pipe is paired when opened
+ *
+ * @param pipeName Name both ends of the pipe open
+ * @param parent Parent object
+ */
+PipeTransport::PipeTransport(const QString &pipeName, QObject *parent)
+    : QIODevice(parent), pipeName(pipeName), end(0)
+{
+}
+
+/**
+ * @brief Destructor, closes the pipe
+ */
+PipeTransport::~PipeTransport()
+{
+    close();
+}
+
+/**
+ * @brief Opens this end of the pipe
+ *
+ * The first end opened waits for a second end of the same name. Bytes written before
+ * the second end opens are kept for it. An end that closes can be replaced by opening
+ * the same name again, like plugging a cable back in.
+ *
+ * @param mode Open mode, the pipe is always unbuffered
+ * @return False if the pipe is already open
+ */
+bool PipeTransport::open(OpenMode mode)
+{
+    if (isOpen())
+    {
+        return false;
+    }
+
+    {
+        QMutexLocker waitingLocker(&waitingPipesMutex);
+
+        //take the free end of a waiting pipe, or wait for another end
+        QSharedPointer<Pipe> waiting = waitingPipes.take(pipeName);
+        if (waiting.isNull())
+        {
+            pipe.reset(new Pipe());
+            end = 0;
+            waitingPipes.insert(pipeName, pipe);
+        }
+        else
+        {
+            pipe = waiting;
+            end = (pipe->ends[0] == nullptr) ? 0 : 1;
+        }
+
+        QMutexLocker locker(&pipe->mutex);
+        pipe->ends[end] = this;
+        pipe->closed[end] = false;
+
+        //bytes written before this end opened
+        if (!pipe->buffers[end].isEmpty())
+        {
+            QMetaObject::invokeMethod(this, [this]() { emit readyRead(); }, Qt::QueuedConnection);
+        }
+    }
+
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+/**
+ * @brief Closes this end of the pipe, bytes written to it are dropped until it is reopened
+ */
+void PipeTransport::close()
+{
+    if (!pipe.isNull())
+    {
+        QMutexLocker waitingLocker(&waitingPipesMutex);
+
+        QMutexLocker locker(&pipe->mutex);
+        pipe->ends[end] = nullptr;
+        pipe->closed[end] = true;
+        pipe->buffers[end].clear();
+        bool peerOpen = (pipe->ends[1 - end] != nullptr);
+        locker.unlock();
+
+        //the end left open waits for a new end of the same name
+        if (peerOpen)
+        {
+            if (!waitingPipes.contains(pipeName))
+            {
+                waitingPipes.insert(pipeName, pipe);
+            }
+        }
+        else if (waitingPipes.value(pipeName) == pipe)
+        {
+            waitingPipes.remove(pipeName);
+        }
+
+        pipe.reset();
+    }
+
+    QIODevice::close();
+}
+
+qint64 PipeTransport::bytesAvailable() const
+{
+    if (pipe.isNull())
+    {
+        return QIODevice::bytesAvailable();
+    }
+
+    QMutexLocker locker(&pipe->mutex);
+    return pipe->buffers[end].size() + QIODevice::bytesAvailable();
+}
+
+/**
+ * @brief Waits for bytes from the other end
+ *
+ * Like a serial port, the wait lasts the full timeout when the other end is closed.
+ *
+ * @param msecs Most time to wait, -1 waits until bytes arrive
+ * @return True if bytes are waiting to be read
+ */
+bool PipeTransport::waitForReadyRead(int msecs)
+{
+    if (pipe.isNull())
+    {
+        return false;
+    }
+
+    QDeadlineTimer deadline(msecs);
+    QMutexLocker locker(&pipe->mutex);
+
+    //both ends share the condition, so wait again if woken for the other end
+    while (pipe->buffers[end].isEmpty())
+    {
+        if (!pipe->dataReady.wait(&pipe->mutex, deadline))
+        {
+            break;
+        }
+    }
+
+    return !pipe->buffers[end].isEmpty();
+}
+
+qint64 PipeTransport::readData(char *data, qint64 maxSize)
+{
+    if (pipe.isNull())
+    {
+        return -1;
+    }
+
+    QMutexLocker locker(&pipe->mutex);
+    QByteArray &buffer = pipe->buffers[end];
+
+    qint64 size = qMin(maxSize, static_cast<qint64>(buffer.size()));
+    memcpy(data, buffer.constData(), size);
+    buffer.remove(0, size);
+
+    return size;
+}
+
+qint64 PipeTransport::writeData(const char *data, qint64 maxSize)
+{
+    if (pipe.isNull())
+    {
+        return -1;
+    }
+
+    QMutexLocker locker(&pipe->mutex);
+    int peer = 1 - end;
+
+    //a closed end drops bytes, like a serial port with nothing attached
+    if (!pipe->closed[peer])
+    {
+        QByteArray &buffer = pipe->buffers[peer];
+        bool wasEmpty = buffer.isEmpty();
+
+        buffer.append(data, maxSize);
+        pipe->dataReady.wakeAll();
+
+        //readyRead is emitted on the receiving end's thread, once per batch of unread bytes
+        PipeTransport *receiver = pipe->ends[peer];
+        if (wasEmpty && receiver != nullptr)
+        {
+            QMetaObject::invokeMethod(receiver, [receiver]() { emit receiver->readyRead(); }, Qt::QueuedConnection);
+        }
+    }
+
+    locker.unlock();
+
+    emit bytesWritten(maxSize);
+    return maxSize;
+}
+
+//======================================================================================
+// PtyTransport
+//======================================================================================
+#ifdef Q_OS_UNIX
+/**
+ * @brief Constructor, the pty is created when opened
+ *
+ * @param linkPath Path the slave end is linked at, the other side opens it as a serial port
+ * @param parent Parent object
+ */
+PtyTransport::PtyTransport(const QString &linkPath, QObject *parent)
+    : QIODevice(parent), linkPath(linkPath), masterFd(-1), slaveFd(-1), readNotifier(nullptr)
+{
+}
+
+/**
+ * @brief Destructor, closes the pty
+ */
+PtyTransport::~PtyTransport()
+{
+    close();
+}
+
+/**
+ * @brief Creates the pty and links its slave end
+ *
+ * A link left at linkPath by an earlier run is replaced.
+ *
+ * @param mode Open mode, the pty is always unbuffered
+ * @return False if the pty could not be created or linked
+ */
+bool PtyTransport::open(OpenMode mode)
+{
+    if (isOpen())
+    {
+        return false;
+    }
+
+    if (::openpty(&masterFd, &slaveFd, nullptr, nullptr, nullptr) == -1)
+    {
+        qDebug() << "Error: PtyTransport::open could not open a pty: " << strerror(errno) << Qt::endl;
+        masterFd = slaveFd = -1;
+        return false;
+    }
+
+    //pass bytes through unchanged, like a serial port
+    struct termios settings;
+    if (::tcgetattr(slaveFd, &settings) == 0)
+    {
+        ::cfmakeraw(&settings);
+        ::tcsetattr(slaveFd, TCSANOW, &settings);
+    }
+
+    ::fcntl(masterFd, F_SETFL, ::fcntl(masterFd, F_GETFL) | O_NONBLOCK);
+
+    char name[128];
+    if (::ttyname_r(slaveFd, name, sizeof(name)) == 0)
+    {
+        slavePath = QString::fromLocal8Bit(name);
+    }
+
+    QFile::remove(linkPath);
+    if (slavePath.isEmpty() || !QFile::link(slavePath, linkPath))
+    {
+        qDebug() << "Error: PtyTransport::open could not link " << slavePath << " at " << linkPath << Qt::endl;
+        close();
+        return false;
+    }
+
+    readNotifier = new QSocketNotifier(masterFd, QSocketNotifier::Read, this);
+    connect(readNotifier, &QSocketNotifier::activated, this, &QIODevice::readyRead);
+
+    return QIODevice::open(mode | QIODevice::Unbuffered);
+}
+
+/**
+ * @brief Closes the pty and removes its link
+ */
+void PtyTransport::close()
+{
+    delete readNotifier;
+    readNotifier = nullptr;
+
+    //leave a link replaced by a newer pty alone
+    if (!slavePath.isEmpty() && QFile::symLinkTarget(linkPath) == slavePath)
+    {
+        QFile::remove(linkPath);
+    }
+    slavePath.clear();
+
+    if (masterFd != -1)
+    {
+        ::close(masterFd);
+        masterFd = -1;
+    }
+
+    if (slaveFd != -1)
+    {
+        ::close(slaveFd);
+        slaveFd = -1;
+    }
+
+    QIODevice::close();
+}
+
+qint64 PtyTransport::bytesAvailable() const
+{
+    int pending = 0;
+
+    if (masterFd != -1)
+    {
+        ::ioctl(masterFd, FIONREAD, &pending);
+    }
+
+    return pending + QIODevice::bytesAvailable();
+}
+
+/**
+ * @brief Waits for bytes from the slave end
+ *
+ * @param msecs Most time to wait, -1 waits until bytes arrive
+ * @return True if bytes are waiting to be read
+ */
+bool PtyTransport::waitForReadyRead(int msecs)
+{
+    if (masterFd == -1)
+    {
+        return false;
+    }
+
+    struct pollfd descriptor = {masterFd, POLLIN, 0};
+    return ::poll(&descriptor, 1, msecs) > 0 && (descriptor.revents & POLLIN);
+}
+
+qint64 PtyTransport::readData(char *data, qint64 maxSize)
+{
+    ssize_t bytesRead = ::read(masterFd, data, maxSize);
+
+    //nothing to read is not an error on a non blocking pty
+    if (bytesRead == -1)
+    {
+        return (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) ? 0 : -1;
+    }
+
+    return bytesRead;
+}
+
+qint64 PtyTransport::writeData(const char *data, qint64 maxSize)
+{
+    qint64 written = 0;
+
+    while (written < maxSize)
+    {
+        ssize_t result = ::write(masterFd, data + written, maxSize - written);
+
+        if (result > 0)
+        {
+            written += result;
+            continue;
+        }
+
+        if (result == -1 && errno == EINTR)
+        {
+            continue;
+        }
+
+        //wait for the other side to read when the pty buffer is full
+        struct pollfd descriptor = {masterFd, POLLOUT, 0};
+        if (result == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)
+            && ::poll(&descriptor, 1, TRANSPORT_WRITE_TIMEOUT) > 0)
+        {
+            continue;
+        }
+
+        break;
+    }
+
+    if (written == 0 && maxSize > 0)
+    {
+        return -1;
+    }
+
+    emit bytesWritten(written);
+    return written;
+}
+#endif // Q_OS_UNIX
@@ -0,0 +1,111 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <QHash>
+#include <QIODevice>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QSocketNotifier>
+#include <QWaitCondition>
+#include "constants.h"
+
+/********************************************************************************
+** transport.h
+**
+** Loopback transports a Connection can use in place of a serial port, so the DDM
+** and the controller simulator can talk on machines without a null modem cable.
+**
+** PipeTransport connects two Connections in the same process. Both sides open the
+** same name (TRANSPORT_PIPE_PREFIX followed by any name) and are paired in the order
+** they open. When one end closes, the next Connection to open the name takes its place.
+**
+** PtyTransport opens a pseudo terminal pair and links its slave end at the path
+** following TRANSPORT_PTY_PREFIX. The other side opens the link as a regular serial
+** port, so it can run in another process. Only available on unix.
+**
+** @author Team Controller
+********************************************************************************/
+
+class PipeTransport : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    // constructor, pairs with the other pipe of the same name once opened
+    PipeTransport(const QString &pipeName, QObject *parent = nullptr);
+
+    // destructor, closes the pipe
+    ~PipeTransport();
+
+    // QIODevice interface
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+    bool waitForReadyRead(int msecs) override;
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    // bytes in flight between the two ends, shared by both ends of a pipe
+    struct Pipe
+    {
+        QMutex mutex;
+        QWaitCondition dataReady;
+        QByteArray buffers[2]; // bytes waiting to be read by each end
+        PipeTransport *ends[2] = {nullptr, nullptr}; // ends that are open
+        bool closed[2] = {false, false}; // bytes written to a closed end are dropped
+    };
+
+    QString pipeName;
+    QSharedPointer<Pipe> pipe;
+    int end; // index of this end in the pipe
+
+    // pipes opened by one end, waiting for the other end to open the same name
+    static QMutex waitingPipesMutex;
+    static QHash<QString, QSharedPointer<Pipe>> waitingPipes;
+};
+
+#ifdef Q_OS_UNIX
+class PtyTransport : public QIODevice
+{
+    Q_OBJECT
+
+public:
+    // constructor, links the slave end at linkPath once opened
+    PtyTransport(const QString &linkPath, QObject *parent = nullptr);
+
+    // destructor, closes the pty and removes the link
+    ~PtyTransport();
+
+    // QIODevice interface
+    bool open(OpenMode mode) override;
+    void close() override;
+    bool isSequential() const override { return true; }
+    qint64 bytesAvailable() const override;
+    bool waitForReadyRead(int msecs) override;
+
+    // device name of the slave end (i.e. /dev/pts/3)
+    QString slaveName() const { return slavePath; }
+
+protected:
+    qint64 readData(char *data, qint64 maxSize) override;
+    qint64 writeData(const char *data, qint64 maxSize) override;
+
+private:
+    QString linkPath;
+    QString slavePath;
+
+    int masterFd;
+
+    // the slave end is kept open so reads of the master do not fail while no one
+    // has the link open
+    int slaveFd;
+
+    QSocketNotifier *readNotifier;
+};
+#endif // Q_OS_UNIX
+
+#endif // TRANSPORT_H